@@ -0,0 +1,13 @@
+onmessage = function(event)
+{
+    var proxy = event.data.proxy;
+    var context = proxy.getContext("2d");
+    if (!context) {
+        postMessage("FAIL: the transferred proxy has no context");
+        return;
+    }
+    context.fillStyle = "rgb(0, 128, 0)";
+    context.fillRect(0, 0, proxy.width, proxy.height);
+    context.commit();
+    postMessage("committed");
+};
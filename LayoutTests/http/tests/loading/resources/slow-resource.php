@@ -0,0 +1,18 @@
+<?php
+// Answers after |delay| milliseconds with a style sheet, a one pixel image or
+// plain text, depending on |type|.
+usleep(intval($_GET['delay']) * 1000);
+
+header('Cache-Control: no-store');
+$type = isset($_GET['type']) ? $_GET['type'] : 'text';
+if ($type == 'css') {
+    header('Content-Type: text/css');
+    echo 'p { color: green; }';
+} else if ($type == 'image') {
+    header('Content-Type: image/gif');
+    echo base64_decode('R0lGODlhAQABAIAAAAAAAP///yH5BAEAAAAALAAAAAABAAEAAAIBRAA7');
+} else {
+    header('Content-Type: text/plain');
+    echo 'done';
+}
+?>
@@ -971,6 +971,16 @@
 #define WTF_USE_TEXTURE_MAPPER 1
 #endif
 
+/* Decode large images on background threads */
+#if PLATFORM(QT)
+#define WTF_USE_ASYNC_IMAGE_DECODING 1
+#endif
+
+/* Decode oversized images at the size they are painted at */
+#if PLATFORM(QT)
+#define WTF_USE_SCALED_IMAGE_DECODING 1
+#endif
+
 #if USE(TEXTURE_MAPPER) && USE(3D_GRAPHICS) && !defined(WTF_USE_TEXTURE_MAPPER_GL)
 #define WTF_USE_TEXTURE_MAPPER_GL 1
 #endif
@@ -314,6 +314,7 @@ IDL_BINDINGS += \
     $$PWD/html/canvas/Int32Array.idl \
     $$PWD/html/canvas/CanvasPattern.idl \
     $$PWD/html/canvas/CanvasProxy.idl \
+    $$PWD/html/canvas/CanvasProxyRenderingContext2D.idl \
     $$PWD/html/canvas/CanvasRenderingContext.idl \
     $$PWD/html/canvas/CanvasRenderingContext2D.idl \
     $$PWD/html/canvas/DOMPath.idl \
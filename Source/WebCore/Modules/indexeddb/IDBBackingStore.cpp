@@ -41,6 +41,7 @@
 #include "LevelDBIterator.h"
 #include "LevelDBSlice.h"
 #include "LevelDBTransaction.h"
+#include "LevelDBWriteBatch.h"
 #include "SecurityOrigin.h"
 #include "SharedBuffer.h"
 #include <wtf/Assertions.h>
@@ -1960,6 +1961,14 @@ PassRefPtr<IDBBackingStore::Cursor> IDBBackingStore::openIndexCursor(IDBBackingS
     return cursor.release();
 }
 
+bool IDBBackingStore::writeChanges(LevelDBWriteBatch& changes)
+{
+    if (m_db->write(changes))
+        return true;
+    INTERNAL_WRITE_ERROR(TransactionCommit);
+    return false;
+}
+
 IDBBackingStore::Transaction::Transaction(IDBBackingStore* backingStore)
     : m_backingStore(backingStore)
 {
@@ -1976,11 +1985,17 @@ bool IDBBackingStore::Transaction::commit()
 {
     IDB_TRACE("IDBBackingStore::Transaction::commit");
     ASSERT(m_transaction);
-    bool result = m_transaction->commit();
+    OwnPtr<LevelDBWriteBatch> changes = takeChanges();
+    return !changes || m_backingStore->writeChanges(*changes);
+}
+
+PassOwnPtr<LevelDBWriteBatch> IDBBackingStore::Transaction::takeChanges()
+{
+    IDB_TRACE("IDBBackingStore::Transaction::takeChanges");
+    ASSERT(m_transaction);
+    OwnPtr<LevelDBWriteBatch> changes = m_transaction->takeWriteBatch();
     m_transaction.clear();
-    if (!result)
-        INTERNAL_WRITE_ERROR(TransactionCommit);
-    return result;
+    return changes.release();
 }
 
 void IDBBackingStore::Transaction::rollback()
@@ -42,6 +42,7 @@ class LevelDBComparator;
 class LevelDBDatabase;
 class LevelDBIterator;
 class LevelDBTransaction;
+class LevelDBWriteBatch;
 class IDBKey;
 class IDBKeyRange;
 class SecurityOrigin;
@@ -160,6 +161,10 @@ public:
     virtual PassRefPtr<Cursor> openIndexKeyCursor(IDBBackingStore::Transaction*, int64_t databaseId, int64_t objectStoreId, int64_t indexId, const IDBKeyRange*, IndexedDB::CursorDirection);
     virtual PassRefPtr<Cursor> openIndexCursor(IDBBackingStore::Transaction*, int64_t databaseId, int64_t objectStoreId, int64_t indexId, const IDBKeyRange*, IndexedDB::CursorDirection);
 
+    // Writes the changes of a transaction taken with Transaction::takeChanges().
+    // May be called on any thread, as long as the backing store stays alive.
+    bool writeChanges(LevelDBWriteBatch&);
+
     class Transaction {
     public:
         explicit Transaction(IDBBackingStore*);
@@ -168,6 +173,10 @@ public:
         void rollback();
         void reset() { m_backingStore = 0; m_transaction = 0; }
 
+        // Finishes the transaction without writing it; its changes are to be
+        // passed to writeChanges(). Returns 0 if nothing was changed.
+        PassOwnPtr<LevelDBWriteBatch> takeChanges();
+
         static LevelDBTransaction* levelDBTransactionFrom(Transaction* transaction)
         {
             return static_cast<Transaction*>(transaction)->m_transaction.get();
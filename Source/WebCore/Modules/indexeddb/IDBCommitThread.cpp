@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "IDBCommitThread.h"
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include "IDBBackingStore.h"
+#include "IDBTransactionBackendImpl.h"
+#include "LevelDBWriteBatch.h"
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+IDBCommitThread& IDBCommitThread::shared()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(IDBCommitThread, commitThread, ());
+    return commitThread;
+}
+
+IDBCommitThread::IDBCommitThread()
+    : m_thread(0)
+{
+}
+
+IDBCommitThread::~IDBCommitThread()
+{
+    // The commit thread is never destroyed; it lives as long as the process.
+    ASSERT_NOT_REACHED();
+}
+
+void IDBCommitThread::schedule(PassRefPtr<IDBTransactionBackendImpl> transaction, PassRefPtr<IDBBackingStore> backingStore, PassOwnPtr<LevelDBWriteBatch> changes)
+{
+    ASSERT(isMainThread());
+
+    if (!m_thread)
+        m_thread = createThread(IDBCommitThread::threadEntryPointCallback, this, "WebCore: IndexedDB");
+
+    OwnPtr<Commit> commit = adoptPtr(new Commit);
+    commit->transaction = transaction;
+    commit->backingStore = backingStore;
+    commit->changes = changes;
+    commit->succeeded = false;
+
+    // If the thread could not be created, the changes are written on the main
+    // thread instead. The transaction still hears back asynchronously.
+    if (!m_thread) {
+        commit->succeeded = commit->backingStore->writeChanges(*commit->changes);
+        callOnMainThread(didWriteChanges, commit.leakPtr());
+        return;
+    }
+
+    MutexLocker locker(m_mutex);
+    m_queue.append(commit.release());
+    m_commitAvailable.signal();
+}
+
+void IDBCommitThread::threadEntryPointCallback(void* commitThread)
+{
+    static_cast<IDBCommitThread*>(commitThread)->threadEntryPoint();
+}
+
+void IDBCommitThread::threadEntryPoint()
+{
+    ASSERT(!isMainThread());
+
+    while (true) {
+        OwnPtr<Commit> commit;
+        {
+            MutexLocker locker(m_mutex);
+            while (m_queue.isEmpty())
+                m_commitAvailable.wait(m_mutex);
+            commit = m_queue.takeFirst();
+        }
+
+        commit->succeeded = commit->backingStore->writeChanges(*commit->changes);
+        commit->changes.clear();
+
+        // The commit is adopted again in didWriteChanges(), so that the
+        // references it holds are released on the main thread.
+        callOnMainThread(didWriteChanges, commit.leakPtr());
+    }
+}
+
+void IDBCommitThread::didWriteChanges(void* context)
+{
+    OwnPtr<Commit> commit = adoptPtr(static_cast<Commit*>(context));
+    commit->transaction->didWriteChanges(commit->succeeded);
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IDBCommitThread_h
+#define IDBCommitThread_h
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include <wtf/Deque.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Threading.h>
+
+namespace WebCore {
+
+class IDBBackingStore;
+class IDBTransactionBackendImpl;
+class LevelDBWriteBatch;
+
+// Writes the changes of committed transactions on a thread of its own. Every
+// LevelDB write is synced to disk, which for a transaction that put many
+// records is most of the time spent committing it; the main thread gets to
+// paint and run script in the meantime.
+//
+// Changes are written in the order they were scheduled, and each transaction
+// hears back on the main thread once its changes are on disk. Until then it
+// stays started in its database's transaction coordinator, which holds back
+// readonly and readwrite transactions whose scope overlaps it.
+class IDBCommitThread {
+    WTF_MAKE_NONCOPYABLE(IDBCommitThread); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static IDBCommitThread& shared();
+
+    void schedule(PassRefPtr<IDBTransactionBackendImpl>, PassRefPtr<IDBBackingStore>, PassOwnPtr<LevelDBWriteBatch> changes);
+
+private:
+    IDBCommitThread();
+    ~IDBCommitThread();
+
+    // The transaction and the backing store are only referenced and released
+    // on the main thread.
+    struct Commit {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        RefPtr<IDBTransactionBackendImpl> transaction;
+        RefPtr<IDBBackingStore> backingStore;
+        OwnPtr<LevelDBWriteBatch> changes;
+        bool succeeded;
+    };
+
+    static void threadEntryPointCallback(void*);
+    void threadEntryPoint();
+
+    static void didWriteChanges(void*);
+
+    ThreadIdentifier m_thread;
+
+    Mutex m_mutex; // Guards the members below.
+    ThreadCondition m_commitAvailable;
+    Deque<OwnPtr<Commit> > m_queue;
+};
+
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
+
+#endif // IDBCommitThread_h
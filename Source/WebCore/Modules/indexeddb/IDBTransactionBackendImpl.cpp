@@ -29,15 +29,23 @@
 #if ENABLE(INDEXED_DATABASE)
 
 #include "IDBBackingStore.h"
+#include "IDBCommitThread.h"
 #include "IDBCursorBackendImpl.h"
 #include "IDBDatabaseBackendImpl.h"
 #include "IDBDatabaseCallbacks.h"
 #include "IDBDatabaseException.h"
 #include "IDBTracing.h"
 #include "IDBTransactionCoordinator.h"
+#include "LevelDBWriteBatch.h"
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
 
 namespace WebCore {
 
+// Tasks are run in slices of at most this long, so that a transaction with many
+// requests does not keep the thread from painting until all of them are done.
+static const double maximumTaskSliceDuration = 0.01;
+
 PassRefPtr<IDBTransactionBackendImpl> IDBTransactionBackendImpl::create(int64_t id, PassRefPtr<IDBDatabaseCallbacks> callbacks, const Vector<int64_t>& objectStoreIds, IndexedDB::TransactionMode mode, IDBDatabaseBackendImpl* database)
 {
     HashSet<int64_t> objectStoreHashSet;
@@ -217,8 +225,30 @@ void IDBTransactionBackendImpl::commit()
     bool unused = m_state == Unused;
     m_state = Finished;
 
-    bool committed = unused || m_transaction.commit();
+    bool committed = true;
+    if (!unused) {
+        // On the main thread, the changes are written by the commit thread and
+        // the transaction finishes once they are. Workers don't paint, and
+        // write them right away.
+        OwnPtr<LevelDBWriteBatch> changes = m_transaction.takeChanges();
+        if (changes && isMainThread()) {
+            IDBCommitThread::shared().schedule(this, m_database->backingStore(), changes.release());
+            return;
+        }
+        committed = !changes || m_database->backingStore()->writeChanges(*changes);
+    }
+
+    didCommit(committed, unused);
+}
+
+void IDBTransactionBackendImpl::didWriteChanges(bool succeeded)
+{
+    ASSERT(m_state == Finished);
+    didCommit(succeeded, false);
+}
 
+void IDBTransactionBackendImpl::didCommit(bool committed, bool unused)
+{
     // Backing store resources (held via cursors) must be released before script callbacks
     // are fired, as the script callbacks may release references and allow the backing store
     // itself to be released, and order is critical.
@@ -257,9 +287,15 @@ void IDBTransactionBackendImpl::taskTimerFired(Timer<IDBTransactionBackendImpl>*
     // the loop termination conditions can be checked.
     RefPtr<IDBTransactionBackendImpl> protect(this);
 
+    double sliceEndTime = monotonicallyIncreasingTime() + maximumTaskSliceDuration;
     TaskQueue* taskQueue = m_pendingPreemptiveEvents ? &m_preemptiveTaskQueue : &m_taskQueue;
     while (!taskQueue->isEmpty() && m_state != Finished) {
         ASSERT(m_state == Running);
+        if (monotonicallyIncreasingTime() >= sliceEndTime) {
+            m_taskTimer.startOneShot(0);
+            return;
+        }
+
         OwnPtr<Operation> task(taskQueue->takeFirst());
         task->perform(this);
 
@@ -50,6 +50,9 @@ public:
     virtual void abort();
     void commit();
 
+    // Called by the commit thread once the changes of the transaction are on disk.
+    void didWriteChanges(bool succeeded);
+
     class Operation {
     public:
         virtual ~Operation() { }
@@ -86,6 +89,8 @@ private:
     bool isTaskQueueEmpty() const;
     bool hasPendingTasks() const;
 
+    void didCommit(bool committed, bool unused);
+
     void taskTimerFired(Timer<IDBTransactionBackendImpl>*);
     void asyncDerefTimerFired(Timer<IDBTransactionBackendImpl>*);
     void closeOpenCursors();
@@ -129,9 +129,10 @@ bool IDBTransactionCoordinator::canRunTransaction(IDBTransactionBackendImpl* tra
         return true;
 
     case IndexedDB::TransactionReadOnly:
-        return true;
-
     case IndexedDB::TransactionReadWrite:
+        // A readwrite transaction stays started until its changes are on
+        // disk, so waiting for it here also keeps a readonly transaction from
+        // reading data that is still being written by the commit thread.
         for (HashSet<IDBTransactionBackendImpl*>::const_iterator it = m_startedTransactions.begin(); it != m_startedTransactions.end(); ++it) {
             if ((*it)->mode() == IndexedDB::TransactionReadWrite && doScopesOverlap(transaction->scope(), (*it)->scope()))
                 return false;
@@ -970,6 +970,7 @@ SOURCES += \
     platform/text/LocaleToScriptMappingDefault.cpp \
     platform/text/PlatformLocale.cpp \
     platform/text/QuotedPrintable.cpp \
+    platform/BackgroundThreadPool.cpp \
     platform/CalculationValue.cpp \
     platform/Clock.cpp \
     platform/ClockGeneric.cpp \
@@ -991,6 +992,8 @@ SOURCES += \
     platform/graphics/BitmapImage.cpp \
     platform/graphics/Color.cpp \
     platform/graphics/CrossfadeGeneratedImage.cpp \
+    platform/graphics/DisplayList.cpp \
+    platform/graphics/DisplayListCache.cpp \
     platform/graphics/FloatPoint3D.cpp \
     platform/graphics/FloatPoint.cpp \
     platform/graphics/FloatPolygon.cpp \
@@ -1015,12 +1018,14 @@ SOURCES += \
     platform/graphics/GraphicsTypes.cpp \
     platform/graphics/Image.cpp \
     platform/graphics/ImageBuffer.cpp \
+    platform/graphics/ImageDecodingThreadPool.cpp \
     platform/graphics/ImageOrientation.cpp \
     platform/graphics/ImageSource.cpp \
     platform/graphics/IntRect.cpp \
     platform/graphics/Path.cpp \
     platform/graphics/PathTraversalState.cpp \
     platform/graphics/Pattern.cpp \
+    platform/graphics/PixelConversions.cpp \
     platform/graphics/qt/FontQt.cpp \
     platform/graphics/Region.cpp \
     platform/graphics/RoundedRect.cpp \
@@ -1074,6 +1079,7 @@ SOURCES += \
     platform/network/BlobRegistry.cpp \
     platform/network/BlobRegistryImpl.cpp \
     platform/network/BlobResourceHandle.cpp \
+    platform/network/CacheValidation.cpp \
     platform/network/Credential.cpp \
     platform/network/CredentialStorage.cpp \
     platform/network/FormData.cpp \
@@ -1237,6 +1243,7 @@ SOURCES += \
     rendering/RenderWordBreak.cpp \
     rendering/RootInlineBox.cpp \
     rendering/ScrollBehavior.cpp \
+    rendering/SimpleLineLayout.cpp \
     rendering/shapes/PolygonShape.cpp \
     rendering/shapes/RectangleShape.cpp \
     rendering/shapes/Shape.cpp \
@@ -2119,6 +2126,7 @@ HEADERS += \
     platform/animation/AnimationList.h \
     platform/animation/AnimationUtilities.h \
     platform/Arena.h \
+    platform/BackgroundThreadPool.h \
     platform/CalculationValue.h \
     platform/Clock.h \
     platform/ClockGeneric.h \
@@ -2149,7 +2157,16 @@ HEADERS += \
     platform/graphics/cpu/arm/filters/FECompositeArithmeticNEON.h \
     platform/graphics/cpu/arm/filters/FEGaussianBlurNEON.h \
     platform/graphics/cpu/arm/filters/FELightingNEON.h \
+    platform/graphics/cpu/arm/PixelConversionsNEON.h \
+    platform/graphics/cpu/x86/filters/FEColorMatrixSSE2.h \
+    platform/graphics/cpu/x86/filters/FECompositeArithmeticSSE2.h \
+    platform/graphics/cpu/x86/filters/FEGaussianBlurSSE2.h \
+    platform/graphics/cpu/x86/filters/FEMorphologySSE2.h \
+    platform/graphics/cpu/x86/filters/SSE2Helpers.h \
+    platform/graphics/cpu/x86/PixelConversionsSSE2.h \
     platform/graphics/CrossfadeGeneratedImage.h \
+    platform/graphics/DisplayList.h \
+    platform/graphics/DisplayListCache.h \
     platform/graphics/filters/texmap/TextureMapperPlatformCompiledProgram.h \
     platform/graphics/filters/CustomFilterArrayParameter.h \
     platform/graphics/filters/CustomFilterColorParameter.h \
@@ -2189,6 +2206,7 @@ HEADERS += \
     platform/graphics/filters/FilterEffect.h \
     platform/graphics/filters/FilterOperation.h \
     platform/graphics/filters/FilterOperations.h \
+    platform/graphics/filters/FilterResultCache.h \
     platform/graphics/filters/LightSource.h \
     platform/graphics/filters/SourceAlpha.h \
     platform/graphics/filters/SourceGraphic.h \
@@ -2215,6 +2233,7 @@ HEADERS += \
     platform/graphics/GraphicsTypes.h \
     platform/graphics/GraphicsTypes3D.h \
     platform/graphics/Image.h \
+    platform/graphics/ImageDecodingThreadPool.h \
     platform/graphics/ImageOrientation.h \
     platform/graphics/ImageSource.h \
     platform/graphics/IntPoint.h \
@@ -2225,9 +2244,11 @@ HEADERS += \
     platform/graphics/MediaPlayer.h \
     platform/graphics/NativeImagePtr.h \
     platform/graphics/opentype/OpenTypeVerticalData.h \
+    platform/graphics/PaintCacheBudget.h \
     platform/graphics/Path.h \
     platform/graphics/PathTraversalState.h \
     platform/graphics/Pattern.h \
+    platform/graphics/PixelConversions.h \
     platform/graphics/PlatformLayer.h \
     platform/graphics/PlatformTimeRanges.h \
     platform/graphics/Region.h \
@@ -2311,6 +2332,7 @@ HEADERS += \
     platform/network/BlobRegistryImpl.h \
     platform/network/BlobResourceHandle.h \
     platform/network/BlobStorageData.h \
+    platform/network/CacheValidation.h \
     platform/network/CookieStorage.h \
     platform/network/Credential.h \
     platform/network/CredentialStorage.h \
@@ -2509,6 +2531,7 @@ HEADERS += \
     rendering/RenderWordBreak.h \
     rendering/RootInlineBox.h \
     rendering/ScrollBehavior.h \
+    rendering/SimpleLineLayout.h \
     rendering/shapes/PolygonShape.h \
     rendering/shapes/RectangleShape.h \
     rendering/shapes/Shape.h \
@@ -2584,6 +2607,7 @@ HEADERS += \
     rendering/svg/RenderSVGTextPath.h \
     rendering/svg/RenderSVGTransformableContainer.h \
     rendering/svg/RenderSVGViewportContainer.h \
+    rendering/svg/SVGContainerBitmapCache.h \
     rendering/svg/SVGInlineFlowBox.h \
     rendering/svg/SVGInlineTextBox.h \
     rendering/svg/SVGMarkerData.h \
@@ -2879,6 +2903,7 @@ SOURCES += \
     page/qt/EventHandlerQt.cpp \
     platform/graphics/qt/TransformationMatrixQt.cpp \
     platform/graphics/qt/ColorQt.cpp \
+    platform/graphics/qt/DisplayListQt.cpp \
     platform/graphics/qt/FontPlatformDataQt.cpp \
     platform/graphics/qt/FloatPointQt.cpp \
     platform/graphics/qt/FloatRectQt.cpp \
@@ -3083,6 +3108,7 @@ enable?(INDEXED_DATABASE) {
         Modules/indexeddb/IDBAny.h \
         Modules/indexeddb/IDBBackingStore.h \
         Modules/indexeddb/IDBCallbacks.h \
+        Modules/indexeddb/IDBCommitThread.h \
         Modules/indexeddb/IDBCursor.h \
         Modules/indexeddb/IDBCursorBackendImpl.h \
         Modules/indexeddb/IDBCursorBackendInterface.h \
@@ -3124,6 +3150,7 @@ enable?(INDEXED_DATABASE) {
         Modules/indexeddb/DOMWindowIndexedDatabase.cpp \
         Modules/indexeddb/IDBAny.cpp \
         Modules/indexeddb/IDBBackingStore.cpp \
+        Modules/indexeddb/IDBCommitThread.cpp \
         Modules/indexeddb/IDBCursor.cpp \
         Modules/indexeddb/IDBCursorBackendImpl.cpp \
         Modules/indexeddb/IDBCursorWithValue.cpp \
@@ -3706,6 +3733,7 @@ enable?(FILTERS) {
         platform/graphics/filters/FilterOperations.cpp \
         platform/graphics/filters/FilterOperation.cpp \
         platform/graphics/filters/FilterEffect.cpp \
+        platform/graphics/filters/FilterResultCache.cpp \
         platform/graphics/filters/PointLightSource.cpp \
         platform/graphics/filters/SpotLightSource.cpp \
         platform/graphics/filters/SourceAlpha.cpp \
@@ -3796,6 +3824,7 @@ enable?(SVG) {
         rendering/svg/RenderSVGTextPath.cpp \
         rendering/svg/RenderSVGTransformableContainer.cpp \
         rendering/svg/RenderSVGViewportContainer.cpp \
+        rendering/svg/SVGContainerBitmapCache.cpp \
         rendering/svg/SVGInlineFlowBox.cpp \
         rendering/svg/SVGInlineTextBox.cpp \
         rendering/svg/SVGPathData.cpp \
@@ -4222,10 +4251,12 @@ enable?(WEBGL) {
 
 enable?(CANVAS_PROXY) {
     HEADERS += \
-        html/canvas/CanvasProxy.h
+        html/canvas/CanvasProxy.h \
+        html/canvas/CanvasProxyRenderingContext2D.h
 
     SOURCES += \
-        html/canvas/CanvasProxy.cpp
+        html/canvas/CanvasProxy.cpp \
+        html/canvas/CanvasProxyRenderingContext2D.cpp
 }
 
 use?(3D_GRAPHICS) {
@@ -4260,6 +4291,7 @@ use?(3D_GRAPHICS) {
         platform/graphics/texmap/coordinated/CoordinatedSurface.h \
         platform/graphics/texmap/coordinated/CoordinatedTile.h \
         platform/graphics/texmap/coordinated/SurfaceUpdateInfo.h \
+        platform/graphics/texmap/coordinated/TileRasterizer.h \
         platform/graphics/texmap/coordinated/UpdateAtlas.h
 
     SOURCES += \
@@ -4292,6 +4324,7 @@ use?(3D_GRAPHICS) {
         platform/graphics/texmap/coordinated/CoordinatedImageBacking.cpp \
         platform/graphics/texmap/coordinated/CoordinatedSurface.cpp \
         platform/graphics/texmap/coordinated/CoordinatedTile.cpp \
+        platform/graphics/texmap/coordinated/TileRasterizer.cpp \
         platform/graphics/texmap/coordinated/UpdateAtlas.cpp
 
     INCLUDEPATH += $$PWD/platform/graphics/gpu
@@ -4441,6 +4474,7 @@ use?(SOUP) {
         platform/network/qt/QNetworkReplyHandler.h \
         platform/network/qt/NetworkStateNotifierPrivate.h \
         platform/network/qt/CookieJarQt.h \
+        platform/network/qt/NetworkDiskCacheQt.h \
         platform/network/qt/SocketStreamHandlePrivate.h
 
     SOURCES += \
@@ -4450,6 +4484,7 @@ use?(SOUP) {
         platform/network/qt/ResourceHandleQt.cpp \
         platform/network/qt/ResourceRequestQt.cpp \
         platform/network/qt/DNSQt.cpp \
+        platform/network/qt/NetworkDiskCacheQt.cpp \
         platform/network/qt/NetworkStateNotifierQt.cpp \
         platform/network/qt/ProxyServerQt.cpp \
         platform/network/qt/QtMIMETypeSniffer.cpp \
@@ -1171,6 +1171,8 @@ bool AccessibilityRenderObject::computeAccessibilityIsIgnored() const
         if (parent && (parent->ariaRoleAttribute() == MenuItemRole || parent->ariaRoleAttribute() == MenuButtonRole))
             return true;
         RenderText* renderText = toRenderText(m_renderer);
+        // Text laid out before accessibility was enabled may still be on the simple line layout path.
+        renderText->ensureLineBoxes();
         if (m_renderer->isBR() || !renderText->firstTextBox())
             return true;
 
@@ -1235,7 +1237,7 @@ bool AccessibilityRenderObject::computeAccessibilityIsIgnored() const
         return true;
     
     if (m_renderer->isBlockFlow() && m_renderer->childrenInline() && !canSetFocusAttribute())
-        return !toRenderBlock(m_renderer)->firstLineBox() && !mouseButtonListener();
+        return !toRenderBlock(m_renderer)->firstLineBox() && !toRenderBlock(m_renderer)->hasSimpleLineLayout() && !mouseButtonListener();
     
     // ignore images seemingly used as spacers
     if (isImage()) {
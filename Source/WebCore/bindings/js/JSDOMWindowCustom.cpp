@@ -615,6 +615,9 @@ static JSValue handlePostMessage(DOMWindow* impl, ExecState* exec)
 {
     MessagePortArray messagePorts;
     ArrayBufferArray arrayBuffers;
+#if ENABLE(CANVAS_PROXY)
+    CanvasProxyArray canvasProxies;
+#endif
 
     // This function has variable arguments and can be:
     // Per current spec:
@@ -629,14 +632,22 @@ static JSValue handlePostMessage(DOMWindow* impl, ExecState* exec)
             targetOriginArgIndex = 2;
             transferablesArgIndex = 1;
         }
+#if ENABLE(CANVAS_PROXY)
+        fillMessagePortArray(exec, exec->argument(transferablesArgIndex), messagePorts, arrayBuffers, &canvasProxies);
+#else
         fillMessagePortArray(exec, exec->argument(transferablesArgIndex), messagePorts, arrayBuffers);
+#endif
     }
     if (exec->hadException())
         return jsUndefined();
 
     RefPtr<SerializedScriptValue> message = SerializedScriptValue::create(exec, exec->argument(0),
                                                                          &messagePorts,
-                                                                         &arrayBuffers);
+                                                                         &arrayBuffers,
+#if ENABLE(CANVAS_PROXY)
+                                                                         &canvasProxies,
+#endif
+                                                                         Throwing);
 
     if (exec->hadException())
         return jsUndefined();
@@ -31,6 +31,7 @@
 #include "ExceptionCode.h"
 #include "Frame.h"
 #include "JSArrayBuffer.h"
+#include "JSCanvasProxy.h"
 #include "JSDOMGlobalObject.h"
 #include "JSEvent.h"
 #include "JSEventListener.h"
@@ -63,13 +64,21 @@ JSC::JSValue JSMessagePort::postMessage(JSC::ExecState* exec)
     return handlePostMessage(exec, impl());
 }
 
+#if ENABLE(CANVAS_PROXY)
+void fillMessagePortArray(JSC::ExecState* exec, JSC::JSValue value, MessagePortArray& portArray, ArrayBufferArray& arrayBuffers, CanvasProxyArray* canvasProxies)
+#else
 void fillMessagePortArray(JSC::ExecState* exec, JSC::JSValue value, MessagePortArray& portArray, ArrayBufferArray& arrayBuffers)
+#endif
 {
     // Convert from the passed-in JS array-like object to a MessagePortArray.
     // Also validates the elements per sections 4.1.13 and 4.1.15 of the WebIDL spec and section 8.3.3 of the HTML5 spec.
     if (value.isUndefinedOrNull()) {
         portArray.resize(0);
         arrayBuffers.resize(0);
+#if ENABLE(CANVAS_PROXY)
+        if (canvasProxies)
+            canvasProxies->resize(0);
+#endif
         return;
     }
 
@@ -99,6 +108,18 @@ void fillMessagePortArray(JSC::ExecState* exec, JSC::JSValue value, MessagePortA
             }
             portArray.append(port.release());
         } else {
+#if ENABLE(CANVAS_PROXY)
+            if (canvasProxies && value.inherits(&JSCanvasProxy::s_info)) {
+                RefPtr<CanvasProxy> canvasProxy = toCanvasProxy(value);
+                // Check for duplicate proxies.
+                if (canvasProxies->contains(canvasProxy)) {
+                    setDOMException(exec, INVALID_STATE_ERR);
+                    return;
+                }
+                canvasProxies->append(canvasProxy.release());
+                continue;
+            }
+#endif
             RefPtr<ArrayBuffer> arrayBuffer = toArrayBuffer(value);
             if (arrayBuffer)
                 arrayBuffers.append(arrayBuffer);
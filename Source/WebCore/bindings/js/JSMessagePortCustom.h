@@ -43,7 +43,12 @@ namespace WebCore {
     // Helper function which pulls the values out of a JS sequence and into a MessagePortArray.
     // Also validates the elements per sections 4.1.13 and 4.1.15 of the WebIDL spec and section 8.3.3 of the HTML5 spec.
     // May generate an exception via the passed ExecState.
+#if ENABLE(CANVAS_PROXY)
+    // Canvas proxies are only accepted where the caller collects them.
+    void fillMessagePortArray(JSC::ExecState*, JSC::JSValue, MessagePortArray&, ArrayBufferArray&, CanvasProxyArray* = 0);
+#else
     void fillMessagePortArray(JSC::ExecState*, JSC::JSValue, MessagePortArray&, ArrayBufferArray&);
+#endif
 
     // Helper function to convert from JS postMessage arguments to WebCore postMessage arguments.
     template <typename T>
@@ -51,8 +56,17 @@ namespace WebCore {
     {
         MessagePortArray portArray;
         ArrayBufferArray arrayBufferArray;
+#if ENABLE(CANVAS_PROXY)
+        CanvasProxyArray canvasProxyArray;
+        fillMessagePortArray(exec, exec->argument(1), portArray, arrayBufferArray, &canvasProxyArray);
+        // Don't transfer anything out of a list that turned out to be invalid.
+        if (exec->hadException())
+            return JSC::jsUndefined();
+        RefPtr<SerializedScriptValue> message = SerializedScriptValue::create(exec, exec->argument(0), &portArray, &arrayBufferArray, &canvasProxyArray);
+#else
         fillMessagePortArray(exec, exec->argument(1), portArray, arrayBufferArray);
         RefPtr<SerializedScriptValue> message = SerializedScriptValue::create(exec, exec->argument(0), &portArray, &arrayBufferArray);
+#endif
         if (exec->hadException())
             return JSC::jsUndefined();
 
@@ -28,6 +28,7 @@
 #include "SerializedScriptValue.h"
 
 #include "Blob.h"
+#include "CanvasProxy.h"
 #include "ExceptionCode.h"
 #include "File.h"
 #include "FileList.h"
@@ -35,6 +36,7 @@
 #include "JSArrayBuffer.h"
 #include "JSArrayBufferView.h"
 #include "JSBlob.h"
+#include "JSCanvasProxy.h"
 #include "JSDataView.h"
 #include "JSDOMGlobalObject.h"
 #include "JSFile.h"
@@ -118,6 +120,7 @@ enum SerializationTag {
     StringObjectTag = 26,
     EmptyStringObjectTag = 27,
     NumberObjectTag = 28,
+    CanvasProxyTransferTag = 29,
     ErrorTag = 255
 };
 
@@ -213,6 +216,7 @@ static const unsigned NonIndexPropertiesTag = 0xFFFFFFFD;
  *    | ArrayBuffer
  *    | ArrayBufferViewTag ArrayBufferViewSubtag <byteOffset:uint32_t> <byteLenght:uint32_t> (ArrayBuffer | ObjectReference)
  *    | ArrayBufferTransferTag <value:uint32_t>
+ *    | CanvasProxyTransferTag <value:uint32_t>
  *
  * String :-
  *      EmptyStringTag
@@ -326,9 +330,16 @@ class CloneSerializer : CloneBase {
 public:
     static SerializationReturnCode serialize(ExecState* exec, JSValue value,
                                              MessagePortArray* messagePorts, ArrayBufferArray* arrayBuffers,
+#if ENABLE(CANVAS_PROXY)
+                                             CanvasProxyArray* canvasProxies,
+#endif
                                              Vector<String>& blobURLs, Vector<uint8_t>& out)
     {
+#if ENABLE(CANVAS_PROXY)
+        CloneSerializer serializer(exec, messagePorts, arrayBuffers, canvasProxies, blobURLs, out);
+#else
         CloneSerializer serializer(exec, messagePorts, arrayBuffers, blobURLs, out);
+#endif
         return serializer.serialize(value);
     }
 
@@ -371,7 +382,11 @@ public:
 private:
     typedef HashMap<JSObject*, uint32_t> ObjectPool;
 
-    CloneSerializer(ExecState* exec, MessagePortArray* messagePorts, ArrayBufferArray* arrayBuffers, Vector<String>& blobURLs, Vector<uint8_t>& out)
+    CloneSerializer(ExecState* exec, MessagePortArray* messagePorts, ArrayBufferArray* arrayBuffers,
+#if ENABLE(CANVAS_PROXY)
+                    CanvasProxyArray* canvasProxies,
+#endif
+                    Vector<String>& blobURLs, Vector<uint8_t>& out)
         : CloneBase(exec)
         , m_buffer(out)
         , m_blobURLs(blobURLs)
@@ -380,6 +395,9 @@ private:
         write(CurrentVersion);
         fillTransferMap(messagePorts, m_transferredMessagePorts);
         fillTransferMap(arrayBuffers, m_transferredArrayBuffers);
+#if ENABLE(CANVAS_PROXY)
+        fillTransferMap(canvasProxies, m_transferredCanvasProxies);
+#endif
     }
 
     template <class T>
@@ -689,6 +707,19 @@ private:
                 recordObject(obj);
                 return success;
             }
+#if ENABLE(CANVAS_PROXY)
+            if (obj->inherits(&JSCanvasProxy::s_info)) {
+                // Proxies can't be cloned, only transferred.
+                ObjectPool::iterator index = m_transferredCanvasProxies.find(obj);
+                if (index == m_transferredCanvasProxies.end()) {
+                    code = DataCloneError;
+                    return true;
+                }
+                write(CanvasProxyTransferTag);
+                write(index->value);
+                return true;
+            }
+#endif
 
             return false;
         }
@@ -817,6 +848,9 @@ private:
     ObjectPool m_objectPool;
     ObjectPool m_transferredMessagePorts;
     ObjectPool m_transferredArrayBuffers;
+#if ENABLE(CANVAS_PROXY)
+    ObjectPool m_transferredCanvasProxies;
+#endif
     typedef HashMap<RefPtr<StringImpl>, uint32_t, IdentifierRepHash> StringConstantPool;
     StringConstantPool m_constantPool;
     Identifier m_emptyIdentifier;
@@ -1003,6 +1037,9 @@ public:
 
     static DeserializationResult deserialize(ExecState* exec, JSGlobalObject* globalObject,
                                              MessagePortArray* messagePorts, ArrayBufferContentsArray* arrayBufferContentsArray,
+#if ENABLE(CANVAS_PROXY)
+                                             CanvasProxyFrameSinkArray* canvasProxyFrameSinks,
+#endif
                                              const Vector<uint8_t>& buffer)
     {
         if (!buffer.size())
@@ -1010,6 +1047,10 @@ public:
         CloneDeserializer deserializer(exec, globalObject, messagePorts, arrayBufferContentsArray, buffer);
         if (!deserializer.isValid())
             return make_pair(JSValue(), ValidationError);
+#if ENABLE(CANVAS_PROXY)
+        deserializer.m_canvasProxyFrameSinks = canvasProxyFrameSinks;
+        deserializer.m_canvasProxies.resize(canvasProxyFrameSinks ? canvasProxyFrameSinks->size() : 0);
+#endif
         return deserializer.deserialize();
     }
 
@@ -1064,6 +1105,9 @@ private:
         , m_messagePorts(messagePorts)
         , m_arrayBufferContents(arrayBufferContents)
         , m_arrayBuffers(arrayBufferContents ? arrayBufferContents->size() : 0)
+#if ENABLE(CANVAS_PROXY)
+        , m_canvasProxyFrameSinks(0)
+#endif
     {
         if (!read(m_version))
             m_version = 0xFFFFFFFF;
@@ -1549,6 +1593,29 @@ private:
 
             return getJSValue(m_arrayBuffers[index].get());
         }
+#if ENABLE(CANVAS_PROXY)
+        case CanvasProxyTransferTag: {
+            uint32_t index;
+            bool indexSuccessfullyRead = read(index);
+            if (!indexSuccessfullyRead || !m_isDOMGlobalObject || index >= m_canvasProxies.size()) {
+                fail();
+                return JSValue();
+            }
+
+            // The frame sink goes to the first proxy created for it, so
+            // deserializing the value again can't create a second one.
+            if (!m_canvasProxies[index]) {
+                RefPtr<CanvasProxyFrameSink> frameSink = m_canvasProxyFrameSinks->at(index).release();
+                if (!frameSink) {
+                    fail();
+                    return JSValue();
+                }
+                m_canvasProxies[index] = CanvasProxy::create(frameSink.release());
+            }
+
+            return getJSValue(m_canvasProxies[index].get());
+        }
+#endif
         case ArrayBufferViewTag: {
             JSValue arrayBufferView;
             if (!readArrayBufferView(arrayBufferView)) {
@@ -1573,6 +1640,10 @@ private:
     MessagePortArray* m_messagePorts;
     ArrayBufferContentsArray* m_arrayBufferContents;
     ArrayBufferArray m_arrayBuffers;
+#if ENABLE(CANVAS_PROXY)
+    CanvasProxyFrameSinkArray* m_canvasProxyFrameSinks;
+    CanvasProxyArray m_canvasProxies;
+#endif
 };
 
 DeserializationResult CloneDeserializer::deserialize()
@@ -1804,15 +1875,51 @@ PassOwnPtr<SerializedScriptValue::ArrayBufferContentsArray> SerializedScriptValu
 }
 
 
+#if ENABLE(CANVAS_PROXY)
+PassOwnPtr<CanvasProxyFrameSinkArray> SerializedScriptValue::transferCanvasProxies(CanvasProxyArray& canvasProxies, SerializationReturnCode& code)
+{
+    for (size_t i = 0; i < canvasProxies.size(); ++i) {
+        if (!canvasProxies[i]->canTransfer()) {
+            code = DataCloneError;
+            return nullptr;
+        }
+    }
+
+    OwnPtr<CanvasProxyFrameSinkArray> frameSinks = adoptPtr(new CanvasProxyFrameSinkArray(canvasProxies.size()));
+    for (size_t i = 0; i < canvasProxies.size(); ++i)
+        frameSinks->at(i) = canvasProxies[i]->transfer();
+    return frameSinks.release();
+}
+#endif
+
 PassRefPtr<SerializedScriptValue> SerializedScriptValue::create(ExecState* exec, JSValue value,
                                                                 MessagePortArray* messagePorts, ArrayBufferArray* arrayBuffers,
                                                                 SerializationErrorMode throwExceptions)
 {
+#if ENABLE(CANVAS_PROXY)
+    return create(exec, value, messagePorts, arrayBuffers, 0, throwExceptions);
+}
+
+PassRefPtr<SerializedScriptValue> SerializedScriptValue::create(ExecState* exec, JSValue value,
+                                                                MessagePortArray* messagePorts, ArrayBufferArray* arrayBuffers,
+                                                                CanvasProxyArray* canvasProxies, SerializationErrorMode throwExceptions)
+{
+#endif
     Vector<uint8_t> buffer;
     Vector<String> blobURLs;
+#if ENABLE(CANVAS_PROXY)
+    SerializationReturnCode code = CloneSerializer::serialize(exec, value, messagePorts, arrayBuffers, canvasProxies, blobURLs, buffer);
+#else
     SerializationReturnCode code = CloneSerializer::serialize(exec, value, messagePorts, arrayBuffers, blobURLs, buffer);
+#endif
 
     OwnPtr<ArrayBufferContentsArray> arrayBufferContentsArray;
+#if ENABLE(CANVAS_PROXY)
+    OwnPtr<CanvasProxyFrameSinkArray> canvasProxyFrameSinks;
+
+    if (canvasProxies && !canvasProxies->isEmpty() && serializationDidCompleteSuccessfully(code))
+        canvasProxyFrameSinks = transferCanvasProxies(*canvasProxies, code);
+#endif
 
     if (arrayBuffers && serializationDidCompleteSuccessfully(code))
         arrayBufferContentsArray = transferArrayBuffers(exec, *arrayBuffers, code);
@@ -1823,7 +1930,11 @@ PassRefPtr<SerializedScriptValue> SerializedScriptValue::create(ExecState* exec,
     if (!serializationDidCompleteSuccessfully(code))
         return 0;
 
-    return adoptRef(new SerializedScriptValue(buffer, blobURLs, arrayBufferContentsArray.release()));
+    RefPtr<SerializedScriptValue> serializedValue = adoptRef(new SerializedScriptValue(buffer, blobURLs, arrayBufferContentsArray.release()));
+#if ENABLE(CANVAS_PROXY)
+    serializedValue->m_canvasProxyFrameSinks = canvasProxyFrameSinks.release();
+#endif
+    return serializedValue.release();
 }
 
 PassRefPtr<SerializedScriptValue> SerializedScriptValue::create()
@@ -1892,7 +2003,11 @@ JSValue SerializedScriptValue::deserialize(ExecState* exec, JSGlobalObject* glob
                                            MessagePortArray* messagePorts, SerializationErrorMode throwExceptions)
 {
     DeserializationResult result = CloneDeserializer::deserialize(exec, globalObject, messagePorts,
-                                                                  m_arrayBufferContentsArray.get(), m_data);
+                                                                  m_arrayBufferContentsArray.get(),
+#if ENABLE(CANVAS_PROXY)
+                                                                  m_canvasProxyFrameSinks.get(),
+#endif
+                                                                  m_data);
     if (throwExceptions == Throwing)
         maybeThrowExceptionIfSerializationFailed(exec, result.second);
     return result.first;
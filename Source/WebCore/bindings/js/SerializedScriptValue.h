@@ -44,6 +44,13 @@ namespace WebCore {
 class MessagePort;
 typedef Vector<RefPtr<MessagePort>, 1> MessagePortArray;
 typedef Vector<RefPtr<WTF::ArrayBuffer>, 1> ArrayBufferArray;
+
+#if ENABLE(CANVAS_PROXY)
+class CanvasProxy;
+class CanvasProxyFrameSink;
+typedef Vector<RefPtr<CanvasProxy>, 1> CanvasProxyArray;
+typedef Vector<RefPtr<CanvasProxyFrameSink> > CanvasProxyFrameSinkArray;
+#endif
  
 enum SerializationReturnCode {
     SuccessfullyCompleted,
@@ -69,6 +76,12 @@ class SerializedScriptValue :
 public:
     static PassRefPtr<SerializedScriptValue> create(JSC::ExecState*, JSC::JSValue, MessagePortArray*, ArrayBufferArray*,
                                                     SerializationErrorMode = Throwing);
+#if ENABLE(CANVAS_PROXY)
+    // Canvas proxies can only be transferred, so a value holding one that is
+    // not in |canvasProxies| fails to serialize.
+    static PassRefPtr<SerializedScriptValue> create(JSC::ExecState*, JSC::JSValue, MessagePortArray*, ArrayBufferArray*, CanvasProxyArray*,
+                                                    SerializationErrorMode = Throwing);
+#endif
     static PassRefPtr<SerializedScriptValue> create(JSContextRef, JSValueRef, MessagePortArray*, ArrayBufferArray*, JSValueRef* exception);
     static PassRefPtr<SerializedScriptValue> create(JSContextRef, JSValueRef, JSValueRef* exception);
 
@@ -117,6 +130,9 @@ private:
     static void maybeThrowExceptionIfSerializationFailed(JSC::ExecState*, SerializationReturnCode);
     static bool serializationDidCompleteSuccessfully(SerializationReturnCode);
     static PassOwnPtr<ArrayBufferContentsArray> transferArrayBuffers(JSC::ExecState*, ArrayBufferArray&, SerializationReturnCode&);
+#if ENABLE(CANVAS_PROXY)
+    static PassOwnPtr<CanvasProxyFrameSinkArray> transferCanvasProxies(CanvasProxyArray&, SerializationReturnCode&);
+#endif
 
     SerializedScriptValue(const Vector<unsigned char>&);
     SerializedScriptValue(Vector<unsigned char>&);
@@ -124,6 +140,9 @@ private:
     SerializedScriptValue(Vector<unsigned char>&, Vector<String>& blobURLs, PassOwnPtr<ArrayBufferContentsArray>);
     Vector<unsigned char> m_data;
     OwnPtr<ArrayBufferContentsArray> m_arrayBufferContentsArray;
+#if ENABLE(CANVAS_PROXY)
+    OwnPtr<CanvasProxyFrameSinkArray> m_canvasProxyFrameSinks;
+#endif
     Vector<String> m_blobURLs;
 };
 
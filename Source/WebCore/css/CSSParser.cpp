@@ -267,6 +267,7 @@ CSSParserContext::CSSParserContext(CSSParserMode mode, const KURL& baseURL)
     , needsSiteSpecificQuirks(false)
     , enforcesCSSMIMETypeInNoQuirksMode(true)
     , useLegacyBackgroundSizeShorthandBehavior(false)
+    , deferPropertyParsing(false)
 {
 }
 
@@ -286,6 +287,7 @@ CSSParserContext::CSSParserContext(Document* document, const KURL& baseURL, cons
     , needsSiteSpecificQuirks(document->settings() ? document->settings()->needsSiteSpecificQuirks() : false)
     , enforcesCSSMIMETypeInNoQuirksMode(!document->settings() || document->settings()->enforceCSSMIMETypeInNoQuirksMode())
     , useLegacyBackgroundSizeShorthandBehavior(document->settings() ? document->settings()->useLegacyBackgroundSizeShorthandBehavior() : false)
+    , deferPropertyParsing(document->settings() ? document->settings()->deferredCSSParserEnabled() : false)
 {
 }
 
@@ -305,7 +307,8 @@ bool operator==(const CSSParserContext& a, const CSSParserContext& b)
 #endif
         && a.needsSiteSpecificQuirks == b.needsSiteSpecificQuirks
         && a.enforcesCSSMIMETypeInNoQuirksMode == b.enforcesCSSMIMETypeInNoQuirksMode
-        && a.useLegacyBackgroundSizeShorthandBehavior == b.useLegacyBackgroundSizeShorthandBehavior;
+        && a.useLegacyBackgroundSizeShorthandBehavior == b.useLegacyBackgroundSizeShorthandBehavior
+        && a.deferPropertyParsing == b.deferPropertyParsing;
 }
 
 CSSParser::CSSParser(const CSSParserContext& context)
@@ -343,6 +346,8 @@ CSSParser::CSSParser(const CSSParserContext& context)
     , m_lastSelectorLineNumber(0)
     , m_allowImportRules(true)
     , m_allowNamespaceDeclarations(true)
+    , m_deferPropertyParsing(false)
+    , m_deferNextDeclarationBlock(false)
 #if ENABLE(CSS_DEVICE_ADAPTATION)
     , m_inViewport(false)
 #endif
@@ -464,6 +469,12 @@ void CSSParser::parseSheet(StyleSheetContents* sheet, const String& string, int
     m_logErrors = logErrors && sheet->singleOwnerDocument() && !sheet->baseURL().isEmpty() && sheet->singleOwnerDocument()->page();
     m_ignoreErrorsInDeclaration = false;
     m_lineNumber = startLineNumber;
+
+    // The inspector needs the source ranges of every property, so it always gets a fully parsed sheet.
+    m_deferPropertyParsing = m_context.deferPropertyParsing && !ruleSourceDataResult;
+    if (m_deferPropertyParsing)
+        m_deferredStyleSheetText = DeferredStyleSheetText::create(m_context, string);
+
     setupParser("", string, "");
     cssyyparse(this);
     sheet->shrinkToFit();
@@ -472,6 +483,9 @@ void CSSParser::parseSheet(StyleSheetContents* sheet, const String& string, int
     m_rule = 0;
     m_ignoreErrorsInDeclaration = false;
     m_logErrors = false;
+    m_deferPropertyParsing = false;
+    m_deferNextDeclarationBlock = false;
+    m_deferredStyleSheetText = 0;
 }
 
 PassRefPtr<StyleRuleBase> CSSParser::parseRule(StyleSheetContents* sheet, const String& string)
@@ -766,6 +780,10 @@ static inline bool isValidKeywordPropertyAndValue(CSSPropertyID propertyId, int
         if (valueID == CSSValueAuto || valueID == CSSValueAvoid)
             return true;
         break;
+    case CSSPropertyWebkitContain: // none | layout | paint | strict
+        if (valueID == CSSValueNone || valueID == CSSValueLayout || valueID == CSSValuePaint || valueID == CSSValueStrict)
+            return true;
+        break;
     case CSSPropertyPointerEvents:
         // none | visiblePainted | visibleFill | visibleStroke | visible |
         // painted | fill | stroke | auto | all | inherit
@@ -1119,6 +1137,7 @@ static inline bool isKeywordPropertyID(CSSPropertyID propertyId)
     case CSSPropertyWebkitColumnBreakBefore:
     case CSSPropertyWebkitColumnBreakInside:
     case CSSPropertyWebkitColumnRuleStyle:
+    case CSSPropertyWebkitContain:
     case CSSPropertyWebkitAlignContent:
     case CSSPropertyWebkitAlignItems:
     case CSSPropertyWebkitAlignSelf:
@@ -3047,6 +3066,7 @@ bool CSSParser::parseValue(CSSPropertyID propId, bool important)
     case CSSPropertyWebkitColumnBreakBefore:
     case CSSPropertyWebkitColumnBreakInside:
     case CSSPropertyWebkitColumnRuleStyle:
+    case CSSPropertyWebkitContain:
     case CSSPropertyWebkitAlignContent:
     case CSSPropertyWebkitAlignItems:
     case CSSPropertyWebkitAlignSelf:
@@ -6144,6 +6164,9 @@ bool CSSParser::fastParseColor(RGBA32& rgb, const StringType& name, bool strict)
     }
     return false;
 }
+
+// Also used on its own where the full parser can't be, like on worker threads.
+template bool CSSParser::fastParseColor(RGBA32&, const String&, bool);
     
 inline double CSSParser::parsedDouble(CSSParserValue *v, ReleaseParsedCalcValueCondition releaseCalc)
 {
@@ -10015,6 +10038,18 @@ inline UChar* CSSParser::tokenStart<UChar>()
     return m_tokenStart.ptr16;
 }
 
+template <>
+inline LChar* CSSParser::dataStart<LChar>()
+{
+    return m_dataStart8.get();
+}
+
+template <>
+inline UChar* CSSParser::dataStart<UChar>()
+{
+    return m_dataStart16.get();
+}
+
 CSSParser::Location CSSParser::currentLocation()
 {
     Location location;
@@ -11098,6 +11133,8 @@ restartAfterComment:
 
     case CharacterOther:
         // m_token is simply the current character.
+        if (UNLIKELY(m_deferNextDeclarationBlock) && m_token == '}')
+            m_deferNextDeclarationBlock = false;
         break;
 
     case CharacterNull:
@@ -11119,6 +11156,14 @@ restartAfterComment:
     case CharacterEndMediaQuery:
         if (m_parsingMode == MediaQueryMode)
             m_parsingMode = NormalMode;
+        if (UNLIKELY(m_deferNextDeclarationBlock)) {
+            // A selector cannot contain '{' or ';', so either the declaration block starts here or the rule is invalid.
+            m_deferNextDeclarationBlock = false;
+            if (m_token == '{') {
+                skipDeferredDeclarationBlock<SrcCharacterType>();
+                m_token = DEFERRED_DECLARATION_BLOCK;
+            }
+        }
         break;
 
     case CharacterEndNthChild:
@@ -11225,6 +11270,7 @@ restartAfterComment:
         break;
 
     case CharacterAt:
+        m_deferNextDeclarationBlock = false;
         if (isIdentifierStart<SrcCharacterType>()) {
             m_token = ATKEYWORD;
             ++result;
@@ -11270,6 +11316,118 @@ restartAfterComment:
     return token();
 }
 
+template <typename CharacterType>
+void CSSParser::skipDeferredDeclarationBlock()
+{
+    // The opening '{' has already been consumed. Skip to the matching '}' the same way the
+    // tokenizer would split the block into tokens, so strings, comments, escapes and unquoted
+    // urls containing braces do not end the block early.
+    CharacterType* start = dataStart<CharacterType>();
+    CharacterType* character = currentCharacter<CharacterType>();
+    m_deferredDeclarationBlockRange.start = character - start - m_parsedTextPrefixLength;
+
+    // The block is parsed without its style sheet later on, so whether it uses rem units has to
+    // be found out here. A false positive only costs an extra style recalc when the root font
+    // size changes.
+    bool usesRemUnits = false;
+
+    Vector<CharacterType, 16> closingCharacters;
+    while (*character) {
+        CharacterType currentChar = *character;
+        if (currentChar == '}' && closingCharacters.isEmpty())
+            break;
+
+        switch (currentChar) {
+        case '\\': {
+            CharacterType* next = checkAndSkipEscape(character);
+            character = next ? next : character + 1;
+            continue;
+        }
+        case '"':
+        case '\'': {
+            CharacterType* next = checkAndSkipString(character + 1, currentChar);
+            if (!next) {
+                ++character;
+                continue;
+            }
+            for (CharacterType* stringCharacter = character; stringCharacter < next; ++stringCharacter) {
+                if (*stringCharacter == '\n')
+                    ++m_lineNumber;
+            }
+            character = next;
+            continue;
+        }
+        case '/':
+            if (character[1] == '*') {
+                character += 2;
+                while (*character && (character[0] != '*' || character[1] != '/')) {
+                    if (*character == '\n')
+                        ++m_lineNumber;
+                    ++character;
+                }
+                if (*character)
+                    character += 2;
+                continue;
+            }
+            break;
+        case '(':
+            closingCharacters.append(')');
+            if (character - start >= 3 && isASCIIAlphaCaselessEqual(character[-3], 'u') && isASCIIAlphaCaselessEqual(character[-2], 'r') && isASCIIAlphaCaselessEqual(character[-1], 'l')
+                && (character - start == 3 || !isCSSLetter(character[-4]))) {
+                // Unquoted urls may contain any of the block delimiters.
+                CharacterType* uriCharacter = skipWhiteSpace(character + 1);
+                if (*uriCharacter != '"' && *uriCharacter != '\'') {
+                    while (isURILetter(*uriCharacter)) {
+                        if (*uriCharacter == '\\') {
+                            CharacterType* next = checkAndSkipEscape(uriCharacter);
+                            if (!next)
+                                break;
+                            uriCharacter = next;
+                        } else
+                            ++uriCharacter;
+                    }
+                    for (CharacterType* skipped = character; skipped < uriCharacter; ++skipped) {
+                        if (*skipped == '\n')
+                            ++m_lineNumber;
+                    }
+                    character = uriCharacter;
+                    continue;
+                }
+            }
+            break;
+        case 'r':
+        case 'R':
+            if (character - start >= 1 && isASCIIDigit(character[-1]) && isASCIIAlphaCaselessEqual(character[1], 'e') && isASCIIAlphaCaselessEqual(character[2], 'm') && !isCSSLetter(character[3]))
+                usesRemUnits = true;
+            break;
+        case '[':
+            closingCharacters.append(']');
+            break;
+        case '{':
+            closingCharacters.append('}');
+            break;
+        case ')':
+        case ']':
+        case '}':
+            if (!closingCharacters.isEmpty() && closingCharacters.last() == currentChar)
+                closingCharacters.removeLast();
+            break;
+        case '\n':
+            ++m_lineNumber;
+            break;
+        }
+        ++character;
+    }
+
+    m_deferredDeclarationBlockRange.end = character - start - m_parsedTextPrefixLength;
+    if (usesRemUnits && m_styleSheet)
+        m_styleSheet->parserSetUsesRemUnits(true);
+    // An unterminated block is closed by the end of the input, like closing_brace in the grammar.
+    if (*character)
+        ++character;
+    currentCharacter<CharacterType>() = character;
+}
+
 CSSParserSelector* CSSParser::createFloatingSelectorWithTagName(const QualifiedName& tagQName)
 {
     CSSParserSelector* selector = new CSSParserSelector(tagQName);
@@ -11617,6 +11775,24 @@ StyleRuleBase* CSSParser::createStyleRule(Vector<OwnPtr<CSSParserSelector> >* se
     return result;
 }
 
+StyleRuleBase* CSSParser::createStyleRuleWithDeferredProperties(Vector<OwnPtr<CSSParserSelector> >* selectors)
+{
+    ASSERT(m_deferredStyleSheetText);
+    ASSERT(!isExtractingSourceData());
+    ASSERT(m_parsedProperties.isEmpty());
+
+    if (!selectors)
+        return 0;
+
+    m_allowImportRules = m_allowNamespaceDeclarations = false;
+    RefPtr<StyleRule> rule = StyleRule::create(m_lastSelectorLineNumber);
+    rule->parserAdoptSelectorVector(*selectors);
+    rule->setDeferredProperties(m_deferredStyleSheetText, m_deferredDeclarationBlockRange.start, m_deferredDeclarationBlockRange.length());
+    StyleRule* result = rule.get();
+    m_parsedRules.append(rule.release());
+    return result;
+}
+
 StyleRuleBase* CSSParser::createFontFaceRule()
 {
     m_allowImportRules = m_allowNamespaceDeclarations = false;
@@ -52,6 +52,7 @@ class CSSSelectorList;
 class CSSValue;
 class CSSValueList;
 class CSSBasicShape;
+class DeferredStyleSheetText;
 class Document;
 class Element;
 class ImmutableStylePropertySet;
@@ -99,6 +100,7 @@ public:
     static PassRefPtr<CSSValueList> parseFontFaceValue(const AtomicString&);
     PassRefPtr<CSSPrimitiveValue> parseValidPrimitive(CSSValueID ident, CSSParserValue*);
     bool parseDeclaration(MutableStylePropertySet*, const String&, PassRefPtr<CSSRuleSourceData>, StyleSheetContents* contextStyleSheet);
+    PassRefPtr<ImmutableStylePropertySet> parseDeclaration(const String&, StyleSheetContents* contextStyleSheet);
     static PassRefPtr<ImmutableStylePropertySet> parseInlineStyleDeclaration(const String&, Element*);
     PassOwnPtr<MediaQuery> parseMediaQuery(const String&);
 
@@ -322,6 +324,7 @@ public:
     StyleRuleBase* createEmptyMediaRule(RuleList*);
     RuleList* createRuleList();
     StyleRuleBase* createStyleRule(Vector<OwnPtr<CSSParserSelector> >* selectors);
+    StyleRuleBase* createStyleRuleWithDeferredProperties(Vector<OwnPtr<CSSParserSelector> >* selectors);
     StyleRuleBase* createFontFaceRule();
     StyleRuleBase* createPageRule(PassOwnPtr<CSSParserSelector> pageSelector);
     StyleRuleBase* createRegionRule(Vector<OwnPtr<CSSParserSelector> >* regionSelector, RuleList* rules);
@@ -425,6 +428,7 @@ public:
     void markRuleBodyEnd();
     void markPropertyStart();
     void markPropertyEnd(bool isImportantFound, bool isPropertyParsed);
+    void markDeclarationBlockDeferrable() { m_deferNextDeclarationBlock = m_deferPropertyParsing; }
     void processAndAddNewRuleToSourceTreeIfNeeded();
     void addNewRuleToSourceTree(PassRefPtr<CSSRuleSourceData>);
     PassRefPtr<CSSRuleSourceData> popRuleData();
@@ -466,6 +470,9 @@ private:
     template <typename CharacterType>
     inline CharacterType* tokenStart();
 
+    template <typename CharacterType>
+    inline CharacterType* dataStart();
+
     template <typename CharacterType>
     inline void setTokenStart(CharacterType*);
 
@@ -523,6 +530,9 @@ private:
     template <typename CharacterType>
     inline void setRuleHeaderEnd(const CharacterType*);
 
+    template <typename CharacterType>
+    void skipDeferredDeclarationBlock();
+
     void setStyleSheet(StyleSheetContents* styleSheet) { m_styleSheet = styleSheet; }
 
     inline bool inStrictMode() const { return m_context.mode == CSSStrictMode || m_context.mode == SVGAttributeMode; }
@@ -549,7 +559,6 @@ private:
     bool parseGeneratedImage(CSSParserValueList*, RefPtr<CSSValue>&);
 
     bool parseValue(MutableStylePropertySet*, CSSPropertyID, const String&, bool important, StyleSheetContents* contextStyleSheet);
-    PassRefPtr<ImmutableStylePropertySet> parseDeclaration(const String&, StyleSheetContents* contextStyleSheet);
 
     enum SizeParameterType {
         None,
@@ -596,6 +605,14 @@ private:
     bool m_allowImportRules;
     bool m_allowNamespaceDeclarations;
 
+    // Set while parsing a style sheet with CSSParserContext::deferPropertyParsing. The tokenizer
+    // then returns the declaration block of each style rule as a single token and only records
+    // its source range, leaving the parsing of the declarations to StyleRule::properties().
+    bool m_deferPropertyParsing;
+    bool m_deferNextDeclarationBlock;
+    SourceRange m_deferredDeclarationBlockRange;
+    RefPtr<DeferredStyleSheetText> m_deferredStyleSheetText;
+
 #if ENABLE(CSS_DEVICE_ADAPTATION)
     bool parseViewportProperty(CSSPropertyID propId, bool important);
     bool parseViewportShorthand(CSSPropertyID propId, CSSPropertyID first, CSSPropertyID second, bool important);
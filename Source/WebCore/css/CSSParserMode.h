@@ -75,6 +75,7 @@ public:
     bool needsSiteSpecificQuirks;
     bool enforcesCSSMIMETypeInNoQuirksMode;
     bool useLegacyBackgroundSizeShorthandBehavior;
+    bool deferPropertyParsing;
 };
 
 bool operator==(const CSSParserContext&, const CSSParserContext&);
@@ -2733,6 +2733,45 @@ template<> inline CSSPrimitiveValue::operator EUserDrag() const
     return DRAG_AUTO;
 }
 
+template<> inline CSSPrimitiveValue::CSSPrimitiveValue(Containment e)
+    : CSSValue(PrimitiveClass)
+{
+    m_primitiveUnitType = CSS_VALUE_ID;
+    switch (e) {
+    case ContainNone:
+        m_value.valueID = CSSValueNone;
+        break;
+    case ContainLayout:
+        m_value.valueID = CSSValueLayout;
+        break;
+    case ContainPaint:
+        m_value.valueID = CSSValuePaint;
+        break;
+    case ContainStrict:
+        m_value.valueID = CSSValueStrict;
+        break;
+    }
+}
+
+template<> inline CSSPrimitiveValue::operator Containment() const
+{
+    switch (m_value.valueID) {
+    case CSSValueNone:
+        return ContainNone;
+    case CSSValueLayout:
+        return ContainLayout;
+    case CSSValuePaint:
+        return ContainPaint;
+    case CSSValueStrict:
+        return ContainStrict;
+    default:
+        break;
+    }
+
+    ASSERT_NOT_REACHED();
+    return ContainNone;
+}
+
 template<> inline CSSPrimitiveValue::CSSPrimitiveValue(EUserModify e)
     : CSSValue(PrimitiveClass)
 {
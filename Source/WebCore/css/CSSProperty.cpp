@@ -567,6 +567,7 @@ bool CSSProperty::isInheritedProperty(CSSPropertyID propertyID)
     case CSSPropertyWebkitColumnSpan:
     case CSSPropertyWebkitColumnWidth:
     case CSSPropertyWebkitColumns:
+    case CSSPropertyWebkitContain:
 #if ENABLE(CSS_FILTERS)
     case CSSPropertyWebkitFilter:
 #endif
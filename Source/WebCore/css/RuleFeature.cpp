@@ -69,6 +69,7 @@ void RuleFeatureSet::add(const RuleFeatureSet& other)
     uncommonAttributeRules.appendVector(other.uncommonAttributeRules);
     usesFirstLineRules = usesFirstLineRules || other.usesFirstLineRules;
     usesBeforeAfterRules = usesBeforeAfterRules || other.usesBeforeAfterRules;
+    usesSiblingRulesOnAncestors = usesSiblingRulesOnAncestors || other.usesSiblingRulesOnAncestors;
 }
 
 void RuleFeatureSet::clear()
@@ -80,6 +81,7 @@ void RuleFeatureSet::clear()
     uncommonAttributeRules.clear();
     usesFirstLineRules = false;
     usesBeforeAfterRules = false;
+    usesSiblingRulesOnAncestors = false;
 }
 
 } // namespace WebCore
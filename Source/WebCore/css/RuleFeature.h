@@ -48,6 +48,7 @@ struct RuleFeatureSet {
     RuleFeatureSet()
         : usesFirstLineRules(false)
         , usesBeforeAfterRules(false)
+        , usesSiblingRulesOnAncestors(false)
     { }
 
     void add(const RuleFeatureSet&);
@@ -62,6 +63,8 @@ struct RuleFeatureSet {
     Vector<RuleFeature> uncommonAttributeRules;
     bool usesFirstLineRules;
     bool usesBeforeAfterRules;
+    // Whether a sibling or positional selector applies to an ancestor, as in "tr:nth-child(odd) td".
+    bool usesSiblingRulesOnAncestors;
 };
 
 } // namespace WebCore
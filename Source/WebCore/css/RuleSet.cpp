@@ -149,6 +149,7 @@ RuleData::RuleData(StyleRule* rule, unsigned selectorIndex, unsigned position, A
 static void collectFeaturesFromRuleData(RuleFeatureSet& features, const RuleData& ruleData)
 {
     bool foundSiblingSelector = false;
+    bool matchingAncestors = false;
     for (const CSSSelector* selector = ruleData.selector(); selector; selector = selector->tagHistory()) {
         features.collectFeaturesFromSelector(selector);
         
@@ -156,10 +157,17 @@ static void collectFeaturesFromRuleData(RuleFeatureSet& features, const RuleData
             for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector)) {
                 if (!foundSiblingSelector && selector->isSiblingSelector())
                     foundSiblingSelector = true;
+                if (matchingAncestors && subSelector->isSiblingSelector())
+                    features.usesSiblingRulesOnAncestors = true;
                 features.collectFeaturesFromSelector(subSelector);
             }
         } else if (!foundSiblingSelector && selector->isSiblingSelector())
             foundSiblingSelector = true;
+
+        if (matchingAncestors && selector->isSiblingSelector())
+            features.usesSiblingRulesOnAncestors = true;
+        if (selector->relation() == CSSSelector::Descendant || selector->relation() == CSSSelector::Child || selector->relation() == CSSSelector::ShadowDescendant)
+            matchingAncestors = true;
     }
     if (foundSiblingSelector)
         features.siblingRules.append(RuleFeature(ruleData.rule(), ruleData.selectorIndex(), ruleData.hasDocumentSecurityOrigin()));
@@ -458,6 +458,27 @@ static inline bool parentElementPreventsSharing(const Element* parentElement)
     return parentElement->hasFlagsSetDuringStylingOfChildren();
 }
 
+// Siblings matched by positional rules, like zebra-striped table rows, get unique styles, so their
+// children could otherwise never share with their cousins. Children of siblings with equal styles,
+// the same attributes and the same dynamic state match the same descendant rules, as long as no
+// sibling or positional selector applies to the parents themselves.
+bool StyleResolver::siblingParentsAllowCousinSharing(const Element* parent, const Element* sibling) const
+{
+    if (m_ruleSets.features().usesSiblingRulesOnAncestors)
+        return false;
+    if (!parent->isHTMLElement() || sibling->tagQName() != parent->tagQName())
+        return false;
+    if (!parent->renderStyle() || !sibling->renderStyle() || *sibling->renderStyle() != *parent->renderStyle())
+        return false;
+    if (static_cast<const StyledElement*>(sibling)->inlineStyle() || sibling->isFormControlElement())
+        return false;
+    if (sibling->hovered() != parent->hovered() || sibling->active() != parent->active() || sibling->focused() != parent->focused())
+        return false;
+    if (sibling == sibling->document()->cssTarget() || parent == parent->document()->cssTarget())
+        return false;
+    return sibling->hasEquivalentAttributes(parent);
+}
+
 Node* StyleResolver::locateCousinList(Element* parent, unsigned& visitedNodeCount) const
 {
     if (visitedNodeCount >= cStyleSearchThreshold * cStyleSearchLevelThreshold)
@@ -487,12 +508,11 @@ Node* StyleResolver::locateCousinList(Element* parent, unsigned& visitedNodeCoun
     while (thisCousin) {
         while (currentNode) {
             ++subcount;
-            if (currentNode->renderStyle() == parentStyle && currentNode->lastChild()
-                && currentNode->isElementNode() && !parentElementPreventsSharing(toElement(currentNode))
+            if (currentNode->lastChild() && currentNode->isElementNode() && !parentElementPreventsSharing(toElement(currentNode))
 #if ENABLE(SHADOW_DOM)
                 && !toElement(currentNode)->shadow()
 #endif
-                ) {
+                && (currentNode->renderStyle() == parentStyle || (thisCousin == p && siblingParentsAllowCousinSharing(p, toElement(currentNode))))) {
                 // Adjust for unused reserved tries.
                 visitedNodeCount -= cStyleSearchThreshold - subcount;
                 return currentNode->lastChild();
@@ -1436,6 +1456,7 @@ void StyleResolver::adjustRenderStyle(RenderStyle* style, RenderStyle* parentSty
         || style->boxReflect()
         || style->hasFilter()
         || style->hasBlendMode()
+        || style->containsPaint()
         || style->position() == StickyPosition
         || (style->position() == FixedPosition && e && e->document()->page() && e->document()->page()->settings()->fixedPositionCreatesStackingContext())
 #if ENABLE(DIALOG_ELEMENT)
@@ -3009,6 +3030,7 @@ void StyleResolver::applyProperty(CSSPropertyID id, CSSValue* value)
     case CSSPropertyWebkitColumnRuleWidth:
     case CSSPropertyWebkitColumnSpan:
     case CSSPropertyWebkitColumnWidth:
+    case CSSPropertyWebkitContain:
 #if ENABLE(CURSOR_VISIBILITY)
     case CSSPropertyWebkitCursorVisibility:
 #endif
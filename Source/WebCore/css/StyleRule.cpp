@@ -28,6 +28,7 @@
 #include "CSSImportRule.h"
 #include "CSSMediaRule.h"
 #include "CSSPageRule.h"
+#include "CSSParser.h"
 #include "CSSStyleRule.h"
 #include "CSSSupportsRule.h"
 #include "CSSUnknownRule.h"
@@ -239,7 +240,7 @@ StyleRule::StyleRule(int sourceLine)
 
 StyleRule::StyleRule(const StyleRule& o)
     : StyleRuleBase(o)
-    , m_properties(o.m_properties->mutableCopy())
+    , m_properties(o.properties()->mutableCopy())
     , m_selectorList(o.m_selectorList)
 {
 }
@@ -250,7 +251,7 @@ StyleRule::~StyleRule()
 
 MutableStylePropertySet* StyleRule::mutableProperties()
 {
-    if (!m_properties->isMutable())
+    if (!properties()->isMutable())
         m_properties = m_properties->mutableCopy();
     return static_cast<MutableStylePropertySet*>(m_properties.get());
 }
@@ -258,6 +259,25 @@ MutableStylePropertySet* StyleRule::mutableProperties()
 void StyleRule::setProperties(PassRefPtr<StylePropertySet> properties)
 { 
     m_properties = properties;
+    m_deferredProperties.clear();
+}
+
+void StyleRule::setDeferredProperties(PassRefPtr<DeferredStyleSheetText> sheetText, unsigned start, unsigned length)
+{
+    m_properties = 0;
+    m_deferredProperties = adoptPtr(new DeferredProperties(sheetText, start, length));
+}
+
+void StyleRule::parseDeferredProperties() const
+{
+    ASSERT(m_deferredProperties);
+    OwnPtr<DeferredProperties> deferredProperties = m_deferredProperties.release();
+    m_properties = deferredProperties->sheetText->parseDeclarationBlock(deferredProperties->start, deferredProperties->length);
+}
+
+PassRefPtr<StylePropertySet> DeferredStyleSheetText::parseDeclarationBlock(unsigned start, unsigned length) const
+{
+    return CSSParser(m_context).parseDeclaration(m_text.substringSharingImpl(start, length), 0);
 }
 
 PassRefPtr<StyleRule> StyleRule::create(int sourceLine, const Vector<const CSSSelector*>& selectors, PassRefPtr<StylePropertySet> properties)
@@ -276,6 +296,10 @@ Vector<RefPtr<StyleRule> > StyleRule::splitIntoMultipleRulesWithMaximumSelectorC
 {
     ASSERT(selectorList().componentCount() > maxCount);
 
+    // The split rules share a single declaration block.
+    if (m_deferredProperties)
+        parseDeferredProperties();
+
     Vector<RefPtr<StyleRule> > rules;
     Vector<const CSSSelector*> componentsSinceLastSplit;
 
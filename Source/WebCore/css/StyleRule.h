@@ -22,8 +22,11 @@
 #ifndef StyleRule_h
 #define StyleRule_h
 
+#include "CSSParserMode.h"
 #include "CSSSelectorList.h"
 #include "MediaList.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/RefCounted.h>
 #include <wtf/RefPtr.h>
 
 namespace WebCore {
@@ -114,6 +117,25 @@ private:
     signed m_sourceLine : 27;
 };
 
+// The text of a style sheet parsed with CSSParserContext::deferPropertyParsing, shared by all
+// of its style rules until they have parsed their declaration blocks.
+class DeferredStyleSheetText : public RefCounted<DeferredStyleSheetText> {
+public:
+    static PassRefPtr<DeferredStyleSheetText> create(const CSSParserContext& context, const String& text) { return adoptRef(new DeferredStyleSheetText(context, text)); }
+
+    PassRefPtr<StylePropertySet> parseDeclarationBlock(unsigned start, unsigned length) const;
+
+private:
+    DeferredStyleSheetText(const CSSParserContext& context, const String& text)
+        : m_context(context)
+        , m_text(text)
+    {
+    }
+
+    CSSParserContext m_context;
+    String m_text;
+};
+
 class StyleRule : public StyleRuleBase {
     WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -122,13 +144,21 @@ public:
     ~StyleRule();
 
     const CSSSelectorList& selectorList() const { return m_selectorList; }
-    const StylePropertySet* properties() const { return m_properties.get(); }
+    const StylePropertySet* properties() const
+    {
+        if (UNLIKELY(m_deferredProperties))
+            parseDeferredProperties();
+        return m_properties.get();
+    }
+    // Returns 0 if the declaration block has not been parsed yet.
+    const StylePropertySet* propertiesWithoutDeferredParsing() const { return m_properties.get(); }
     MutableStylePropertySet* mutableProperties();
     
     void parserAdoptSelectorVector(Vector<OwnPtr<CSSParserSelector> >& selectors) { m_selectorList.adoptSelectorVector(selectors); }
     void wrapperAdoptSelectorList(CSSSelectorList& selectors) { m_selectorList.adopt(selectors); }
     void parserAdoptSelectorArray(CSSSelector* selectors) { m_selectorList.adoptSelectorArray(selectors); }
     void setProperties(PassRefPtr<StylePropertySet>);
+    void setDeferredProperties(PassRefPtr<DeferredStyleSheetText>, unsigned start, unsigned length);
 
     PassRefPtr<StyleRule> copy() const { return adoptRef(new StyleRule(*this)); }
 
@@ -142,7 +172,25 @@ private:
 
     static PassRefPtr<StyleRule> create(int sourceLine, const Vector<const CSSSelector*>&, PassRefPtr<StylePropertySet>);
 
-    RefPtr<StylePropertySet> m_properties;
+    void parseDeferredProperties() const;
+
+    struct DeferredProperties {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        DeferredProperties(PassRefPtr<DeferredStyleSheetText> sheetText, unsigned start, unsigned length)
+            : sheetText(sheetText)
+            , start(start)
+            , length(length)
+        {
+        }
+
+        RefPtr<DeferredStyleSheetText> sheetText;
+        unsigned start;
+        unsigned length;
+    };
+
+    mutable RefPtr<StylePropertySet> m_properties;
+    mutable OwnPtr<DeferredProperties> m_deferredProperties;
     CSSSelectorList m_selectorList;
 };
 
@@ -433,10 +433,13 @@ static bool childRulesHaveFailedOrCanceledSubresources(const Vector<RefPtr<Style
     for (unsigned i = 0; i < rules.size(); ++i) {
         const StyleRuleBase* rule = rules[i].get();
         switch (rule->type()) {
-        case StyleRuleBase::Style:
-            if (static_cast<const StyleRule*>(rule)->properties()->hasFailedOrCanceledSubresources())
+        case StyleRuleBase::Style: {
+            // A declaration block that has not been parsed yet cannot have started any loads.
+            const StylePropertySet* properties = static_cast<const StyleRule*>(rule)->propertiesWithoutDeferredParsing();
+            if (properties && properties->hasFailedOrCanceledSubresources())
                 return true;
             break;
+        }
         case StyleRuleBase::FontFace:
             if (static_cast<const StyleRuleFontFace*>(rule)->properties()->hasFailedOrCanceledSubresources())
                 return true;
@@ -79,6 +79,9 @@ public:
     Vector<IntRect> renderedRectsForMarkers(DocumentMarker::MarkerType);
     void clearDescriptionOnMarkersIntersectingRange(Range*, DocumentMarker::MarkerTypes);
 
+    // Returns false only if there are no markers of |types| in the document.
+    bool possiblyHasMarkers(DocumentMarker::MarkerTypes);
+
 #ifndef NDEBUG
     void showMarkers() const;
 #endif
@@ -88,7 +91,6 @@ private:
 
     typedef Vector<RenderedDocumentMarker> MarkerList;
     typedef HashMap<RefPtr<Node>, OwnPtr<MarkerList> > MarkerMap;
-    bool possiblyHasMarkers(DocumentMarker::MarkerTypes);
     void removeMarkersFromList(MarkerMap::iterator, DocumentMarker::MarkerTypes);
 
     MarkerMap m_markers;
@@ -518,6 +518,8 @@ bool TextIterator::handleTextNode()
         return true;
     }
 
+    // Whitespace collapsing below walks the text boxes.
+    renderer->ensureLineBoxes();
     if (renderer->firstTextBox())
         m_textBox = renderer->firstTextBox();
 
@@ -1254,6 +1256,7 @@ bool SimplifiedBackwardsTextIterator::handleTextNode()
         return true;
 
     String text = renderer->text();
+    renderer->ensureLineBoxes();
     if (!renderer->firstTextBox() && text.length() > 0)
         return true;
 
@@ -32,6 +32,7 @@
 #include "CanvasContextAttributes.h"
 #include "CanvasGradient.h"
 #include "CanvasPattern.h"
+#include "CanvasProxy.h"
 #include "CanvasRenderingContext2D.h"
 #include "Chrome.h"
 #include "Document.h"
@@ -102,6 +103,11 @@ HTMLCanvasElement::~HTMLCanvasElement()
     for (HashSet<CanvasObserver*>::iterator it = m_observers.begin(); it != end; ++it)
         (*it)->canvasDestroyed(this);
 
+#if ENABLE(CANVAS_PROXY)
+    if (m_proxyFrameSink)
+        m_proxyFrameSink->canvasDestroyed();
+#endif
+
     m_context.clear(); // Ensure this goes away before the ImageBuffer.
 }
 
@@ -200,6 +206,11 @@ CanvasRenderingContext* HTMLCanvasElement::getContext(const String& type, Canvas
     // FIXME: The code depends on the context not going away once created, to prevent JS from
     // seeing a dangling pointer. So for now we will disallow the context from being changed
     // once it is created. https://bugs.webkit.org/show_bug.cgi?id=117095
+#if ENABLE(CANVAS_PROXY)
+    // Once controlled by a proxy, the canvas is only drawn into through it.
+    if (m_proxyFrameSink)
+        return 0;
+#endif
     if (is2dType(type)) {
         if (m_context && !m_context->is2d())
             return 0;
@@ -246,6 +257,10 @@ bool HTMLCanvasElement::supportsContext(const String& type, CanvasContextAttribu
 
     // FIXME: The code depends on the context not going away once created (as getContext
     // is implemented under this assumption) https://bugs.webkit.org/show_bug.cgi?id=117095
+#if ENABLE(CANVAS_PROXY)
+    if (m_proxyFrameSink)
+        return false;
+#endif
     if (is2dType(type))
         return !m_context || m_context->is2d();
 
@@ -289,6 +304,26 @@ void HTMLCanvasElement::didDraw(const FloatRect& rect)
     notifyObserversCanvasChanged(rect);
 }
 
+#if ENABLE(CANVAS_PROXY)
+PassRefPtr<CanvasProxy> HTMLCanvasElement::transferControlToProxy(ExceptionCode& ec)
+{
+    if (m_context || m_proxyFrameSink) {
+        ec = INVALID_STATE_ERR;
+        return 0;
+    }
+
+    m_proxyFrameSink = CanvasProxyFrameSink::create(this, size());
+    return CanvasProxy::create(m_proxyFrameSink);
+}
+
+void HTMLCanvasElement::didCommitProxyFrame(PassRefPtr<Image> frame)
+{
+    ASSERT(m_proxyFrameSink);
+    m_proxyFrame = frame;
+    didDraw(FloatRect(FloatPoint(), size()));
+}
+#endif
+
 void HTMLCanvasElement::notifyObserversCanvasChanged(const FloatRect& rect)
 {
     HashSet<CanvasObserver*>::iterator end = m_observers.end();
@@ -398,6 +433,14 @@ void HTMLCanvasElement::paint(GraphicsContext* context, const LayoutRect& r, boo
 
     if (context->paintingDisabled())
         return;
+
+#if ENABLE(CANVAS_PROXY)
+    if (m_proxyFrameSink) {
+        if (m_proxyFrame)
+            context->drawImage(m_proxyFrame.get(), ColorSpaceDeviceRGB, pixelSnappedIntRect(r), CompositeSourceOver, DoNotRespectImageOrientation, useLowQualityScale);
+        return;
+    }
+#endif
     
     if (m_context) {
         if (!paintsIntoCanvasBuffer() && !document()->printing())
@@ -474,6 +517,13 @@ String HTMLCanvasElement::toDataURL(const String& mimeType, const double* qualit
         return String();
     }
 
+#if ENABLE(CANVAS_PROXY)
+    if (m_proxyFrameSink) {
+        ec = INVALID_STATE_ERR;
+        return String();
+    }
+#endif
+
     if (m_size.isEmpty() || !buffer())
         return String("data:,");
 
@@ -629,6 +679,10 @@ ImageBuffer* HTMLCanvasElement::buffer() const
 
 Image* HTMLCanvasElement::copiedImage() const
 {
+#if ENABLE(CANVAS_PROXY)
+    if (m_proxyFrameSink)
+        return m_proxyFrame.get();
+#endif
     if (!m_copiedImage && buffer()) {
         if (m_context)
             m_context->paintRenderingResultsToCanvas();
@@ -44,6 +44,8 @@
 namespace WebCore {
 
 class CanvasContextAttributes;
+class CanvasProxy;
+class CanvasProxyFrameSink;
 class CanvasRenderingContext;
 class GraphicsContext;
 class GraphicsContextStateSaver;
@@ -98,6 +100,12 @@ public:
     static bool is3dType(const String&);
 #endif
 
+#if ENABLE(CANVAS_PROXY)
+    // Hands control of the canvas to a proxy, typically to be drawn into from a worker.
+    PassRefPtr<CanvasProxy> transferControlToProxy(ExceptionCode&);
+    void didCommitProxyFrame(PassRefPtr<Image>);
+#endif
+
     static String toEncodingMimeType(const String& mimeType);
     String toDataURL(const String& mimeType, const double* quality, ExceptionCode&);
     String toDataURL(const String& mimeType, ExceptionCode& ec) { return toDataURL(mimeType, 0, ec); }
@@ -186,6 +194,11 @@ private:
     
     mutable RefPtr<Image> m_presentedImage;
     mutable RefPtr<Image> m_copiedImage; // FIXME: This is temporary for platforms that have to copy the image buffer to render (and for CSSCanvasValue).
+
+#if ENABLE(CANVAS_PROXY)
+    RefPtr<CanvasProxyFrameSink> m_proxyFrameSink;
+    RefPtr<Image> m_proxyFrame; // The last frame committed through the proxy.
+#endif
 };
 
 } //namespace
@@ -30,22 +30,203 @@
 
 #include "CanvasProxy.h"
 
+#include "CanvasProxyRenderingContext2D.h"
+#include "GraphicsContext.h"
+#include "HTMLCanvasElement.h"
+#include "Image.h"
+#include "ImageBuffer.h"
+#include "IntRect.h"
+#include <wtf/Functional.h>
+#include <wtf/MainThread.h>
+
+#if PLATFORM(QT)
+#include "StillImageQt.h"
+#include <QPixmap>
+#endif
+
 namespace WebCore {
 
-PassRefPtr<CanvasProxy> CanvasProxy::create()
+// Same limit as for canvas elements.
+static const float MaxCanvasArea = 32768 * 8192;
+
+CanvasProxyFrameSink::CanvasProxyFrameSink(HTMLCanvasElement* canvas, const IntSize& size)
+    : m_canvas(canvas)
+    , m_size(size)
+    , m_deliveryScheduled(false)
 {
-    return adoptRef(new CanvasProxy());
+    ASSERT(isMainThread());
 }
 
-CanvasProxy::CanvasProxy()
+void CanvasProxyFrameSink::canvasDestroyed()
+{
+    ASSERT(isMainThread());
+    m_canvas = 0;
+}
+
+#if PLATFORM(QT)
+void CanvasProxyFrameSink::commitFrame(const QImage& frame)
+{
+    QImage replacedFrame;
+    {
+        MutexLocker locker(m_mutex);
+        // A frame that was never delivered was never seen by the main thread
+        // either, so it is fine to let it go here.
+        replacedFrame = m_pendingFrame;
+        m_pendingFrame = frame;
+        if (m_deliveryScheduled)
+            return;
+        m_deliveryScheduled = true;
+    }
+    callOnMainThread(bind(&CanvasProxyFrameSink::deliverFrame, this));
+}
+
+void CanvasProxyFrameSink::deliverFrame()
+{
+    ASSERT(isMainThread());
+
+    QImage frame;
+    {
+        MutexLocker locker(m_mutex);
+        frame = m_pendingFrame;
+        m_pendingFrame = QImage();
+        m_deliveryScheduled = false;
+    }
+    if (!m_canvas || frame.isNull())
+        return;
+
+    // QPixmaps only work on the main thread. A raster pixmap shares the
+    // pixels of the frame, which nothing else references.
+    m_canvas->didCommitProxyFrame(StillImage::create(QPixmap::fromImage(frame)));
+}
+#else
+void CanvasProxyFrameSink::commitFrame(PassRefPtr<Uint8ClampedArray> frame, const IntSize& frameSize)
+{
+    RefPtr<Uint8ClampedArray> replacedFrame;
+    {
+        MutexLocker locker(m_mutex);
+        // A frame that was never delivered was never seen by the main thread
+        // either, so it is fine to let it go here.
+        replacedFrame = m_pendingFrame.release();
+        m_pendingFrame = frame;
+        m_pendingFrameSize = frameSize;
+        if (m_deliveryScheduled)
+            return;
+        m_deliveryScheduled = true;
+    }
+    callOnMainThread(bind(&CanvasProxyFrameSink::deliverFrame, this));
+}
+
+void CanvasProxyFrameSink::deliverFrame()
+{
+    ASSERT(isMainThread());
+
+    RefPtr<Uint8ClampedArray> frame;
+    IntSize frameSize;
+    {
+        MutexLocker locker(m_mutex);
+        frame = m_pendingFrame.release();
+        frameSize = m_pendingFrameSize;
+        m_deliveryScheduled = false;
+    }
+    if (!m_canvas || !frame)
+        return;
+
+    // Images may use platform objects that only work on the main thread.
+    OwnPtr<ImageBuffer> buffer = ImageBuffer::create(frameSize);
+    if (!buffer)
+        return;
+    buffer->putByteArray(Premultiplied, frame.get(), frameSize, IntRect(IntPoint(), frameSize), IntPoint());
+    m_canvas->didCommitProxyFrame(buffer->copyImage(CopyBackingStore, Unscaled));
+}
+#endif
+
+PassRefPtr<CanvasProxy> CanvasProxy::create(PassRefPtr<CanvasProxyFrameSink> frameSink)
+{
+    return adoptRef(new CanvasProxy(frameSink));
+}
+
+CanvasProxy::CanvasProxy(PassRefPtr<CanvasProxyFrameSink> frameSink)
+    : m_frameSink(frameSink)
+    , m_size(m_frameSink->size())
+    , m_hasCreatedImageBuffer(false)
 {
 }
 
 CanvasProxy::~CanvasProxy()
 {
+    m_context.clear(); // Ensure this goes away before the ImageBuffer.
+}
+
+void CanvasProxy::setWidth(int width)
+{
+    reset(IntSize(std::max(width, 0), height()));
+}
+
+void CanvasProxy::setHeight(int height)
+{
+    reset(IntSize(width(), std::max(height, 0)));
+}
+
+void CanvasProxy::reset(const IntSize& size)
+{
+    // Like for canvas elements, setting the size always clears the bitmap.
+    m_size = size;
+    m_hasCreatedImageBuffer = false;
+    m_imageBuffer.clear();
+    if (m_context)
+        m_context->reset();
+}
+
+CanvasProxyRenderingContext2D* CanvasProxy::getContext(const String& type)
+{
+    if (isNeutered() || !HTMLCanvasElement::is2dType(type))
+        return 0;
+    if (!m_context)
+        m_context = CanvasProxyRenderingContext2D::create(this);
+    return m_context.get();
+}
+
+PassRefPtr<CanvasProxyFrameSink> CanvasProxy::transfer()
+{
+    ASSERT(canTransfer());
+    return m_frameSink.release();
+}
+
+ImageBuffer* CanvasProxy::buffer() const
+{
+    if (m_hasCreatedImageBuffer)
+        return m_imageBuffer.get();
+
+    m_hasCreatedImageBuffer = true;
+    if (m_size.isEmpty() || static_cast<float>(m_size.width()) * m_size.height() > MaxCanvasArea)
+        return 0;
+
+    // Accelerated buffers are tied to the GL context of the main thread, and
+    // platform buffers may be too; use plain memory.
+    m_imageBuffer = ImageBuffer::create(m_size, 1, ColorSpaceDeviceRGB, UnacceleratedNonPlatformBuffer);
+    if (!m_imageBuffer)
+        return 0;
+    m_imageBuffer->context()->setShadowsIgnoreTransforms(true);
+    m_imageBuffer->context()->setImageInterpolationQuality(DefaultInterpolationQuality);
+    m_imageBuffer->context()->setStrokeThickness(1);
+    return m_imageBuffer.get();
+}
+
+void CanvasProxy::commit()
+{
+    if (isNeutered() || !buffer())
+        return;
+
+    // The proxy keeps drawing into its buffer, so the frame needs a copy of it.
+    // That copy is made here, on the drawing thread, and is the only one.
+#if PLATFORM(QT)
+    m_frameSink->commitFrame(m_imageBuffer->toQImage());
+#else
+    IntRect frameRect(IntPoint(), m_size);
+    m_frameSink->commitFrame(m_imageBuffer->getPremultipliedImageData(frameRect), m_size);
+#endif
 }
 
 } // namespace WebCore
 
 #endif // ENABLE(CANVAS_PROXY)
-
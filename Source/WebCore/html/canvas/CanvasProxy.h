@@ -27,21 +27,114 @@
 #ifndef CanvasProxy_h
 #define CanvasProxy_h
 
+#if ENABLE(CANVAS_PROXY)
+
+#include "IntSize.h"
+#include <wtf/Forward.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefCounted.h>
+#include <wtf/RefPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Threading.h>
+#include <wtf/Uint8ClampedArray.h>
+
+#if PLATFORM(QT)
+#include <QImage>
+#endif
 
 namespace WebCore {
 
+class CanvasProxyRenderingContext2D;
+class HTMLCanvasElement;
+class Image;
+class ImageBuffer;
+
+// Connects a canvas element placed under the control of a CanvasProxy to
+// whichever thread the proxy ended up on. Committed frames are plain pixel
+// data, handed over rather than copied, and only turned into an image on the
+// main thread; if they come in faster than the main thread can show them,
+// only the most recent one is kept. On Qt, a frame is a QImage that the image
+// shown by the canvas wraps as is.
+class CanvasProxyFrameSink : public ThreadSafeRefCounted<CanvasProxyFrameSink> {
+public:
+    static PassRefPtr<CanvasProxyFrameSink> create(HTMLCanvasElement* canvas, const IntSize& size)
+    {
+        return adoptRef(new CanvasProxyFrameSink(canvas, size));
+    }
+
+    // The size of the canvas when control was transferred.
+    const IntSize& size() const { return m_size; }
+
+    // Called on the main thread when the canvas element goes away.
+    void canvasDestroyed();
+
+    // Called on the thread drawing into the proxy with the pixels of a frame.
+    // They must not be shared with anything else, as they are released on the
+    // main thread.
+#if PLATFORM(QT)
+    void commitFrame(const QImage&);
+#else
+    // The pixels are premultiplied RGBA.
+    void commitFrame(PassRefPtr<Uint8ClampedArray>, const IntSize&);
+#endif
+
+private:
+    CanvasProxyFrameSink(HTMLCanvasElement*, const IntSize&);
+
+    void deliverFrame();
+
+    HTMLCanvasElement* m_canvas; // Only accessed on the main thread.
+    IntSize m_size;
+
+    Mutex m_mutex; // Guards the members below.
+#if PLATFORM(QT)
+    QImage m_pendingFrame;
+#else
+    RefPtr<Uint8ClampedArray> m_pendingFrame;
+    IntSize m_pendingFrameSize;
+#endif
+    bool m_deliveryScheduled;
+};
+
 class CanvasProxy : public RefCounted<CanvasProxy> {
 public:
-    static PassRefPtr<CanvasProxy> create();
+    static PassRefPtr<CanvasProxy> create(PassRefPtr<CanvasProxyFrameSink>);
 
     virtual ~CanvasProxy();
 
+    int width() const { return m_size.width(); }
+    int height() const { return m_size.height(); }
+    void setWidth(int);
+    void setHeight(int);
+
+    CanvasProxyRenderingContext2D* getContext(const String&);
+
+    // Detaches the proxy from its canvas so that a proxy created from the sink
+    // on another thread can take over. Proxies that have been drawn into, or
+    // transferred already, can't be transferred.
+    bool canTransfer() const { return m_frameSink && !m_context; }
+    PassRefPtr<CanvasProxyFrameSink> transfer();
+    bool isNeutered() const { return !m_frameSink; }
+
+    ImageBuffer* buffer() const;
+    void commit();
+
 private:
-    CanvasProxy();
+    explicit CanvasProxy(PassRefPtr<CanvasProxyFrameSink>);
+
+    void reset(const IntSize&);
+
+    RefPtr<CanvasProxyFrameSink> m_frameSink;
+    IntSize m_size;
+    OwnPtr<CanvasProxyRenderingContext2D> m_context;
+
+    mutable bool m_hasCreatedImageBuffer;
+    mutable OwnPtr<ImageBuffer> m_imageBuffer;
 };
 
 } // namespace WebCore
 
+#endif // ENABLE(CANVAS_PROXY)
+
 #endif // CanvasProxy_h
@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(CANVAS_PROXY)
+
+#include "CanvasProxyRenderingContext2D.h"
+
+#include "CSSParser.h"
+#include "CanvasProxy.h"
+#include "FloatRect.h"
+#include "GraphicsContext.h"
+#include "ImageBuffer.h"
+#include <wtf/MathExtras.h>
+
+namespace WebCore {
+
+CanvasProxyRenderingContext2D::State::State()
+    : m_strokeColor(Color::black)
+    , m_fillColor(Color::black)
+    , m_lineWidth(1)
+    , m_lineCap(ButtCap)
+    , m_lineJoin(MiterJoin)
+    , m_miterLimit(10)
+    , m_globalAlpha(1)
+    , m_globalComposite(CompositeSourceOver)
+    , m_globalBlend(BlendModeNormal)
+    , m_invertibleCTM(true)
+{
+}
+
+CanvasProxyRenderingContext2D::CanvasProxyRenderingContext2D(CanvasProxy* canvas)
+    : m_canvas(canvas)
+{
+    m_stateStack.append(State());
+}
+
+CanvasProxyRenderingContext2D::~CanvasProxyRenderingContext2D()
+{
+}
+
+void CanvasProxyRenderingContext2D::ref()
+{
+    m_canvas->ref();
+}
+
+void CanvasProxyRenderingContext2D::deref()
+{
+    m_canvas->deref();
+}
+
+void CanvasProxyRenderingContext2D::reset()
+{
+    m_stateStack.resize(1);
+    m_stateStack.first() = State();
+    m_path.clear();
+}
+
+void CanvasProxyRenderingContext2D::commit()
+{
+    m_canvas->commit();
+}
+
+GraphicsContext* CanvasProxyRenderingContext2D::drawingContext() const
+{
+    ImageBuffer* buffer = m_canvas->buffer();
+    return buffer ? buffer->context() : 0;
+}
+
+void CanvasProxyRenderingContext2D::save()
+{
+    m_stateStack.append(state());
+    if (GraphicsContext* c = drawingContext())
+        c->save();
+}
+
+void CanvasProxyRenderingContext2D::restore()
+{
+    if (m_stateStack.size() <= 1)
+        return;
+    m_path.transform(state().m_transform);
+    m_stateStack.removeLast();
+    m_path.transform(state().m_transform.inverse());
+    if (GraphicsContext* c = drawingContext())
+        c->restore();
+}
+
+void CanvasProxyRenderingContext2D::concatTransform(const AffineTransform& transform)
+{
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+    if (!state().m_invertibleCTM)
+        return;
+
+    AffineTransform newTransform = state().m_transform * transform;
+    if (state().m_transform == newTransform)
+        return;
+
+    if (!newTransform.isInvertible()) {
+        modifiableState().m_invertibleCTM = false;
+        return;
+    }
+
+    modifiableState().m_transform = newTransform;
+    c->concatCTM(transform);
+    m_path.transform(transform.inverse());
+}
+
+void CanvasProxyRenderingContext2D::scale(float sx, float sy)
+{
+    if (!std::isfinite(sx) | !std::isfinite(sy))
+        return;
+    concatTransform(AffineTransform().scaleNonUniform(sx, sy));
+}
+
+void CanvasProxyRenderingContext2D::rotate(float angleInRadians)
+{
+    if (!std::isfinite(angleInRadians))
+        return;
+    concatTransform(AffineTransform().rotate(angleInRadians / piDouble * 180.0));
+}
+
+void CanvasProxyRenderingContext2D::translate(float tx, float ty)
+{
+    if (!std::isfinite(tx) | !std::isfinite(ty))
+        return;
+    concatTransform(AffineTransform().translate(tx, ty));
+}
+
+void CanvasProxyRenderingContext2D::transform(float m11, float m12, float m21, float m22, float dx, float dy)
+{
+    if (!std::isfinite(m11) | !std::isfinite(m21) | !std::isfinite(dx) | !std::isfinite(m12) | !std::isfinite(m22) | !std::isfinite(dy))
+        return;
+    concatTransform(AffineTransform(m11, m12, m21, m22, dx, dy));
+}
+
+void CanvasProxyRenderingContext2D::setTransform(float m11, float m12, float m21, float m22, float dx, float dy)
+{
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+
+    if (!std::isfinite(m11) | !std::isfinite(m21) | !std::isfinite(dx) | !std::isfinite(m12) | !std::isfinite(m22) | !std::isfinite(dy))
+        return;
+
+    AffineTransform ctm = state().m_transform;
+    if (!ctm.isInvertible())
+        return;
+
+    c->setCTM(m_canvas->buffer()->baseTransform());
+    modifiableState().m_transform = AffineTransform();
+    m_path.transform(ctm);
+
+    modifiableState().m_invertibleCTM = true;
+    transform(m11, m12, m21, m22, dx, dy);
+}
+
+void CanvasProxyRenderingContext2D::setGlobalAlpha(float alpha)
+{
+    if (!(alpha >= 0 && alpha <= 1))
+        return;
+    modifiableState().m_globalAlpha = alpha;
+    if (GraphicsContext* c = drawingContext())
+        c->setAlpha(alpha);
+}
+
+String CanvasProxyRenderingContext2D::globalCompositeOperation() const
+{
+    return compositeOperatorName(state().m_globalComposite, state().m_globalBlend);
+}
+
+void CanvasProxyRenderingContext2D::setGlobalCompositeOperation(const String& operation)
+{
+    CompositeOperator op = CompositeSourceOver;
+    BlendMode blendMode = BlendModeNormal;
+    if (!parseCompositeAndBlendOperator(operation, op, blendMode))
+        return;
+    modifiableState().m_globalComposite = op;
+    modifiableState().m_globalBlend = blendMode;
+    if (GraphicsContext* c = drawingContext())
+        c->setCompositeOperation(op, blendMode);
+}
+
+static bool parseColor(const String& colorString, Color& color)
+{
+    // The full CSS parser depends on data that only lives on the main thread;
+    // the fast path covers hex, rgb(), rgba() and named colors without it.
+    RGBA32 rgba;
+    if (!CSSParser::fastParseColor(rgba, colorString, false))
+        return false;
+    color = Color(rgba);
+    return true;
+}
+
+void CanvasProxyRenderingContext2D::setStrokeStyle(const String& colorString)
+{
+    Color color;
+    if (!parseColor(colorString, color))
+        return;
+    modifiableState().m_strokeColor = color;
+    if (GraphicsContext* c = drawingContext())
+        c->setStrokeColor(color, ColorSpaceDeviceRGB);
+}
+
+void CanvasProxyRenderingContext2D::setFillStyle(const String& colorString)
+{
+    Color color;
+    if (!parseColor(colorString, color))
+        return;
+    modifiableState().m_fillColor = color;
+    if (GraphicsContext* c = drawingContext())
+        c->setFillColor(color, ColorSpaceDeviceRGB);
+}
+
+void CanvasProxyRenderingContext2D::setLineWidth(float width)
+{
+    if (!(std::isfinite(width) && width > 0))
+        return;
+    modifiableState().m_lineWidth = width;
+    if (GraphicsContext* c = drawingContext())
+        c->setStrokeThickness(width);
+}
+
+String CanvasProxyRenderingContext2D::lineCap() const
+{
+    return lineCapName(state().m_lineCap);
+}
+
+void CanvasProxyRenderingContext2D::setLineCap(const String& s)
+{
+    LineCap cap;
+    if (!parseLineCap(s, cap))
+        return;
+    modifiableState().m_lineCap = cap;
+    if (GraphicsContext* c = drawingContext())
+        c->setLineCap(cap);
+}
+
+String CanvasProxyRenderingContext2D::lineJoin() const
+{
+    return lineJoinName(state().m_lineJoin);
+}
+
+void CanvasProxyRenderingContext2D::setLineJoin(const String& s)
+{
+    LineJoin join;
+    if (!parseLineJoin(s, join))
+        return;
+    modifiableState().m_lineJoin = join;
+    if (GraphicsContext* c = drawingContext())
+        c->setLineJoin(join);
+}
+
+void CanvasProxyRenderingContext2D::setMiterLimit(float limit)
+{
+    if (!(std::isfinite(limit) && limit > 0))
+        return;
+    modifiableState().m_miterLimit = limit;
+    if (GraphicsContext* c = drawingContext())
+        c->setMiterLimit(limit);
+}
+
+static bool validateRectForCanvas(float& x, float& y, float& width, float& height)
+{
+    if (!std::isfinite(x) | !std::isfinite(y) | !std::isfinite(width) | !std::isfinite(height))
+        return false;
+
+    if (!width && !height)
+        return false;
+
+    if (width < 0) {
+        width = -width;
+        x -= width;
+    }
+
+    if (height < 0) {
+        height = -height;
+        y -= height;
+    }
+
+    return true;
+}
+
+void CanvasProxyRenderingContext2D::clearRect(float x, float y, float width, float height)
+{
+    if (!validateRectForCanvas(x, y, width, height))
+        return;
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+    if (!state().m_invertibleCTM)
+        return;
+
+    GraphicsContextStateSaver stateSaver(*c);
+    c->setAlpha(1);
+    c->setCompositeOperation(CompositeSourceOver);
+    c->clearRect(FloatRect(x, y, width, height));
+}
+
+void CanvasProxyRenderingContext2D::fillRect(float x, float y, float width, float height)
+{
+    if (!validateRectForCanvas(x, y, width, height))
+        return;
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+    if (!state().m_invertibleCTM)
+        return;
+
+    c->fillRect(FloatRect(x, y, width, height));
+}
+
+void CanvasProxyRenderingContext2D::strokeRect(float x, float y, float width, float height)
+{
+    if (!validateRectForCanvas(x, y, width, height))
+        return;
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+    if (!state().m_invertibleCTM)
+        return;
+
+    c->strokeRect(FloatRect(x, y, width, height), state().m_lineWidth);
+}
+
+void CanvasProxyRenderingContext2D::beginPath()
+{
+    m_path.clear();
+}
+
+void CanvasProxyRenderingContext2D::fill()
+{
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+    if (!state().m_invertibleCTM)
+        return;
+
+    if (!m_path.isEmpty())
+        c->fillPath(m_path);
+}
+
+void CanvasProxyRenderingContext2D::stroke()
+{
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+    if (!state().m_invertibleCTM)
+        return;
+
+    if (!m_path.isEmpty())
+        c->strokePath(m_path);
+}
+
+void CanvasProxyRenderingContext2D::clip()
+{
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+    if (!state().m_invertibleCTM)
+        return;
+
+    c->canvasClip(m_path, RULE_NONZERO);
+}
+
+bool CanvasProxyRenderingContext2D::isPointInPath(float x, float y)
+{
+    if (!state().m_invertibleCTM)
+        return false;
+
+    FloatPoint transformedPoint = state().m_transform.inverse().mapPoint(FloatPoint(x, y));
+    if (!std::isfinite(transformedPoint.x()) || !std::isfinite(transformedPoint.y()))
+        return false;
+
+    return m_path.contains(transformedPoint, RULE_NONZERO);
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(CANVAS_PROXY)
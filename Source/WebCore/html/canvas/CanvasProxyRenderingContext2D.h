@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CanvasProxyRenderingContext2D_h
+#define CanvasProxyRenderingContext2D_h
+
+#if ENABLE(CANVAS_PROXY)
+
+#include "AffineTransform.h"
+#include "CanvasPathMethods.h"
+#include "Color.h"
+#include "GraphicsTypes.h"
+#include "ScriptWrappable.h"
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+class CanvasProxy;
+class GraphicsContext;
+
+// The 2D context of a CanvasProxy. It draws into the proxy's ImageBuffer on
+// whatever thread the proxy lives on, typically a worker, and only shows the
+// result once commit() is called. Since fonts, images and style resolution
+// are only available on the main thread, it covers the parts of
+// CanvasRenderingContext2D that don't need them: state, transforms, colors,
+// paths and rectangles.
+class CanvasProxyRenderingContext2D : public CanvasPathMethods, public ScriptWrappable {
+    WTF_MAKE_NONCOPYABLE(CanvasProxyRenderingContext2D); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<CanvasProxyRenderingContext2D> create(CanvasProxy* canvas)
+    {
+        return adoptPtr(new CanvasProxyRenderingContext2D(canvas));
+    }
+    virtual ~CanvasProxyRenderingContext2D();
+
+    void ref();
+    void deref();
+    CanvasProxy* canvas() const { return m_canvas; }
+
+    void commit();
+
+    void save();
+    void restore();
+
+    void scale(float sx, float sy);
+    void rotate(float angleInRadians);
+    void translate(float tx, float ty);
+    void transform(float m11, float m12, float m21, float m22, float dx, float dy);
+    void setTransform(float m11, float m12, float m21, float m22, float dx, float dy);
+
+    float globalAlpha() const { return state().m_globalAlpha; }
+    void setGlobalAlpha(float);
+
+    String globalCompositeOperation() const;
+    void setGlobalCompositeOperation(const String&);
+
+    String strokeStyle() const { return state().m_strokeColor.serialized(); }
+    void setStrokeStyle(const String&);
+
+    String fillStyle() const { return state().m_fillColor.serialized(); }
+    void setFillStyle(const String&);
+
+    float lineWidth() const { return state().m_lineWidth; }
+    void setLineWidth(float);
+
+    String lineCap() const;
+    void setLineCap(const String&);
+
+    String lineJoin() const;
+    void setLineJoin(const String&);
+
+    float miterLimit() const { return state().m_miterLimit; }
+    void setMiterLimit(float);
+
+    void clearRect(float x, float y, float width, float height);
+    void fillRect(float x, float y, float width, float height);
+    void strokeRect(float x, float y, float width, float height);
+
+    void beginPath();
+    void fill();
+    void stroke();
+    void clip();
+    bool isPointInPath(float x, float y);
+
+    // Called when the canvas proxy is resized.
+    void reset();
+
+private:
+    struct State {
+        State();
+
+        Color m_strokeColor;
+        Color m_fillColor;
+        float m_lineWidth;
+        LineCap m_lineCap;
+        LineJoin m_lineJoin;
+        float m_miterLimit;
+        float m_globalAlpha;
+        CompositeOperator m_globalComposite;
+        BlendMode m_globalBlend;
+        AffineTransform m_transform;
+        bool m_invertibleCTM;
+    };
+
+    explicit CanvasProxyRenderingContext2D(CanvasProxy*);
+
+    const State& state() const { return m_stateStack.last(); }
+    State& modifiableState() { return m_stateStack.last(); }
+
+    GraphicsContext* drawingContext() const;
+    void concatTransform(const AffineTransform&);
+
+    virtual bool isTransformInvertible() const OVERRIDE { return state().m_invertibleCTM; }
+
+    CanvasProxy* m_canvas;
+    Vector<State, 1> m_stateStack;
+};
+
+} // namespace WebCore
+
+#endif // ENABLE(CANVAS_PROXY)
+
+#endif // CanvasProxyRenderingContext2D_h
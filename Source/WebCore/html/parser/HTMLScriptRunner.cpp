@@ -250,8 +250,11 @@ void HTMLScriptRunner::requestParsingBlockingScript(Element* element)
     // We only care about a load callback if cachedScript is not already
     // in the cache. Callers will attempt to run the m_parserBlockingScript
     // if possible before returning control to the parser.
-    if (!m_parserBlockingScript.cachedScript()->isLoaded())
+    if (!m_parserBlockingScript.cachedScript()->isLoaded()) {
+        // Nothing else on the page makes progress until the script has run.
+        m_document->cachedResourceLoader()->reprioritize(m_parserBlockingScript.cachedScript(), ResourceLoadPriorityHigh);
         watchForLoad(m_parserBlockingScript);
+    }
 }
 
 void HTMLScriptRunner::requestDeferredScript(Element* element)
@@ -38,6 +38,7 @@
 #include "ResourceLoader.h"
 #include "ResourceRequest.h"
 #include "SubresourceLoader.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/MainThread.h>
 #include <wtf/TemporaryChange.h>
 #include <wtf/text/CString.h>
@@ -47,6 +48,9 @@ namespace WebCore {
 static const unsigned maxRequestsInFlightForNonHTTPProtocols = 20;
 // Match the parallel connection count used by the networking layer.
 static unsigned maxRequestsInFlightPerHost;
+// Connections that only loads the page can't be rendered without may use, so that
+// a host busy with images still starts a late style sheet or script right away.
+static const int requestsReservedForRenderBlockingLoads = 2;
 
 ResourceLoadScheduler::HostInformation* ResourceLoadScheduler::hostForURL(const KURL& url, CreateHostPolicy createHostPolicy)
 {
@@ -160,6 +164,23 @@ void ResourceLoadScheduler::remove(ResourceLoader* resourceLoader)
     scheduleServePendingRequests();
 }
 
+void ResourceLoadScheduler::reprioritize(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
+{
+    ASSERT(resourceLoader);
+    ASSERT(priority != ResourceLoadPriorityUnresolved);
+
+    HostInformation* host = hostForURL(resourceLoader->url());
+    if (!host || !host->reprioritize(resourceLoader, priority))
+        return;
+
+    LOG(ResourceLoading, "ResourceLoadScheduler::reprioritize resource %p '%s' to %d", resourceLoader, resourceLoader->url().string().latin1().data(), priority);
+
+    if (priority > ResourceLoadPriorityLow)
+        servePendingRequests(host, priority);
+    else
+        scheduleServePendingRequests();
+}
+
 void ResourceLoadScheduler::crossOriginRedirectReceived(ResourceLoader* resourceLoader, const KURL& redirectURL)
 {
     HostInformation* oldHost = hostForURL(resourceLoader->url());
@@ -219,6 +240,7 @@ void ResourceLoadScheduler::servePendingRequests(HostInformation* host, Resource
 
             requestsPending.removeFirst();
             host->addLoadInProgress(resourceLoader.get());
+            host->didStartPendingLoad(resourceLoader.get(), ResourceLoadPriority(priority));
             resourceLoader->start();
         }
     }
@@ -252,6 +274,13 @@ void ResourceLoadScheduler::requestTimerFired(Timer<ResourceLoadScheduler>*)
     servePendingRequests();
 }
 
+ResourceLoadScheduler::Statistics& ResourceLoadScheduler::mutableStatistics()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(Statistics, statistics, ());
+    return statistics;
+}
+
 ResourceLoadScheduler::HostInformation::HostInformation(const String& name, unsigned maxRequestsInFlight)
     : m_name(name)
     , m_maxRequestsInFlight(maxRequestsInFlight)
@@ -268,6 +297,18 @@ ResourceLoadScheduler::HostInformation::~HostInformation()
 void ResourceLoadScheduler::HostInformation::schedule(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
 {
     m_requestsPending[priority].append(resourceLoader);
+    m_scheduleTimes.set(resourceLoader, monotonicallyIncreasingTime());
+}
+
+bool ResourceLoadScheduler::HostInformation::reprioritize(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
+{
+    // The load keeps its place in line relative to the other loads of the new priority
+    // that were scheduled before it was, but not to the ones scheduled after.
+    RefPtr<ResourceLoader> protector(resourceLoader);
+    if (!takePending(resourceLoader))
+        return false;
+    m_requestsPending[priority].append(resourceLoader);
+    return true;
 }
     
 void ResourceLoadScheduler::HostInformation::addLoadInProgress(ResourceLoader* resourceLoader)
@@ -275,6 +316,22 @@ void ResourceLoadScheduler::HostInformation::addLoadInProgress(ResourceLoader* r
     LOG(ResourceLoading, "HostInformation '%s' loading '%s'. Current count %d", m_name.latin1().data(), resourceLoader->url().string().latin1().data(), m_requestsLoading.size());
     m_requestsLoading.add(resourceLoader);
 }
+
+void ResourceLoadScheduler::HostInformation::didStartPendingLoad(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
+{
+    HashMap<ResourceLoader*, double>::iterator it = m_scheduleTimes.find(resourceLoader);
+    if (it == m_scheduleTimes.end())
+        return;
+    double queueTime = monotonicallyIncreasingTime() - it->value;
+    m_scheduleTimes.remove(it);
+
+    LOG(ResourceLoading, "HostInformation '%s' started '%s' after %.1f ms in queue %d", m_name.latin1().data(), resourceLoader->url().string().latin1().data(), queueTime * 1000, priority);
+
+    Statistics& statistics = mutableStatistics();
+    ++statistics.startedRequestCount[priority];
+    statistics.totalQueueTime[priority] += queueTime;
+    statistics.maximumQueueTime[priority] = std::max(statistics.maximumQueueTime[priority], queueTime);
+}
     
 void ResourceLoadScheduler::HostInformation::remove(ResourceLoader* resourceLoader)
 {
@@ -282,16 +339,23 @@ void ResourceLoadScheduler::HostInformation::remove(ResourceLoader* resourceLoad
         m_requestsLoading.remove(resourceLoader);
         return;
     }
-    
+
+    takePending(resourceLoader);
+    m_scheduleTimes.remove(resourceLoader);
+}
+
+bool ResourceLoadScheduler::HostInformation::takePending(ResourceLoader* resourceLoader)
+{
     for (int priority = ResourceLoadPriorityHighest; priority >= ResourceLoadPriorityLowest; --priority) {  
         RequestQueue::iterator end = m_requestsPending[priority].end();
         for (RequestQueue::iterator it = m_requestsPending[priority].begin(); it != end; ++it) {
             if (*it == resourceLoader) {
                 m_requestsPending[priority].remove(it);
-                return;
+                return true;
             }
         }
     }
+    return false;
 }
 
 bool ResourceLoadScheduler::HostInformation::hasRequests() const
@@ -309,7 +373,14 @@ bool ResourceLoadScheduler::HostInformation::limitRequests(ResourceLoadPriority
 {
     if (priority == ResourceLoadPriorityVeryLow && !m_requestsLoading.isEmpty())
         return true;
-    return m_requestsLoading.size() >= (resourceLoadScheduler()->isSerialLoadingEnabled() ? 1 : m_maxRequestsInFlight);
+    if (resourceLoadScheduler()->isSerialLoadingEnabled())
+        return m_requestsLoading.size() >= 1;
+
+    // Speculative loads, such as images outside the viewport, leave the last connections free.
+    int maxRequestsInFlight = m_maxRequestsInFlight;
+    if (priority <= ResourceLoadPriorityLow && maxRequestsInFlight > requestsReservedForRenderBlockingLoads)
+        maxRequestsInFlight -= requestsReservedForRenderBlockingLoads;
+    return m_requestsLoading.size() >= maxRequestsInFlight;
 }
 
 } // namespace WebCore
@@ -53,6 +53,8 @@ public:
     virtual PassRefPtr<SubresourceLoader> scheduleSubresourceLoad(Frame*, CachedResource*, const ResourceRequest&, ResourceLoadPriority, const ResourceLoaderOptions&);
     virtual PassRefPtr<NetscapePlugInStreamLoader> schedulePluginStreamLoad(Frame*, NetscapePlugInStreamLoaderClient*, const ResourceRequest&);
     virtual void remove(ResourceLoader*);
+    // Moves a load that is still waiting for a connection to the queue of |priority|.
+    virtual void reprioritize(ResourceLoader*, ResourceLoadPriority);
     virtual void crossOriginRedirectReceived(ResourceLoader*, const KURL& redirectURL);
     
     virtual void servePendingRequests(ResourceLoadPriority minimumPriority = ResourceLoadPriorityVeryLow);
@@ -62,6 +64,24 @@ public:
     bool isSerialLoadingEnabled() const { return m_isSerialLoadingEnabled; }
     virtual void setSerialLoadingEnabled(bool b) { m_isSerialLoadingEnabled = b; }
 
+    // How long loads waited for a connection, per the priority they were started with.
+    struct Statistics {
+        Statistics()
+        {
+            for (int i = 0; i <= ResourceLoadPriorityHighest; ++i) {
+                startedRequestCount[i] = 0;
+                totalQueueTime[i] = 0;
+                maximumQueueTime[i] = 0;
+            }
+        }
+
+        unsigned startedRequestCount[ResourceLoadPriorityHighest + 1];
+        double totalQueueTime[ResourceLoadPriorityHighest + 1];
+        double maximumQueueTime[ResourceLoadPriorityHighest + 1];
+    };
+    static const Statistics& statistics() { return mutableStatistics(); }
+    static void resetStatistics() { mutableStatistics() = Statistics(); }
+
 protected:
     ResourceLoadScheduler();
     virtual ~ResourceLoadScheduler();
@@ -75,6 +95,8 @@ private:
 
     bool isSuspendingPendingRequests() const { return !!m_suspendPendingRequestsCount; }
 
+    static Statistics& mutableStatistics();
+
     class HostInformation {
         WTF_MAKE_NONCOPYABLE(HostInformation); WTF_MAKE_FAST_ALLOCATED;
     public:
@@ -83,7 +105,9 @@ private:
         
         const String& name() const { return m_name; }
         void schedule(ResourceLoader*, ResourceLoadPriority = ResourceLoadPriorityVeryLow);
+        bool reprioritize(ResourceLoader*, ResourceLoadPriority);
         void addLoadInProgress(ResourceLoader*);
+        void didStartPendingLoad(ResourceLoader*, ResourceLoadPriority);
         void remove(ResourceLoader*);
         bool hasRequests() const;
         bool limitRequests(ResourceLoadPriority) const;
@@ -92,9 +116,12 @@ private:
         RequestQueue& requestsPending(ResourceLoadPriority priority) { return m_requestsPending[priority]; }
 
     private:                    
+        bool takePending(ResourceLoader*);
+
         RequestQueue m_requestsPending[ResourceLoadPriorityHighest + 1];
         typedef HashSet<RefPtr<ResourceLoader> > RequestMap;
         RequestMap m_requestsLoading;
+        HashMap<ResourceLoader*, double> m_scheduleTimes;
         const String m_name;
         const int m_maxRequestsInFlight;
     };
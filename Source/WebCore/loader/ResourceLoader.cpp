@@ -377,7 +377,11 @@ void ResourceLoader::didChangePriority(ResourceLoadPriority loadPriority)
     if (handle()) {
         frameLoader()->client()->dispatchDidChangeResourcePriority(identifier(), loadPriority);
         handle()->didChangePriority(loadPriority);
+        return;
     }
+
+    // Not started yet; the scheduler decides how soon it gets a connection.
+    resourceLoadScheduler()->reprioritize(this, loadPriority);
 }
 
 void ResourceLoader::cancel()
@@ -26,12 +26,14 @@
 #include "DOMImplementation.h"
 #include "HTMLMetaCharsetParser.h"
 #include "HTMLNames.h"
+#include "SharedBuffer.h"
 #include "TextCodec.h"
 #include "TextEncoding.h"
 #include "TextEncodingDetector.h"
 #include "TextEncodingRegistry.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/StringExtras.h>
+#include <wtf/text/StringBuilder.h>
 
 using namespace WTF;
 
@@ -676,4 +678,17 @@ String TextResourceDecoder::flush()
     return result;
 }
 
+String TextResourceDecoder::decodeAndFlush(const SharedBuffer* data)
+{
+    StringBuilder result;
+    const char* segment;
+    unsigned position = 0;
+    while (unsigned length = data->getSomeData(segment, position)) {
+        result.append(decode(segment, length));
+        position += length;
+    }
+    result.append(flush());
+    return result.toString();
+}
+
 }
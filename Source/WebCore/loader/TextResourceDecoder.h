@@ -29,6 +29,7 @@
 namespace WebCore {
 
 class HTMLMetaCharsetParser;
+class SharedBuffer;
 
 class TextResourceDecoder : public RefCounted<TextResourceDecoder> {
 public:
@@ -55,6 +56,9 @@ public:
     String decode(const char* data, size_t length);
     String flush();
 
+    // Decodes all of |data| segment by segment, without flattening it first.
+    String decodeAndFlush(const SharedBuffer*);
+
     void setHintEncoding(const TextResourceDecoder* hintDecoder)
     {
         // hintEncoding is for use with autodetection, which should be 
@@ -120,10 +120,7 @@ bool CachedFont::ensureSVGFontData()
         m_externalSVGDocument = SVGDocument::create(0, KURL());
 
         RefPtr<TextResourceDecoder> decoder = TextResourceDecoder::create("application/xml");
-        String svgSource = decoder->decode(m_data->data(), m_data->size());
-        svgSource.append(decoder->flush());
-        
-        m_externalSVGDocument->setContent(svgSource);
+        m_externalSVGDocument->setContent(decoder->decodeAndFlush(m_data->sharedBuffer()));
         
         if (decoder->sawError())
             m_externalSVGDocument = 0;
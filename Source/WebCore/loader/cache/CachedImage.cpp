@@ -155,6 +155,13 @@ bool CachedImage::willPaintBrokenImage() const
     return errorOccurred() && m_shouldPaintBrokenImage;
 }
 
+unsigned CachedImage::decodedSizeSavedByScaling() const
+{
+    if (!m_image || !m_image->isBitmapImage())
+        return 0;
+    return static_cast<BitmapImage*>(m_image.get())->decodedSizeSavedByScaling();
+}
+
 Image* CachedImage::image()
 {
     ASSERT(!isPurgeable());
@@ -477,6 +484,15 @@ void CachedImage::didDraw(const Image* image)
     CachedResource::didAccessDecodedData(timeStamp);
 }
 
+ResourceLoadPriority CachedImage::loadPriorityFromClients()
+{
+    ResourceLoadPriority priority = ResourceLoadPriorityUnresolved;
+    CachedResourceClientWalker<CachedImageClient> w(m_clients);
+    while (CachedImageClient* c = w.next())
+        priority = std::max(priority, c->loadPriorityForImage(this));
+    return priority;
+}
+
 bool CachedImage::shouldPauseAnimation(const Image* image)
 {
     if (!image || image != m_image)
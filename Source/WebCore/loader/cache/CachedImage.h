@@ -57,6 +57,12 @@ public:
     std::pair<Image*, float> brokenImage(float deviceScaleFactor) const; // Returns an image and the image's resolution scale factor.
     bool willPaintBrokenImage() const; 
 
+    // The highest priority any of the clients asks for, or ResourceLoadPriorityUnresolved if none of them displays the image.
+    ResourceLoadPriority loadPriorityFromClients();
+
+    // Bytes the decoded image saves by having been decoded smaller than its intrinsic size.
+    unsigned decodedSizeSavedByScaling() const;
+
     bool canRender(const RenderObject* renderer, float multiplier) { return !errorOccurred() && !imageSizeForRenderer(renderer, multiplier).isEmpty(); }
 
     void setContainerSizeForRenderer(const CachedImageClient*, const IntSize&, float);
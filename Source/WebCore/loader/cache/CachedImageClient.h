@@ -24,6 +24,7 @@
 #define CachedImageClient_h
 
 #include "CachedResourceClient.h"
+#include "ResourceLoadPriority.h"
 
 namespace WebCore {
 
@@ -45,6 +46,10 @@ public:
     // but RenderImages would (assuming they have visibility: visible and their render tree isn't hidden
     // e.g., in the b/f cache or in a background tab).
     virtual bool willRenderImage(CachedImage*) { return false; }
+
+    // Called while the image is loading to find out how soon this client needs it, for instance
+    // because it is in the viewport. Clients that don't display the image have no say in it.
+    virtual ResourceLoadPriority loadPriorityForImage(CachedImage*) { return ResourceLoadPriorityUnresolved; }
 };
 
 }
@@ -24,6 +24,7 @@
 #include "config.h"
 #include "CachedResource.h"
 
+#include "CacheValidation.h"
 #include "CachedResourceClient.h"
 #include "CachedResourceClientWalker.h"
 #include "CachedResourceHandle.h"
@@ -427,14 +428,7 @@ bool CachedResource::isExpired() const
 
 double CachedResource::currentAge() const
 {
-    // RFC2616 13.2.3
-    // No compensation for latency as that is not terribly important in practice
-    double dateValue = m_response.date();
-    double apparentAge = std::isfinite(dateValue) ? std::max(0., m_responseTimestamp - dateValue) : 0;
-    double ageValue = m_response.age();
-    double correctedReceivedAge = std::isfinite(ageValue) ? std::max(apparentAge, ageValue) : apparentAge;
-    double residentTime = currentTime() - m_responseTimestamp;
-    return correctedReceivedAge + residentTime;
+    return computeCurrentAge(m_response, m_responseTimestamp);
 }
 
 double CachedResource::freshnessLifetime() const
@@ -449,20 +443,7 @@ double CachedResource::freshnessLifetime() const
         return std::numeric_limits<double>::max();
     }
 
-    // RFC2616 13.2.4
-    double maxAgeValue = m_response.cacheControlMaxAge();
-    if (std::isfinite(maxAgeValue))
-        return maxAgeValue;
-    double expiresValue = m_response.expires();
-    double dateValue = m_response.date();
-    double creationTime = std::isfinite(dateValue) ? dateValue : m_responseTimestamp;
-    if (std::isfinite(expiresValue))
-        return expiresValue - creationTime;
-    double lastModifiedValue = m_response.lastModified();
-    if (std::isfinite(lastModifiedValue))
-        return (creationTime - lastModifiedValue) * 0.1;
-    // If no cache headers are present, the specification leaves the decision to the UA. Other browsers seem to opt for 0.
-    return 0;
+    return computeFreshnessLifetimeForHTTPFamily(m_response, m_responseTimestamp);
 }
 
 void CachedResource::responseReceived(const ResourceResponse& response)
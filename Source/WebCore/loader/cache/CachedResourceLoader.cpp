@@ -43,6 +43,7 @@
 #include "Frame.h"
 #include "FrameLoader.h"
 #include "FrameLoaderClient.h"
+#include "FrameView.h"
 #include "HTMLElement.h"
 #include "HTMLFrameOwnerElement.h"
 #include "LoaderStrategy.h"
@@ -119,6 +120,7 @@ CachedResourceLoader::CachedResourceLoader(DocumentLoader* documentLoader)
     , m_documentLoader(documentLoader)
     , m_requestCount(0)
     , m_garbageCollectDocumentResourcesTimer(this, &CachedResourceLoader::garbageCollectDocumentResourcesTimerFired)
+    , m_imageLoadPriorityUpdateTimer(this, &CachedResourceLoader::imageLoadPriorityUpdateTimerFired)
     , m_autoLoadImages(true)
     , m_imagesEnabled(true)
     , m_allowStaleResources(false)
@@ -805,6 +807,47 @@ void CachedResourceLoader::garbageCollectDocumentResources()
         m_documentResources.remove(*it);
 }
 
+void CachedResourceLoader::reprioritize(CachedResource* resource, ResourceLoadPriority priority)
+{
+    if (resource && resource->isLoading())
+        resource->setLoadPriority(priority);
+}
+
+void CachedResourceLoader::scheduleImageLoadPriorityUpdate()
+{
+    if (!m_requestCount || m_imageLoadPriorityUpdateTimer.isActive())
+        return;
+    m_imageLoadPriorityUpdateTimer.startOneShot(0);
+}
+
+void CachedResourceLoader::imageLoadPriorityUpdateTimerFired(Timer<CachedResourceLoader>* timer)
+{
+    ASSERT_UNUSED(timer, timer == &m_imageLoadPriorityUpdateTimer);
+    updateImageLoadPriorities();
+}
+
+void CachedResourceLoader::updateImageLoadPriorities()
+{
+    // The clients find out whether they are in the viewport from their layout.
+    FrameView* view = frame() ? frame()->view() : 0;
+    if (!view || view->needsLayout())
+        return;
+
+    Vector<CachedResourceHandle<CachedImage> > images;
+    DocumentResourceMap::iterator end = m_documentResources.end();
+    for (DocumentResourceMap::iterator it = m_documentResources.begin(); it != end; ++it) {
+        CachedResource* resource = it->value.get();
+        if (resource->type() == CachedResource::ImageResource && resource->isLoading())
+            images.append(static_cast<CachedImage*>(resource));
+    }
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        ResourceLoadPriority priority = images[i]->loadPriorityFromClients();
+        if (priority != ResourceLoadPriorityUnresolved)
+            reprioritize(images[i].get(), priority);
+    }
+}
+
 void CachedResourceLoader::performPostLoadActions()
 {
     checkForPendingPreloads();
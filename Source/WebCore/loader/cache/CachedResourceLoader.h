@@ -127,6 +127,12 @@ public:
     void decrementRequestCount(const CachedResource*);
     int requestCount() const { return m_requestCount; }
 
+    // Changes how soon a resource that is still loading gets a connection, for instance once
+    // a script blocks the parser.
+    void reprioritize(CachedResource*, ResourceLoadPriority);
+    // Images that scrolled into or out of the viewport are reprioritized after the current task.
+    void scheduleImageLoadPriorityUpdate();
+
     bool isPreloaded(const String& urlString) const;
     void clearPreloads();
     void clearPendingPreloads();
@@ -157,6 +163,9 @@ private:
     void garbageCollectDocumentResourcesTimerFired(Timer<CachedResourceLoader>*);
     void performPostLoadActions();
 
+    void imageLoadPriorityUpdateTimerFired(Timer<CachedResourceLoader>*);
+    void updateImageLoadPriorities();
+
     bool clientDefersImage(const KURL&) const;
     void reloadImagesIfNotDeferred();
     
@@ -176,6 +185,7 @@ private:
     Deque<PendingPreload> m_pendingPreloads;
 
     Timer<CachedResourceLoader> m_garbageCollectDocumentResourcesTimer;
+    Timer<CachedResourceLoader> m_imageLoadPriorityUpdateTimer;
 
 #if ENABLE(RESOURCE_TIMING)
     struct InitiatorInfo {
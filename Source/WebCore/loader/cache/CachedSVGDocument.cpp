@@ -28,7 +28,6 @@
 #include "CachedResourceClient.h"
 #include "CachedResourceHandle.h"
 #include "ResourceBuffer.h"
-#include <wtf/text/StringBuilder.h>
 
 namespace WebCore {
 
@@ -56,12 +55,9 @@ String CachedSVGDocument::encoding() const
 void CachedSVGDocument::finishLoading(ResourceBuffer* data)
 {
     if (data) {
-        StringBuilder decodedText;
-        decodedText.append(m_decoder->decode(data->data(), data->size()));
-        decodedText.append(m_decoder->flush());
         // We don't need to create a new frame because the new document belongs to the parent UseElement.
         m_document = SVGDocument::create(0, response().url());
-        m_document->setContent(decodedText.toString());
+        m_document->setContent(m_decoder->decodeAndFlush(data->sharedBuffer()));
     }
     CachedResource::finishLoading(data);
 }
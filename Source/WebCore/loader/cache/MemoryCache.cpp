@@ -23,6 +23,7 @@
 #include "config.h"
 #include "MemoryCache.h"
 
+#include "CachedImage.h"
 #include "CachedResource.h"
 #include "CachedResourceHandle.h"
 #include "CrossThreadTask.h"
@@ -35,6 +36,7 @@
 #include "PublicSuffix.h"
 #include "SecurityOrigin.h"
 #include "SecurityOriginHash.h"
+#include "SharedBuffer.h"
 #include "WorkerGlobalScope.h"
 #include "WorkerLoaderProxy.h"
 #include "WorkerThread.h"
@@ -743,6 +745,8 @@ void MemoryCache::TypeStatistic::addResource(CachedResource* o)
     decodedSize += o->decodedSize();
     purgeableSize += purgeable ? pageSize : 0;
     purgedSize += purged ? pageSize : 0;
+    if (o->type() == CachedResource::ImageResource)
+        decodedSizeSavedByScaling += static_cast<CachedImage*>(o)->decodedSizeSavedByScaling();
 }
 
 MemoryCache::Statistics MemoryCache::getStatistics()
@@ -841,7 +845,10 @@ void MemoryCache::dumpStats()
 #endif
     printf("%-13s %13d %13d %13d %13d %13d %13d\n", "JavaScript", s.scripts.count, s.scripts.size, s.scripts.liveSize, s.scripts.decodedSize, s.scripts.purgeableSize, s.scripts.purgedSize);
     printf("%-13s %13d %13d %13d %13d %13d %13d\n", "Fonts", s.fonts.count, s.fonts.size, s.fonts.liveSize, s.fonts.decodedSize, s.fonts.purgeableSize, s.fonts.purgedSize);
-    printf("%-13s %-13s %-13s %-13s %-13s %-13s %-13s\n\n", "-------------", "-------------", "-------------", "-------------", "-------------", "-------------", "-------------");
+    printf("%-13s %-13s %-13s %-13s %-13s %-13s %-13s\n", "-------------", "-------------", "-------------", "-------------", "-------------", "-------------", "-------------");
+    printf("Decoded image bytes saved by scaled decoding: %d\n", s.images.decodedSizeSavedByScaling);
+    const SharedBuffer::Statistics& sharedBufferStatistics = SharedBuffer::statistics();
+    printf("Resource data flattened: %u times, %llu bytes copied\n\n", sharedBufferStatistics.flattenCount, sharedBufferStatistics.flattenedBytes);
 }
 
 void MemoryCache::dumpLRULists(bool includeLive) const
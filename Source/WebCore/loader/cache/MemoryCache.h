@@ -100,7 +100,8 @@ public:
         int decodedSize;
         int purgeableSize;
         int purgedSize;
-        TypeStatistic() : count(0), size(0), liveSize(0), decodedSize(0), purgeableSize(0), purgedSize(0) { }
+        int decodedSizeSavedByScaling;
+        TypeStatistic() : count(0), size(0), liveSize(0), decodedSize(0), purgeableSize(0), purgedSize(0), decodedSizeSavedByScaling(0) { }
         void addResource(CachedResource*);
     };
     
@@ -1234,6 +1234,13 @@ void FrameView::layout(bool allowSubtree)
 
     FontCachePurgePreventer fontCachePurgePreventer;
     RenderLayer* layer;
+
+    // A layout-contained root is laid out on its own. Remember its size and overflow so
+    // that the ancestors can be relaid out if the contents changed what they depend on.
+    RenderBox* containedRoot = subtree && root->isBox() && root->style()->containsLayout() ? toRenderBox(root) : 0;
+    LayoutSize containedRootSize = containedRoot ? containedRoot->size() : LayoutSize();
+    LayoutRect containedRootLayoutOverflow = containedRoot ? containedRoot->layoutOverflowRect() : LayoutRect();
+    LayoutRect containedRootVisualOverflow = containedRoot ? containedRoot->visualOverflowRect() : LayoutRect();
     {
         TemporaryChange<bool> changeSchedulingEnabled(m_layoutSchedulingEnabled, false);
 
@@ -1352,6 +1359,11 @@ void FrameView::layout(bool allowSubtree)
         m_layoutRoot = 0;
     } // Reset m_layoutSchedulingEnabled to its previous value.
 
+    if (containedRoot && (containedRoot->size() != containedRootSize
+        || containedRoot->layoutOverflowRect() != containedRootLayoutOverflow
+        || containedRoot->visualOverflowRect() != containedRootVisualOverflow))
+        containedRoot->markContainingBlocksForLayout();
+
     m_layoutPhase = InViewSizeAdjust;
 
     bool neededFullRepaint = m_doFullRepaint;
@@ -2044,6 +2056,7 @@ void FrameView::scrollPositionChanged()
 {
     frame()->eventHandler()->sendScrollEvent();
     frame()->eventHandler()->dispatchFakeMouseMoveEventSoon();
+    frame()->document()->cachedResourceLoader()->scheduleImageLoadPriorityUpdate();
 
 #if USE(ACCELERATED_COMPOSITING)
     if (RenderView* renderView = this->renderView()) {
@@ -2830,6 +2843,8 @@ void FrameView::performPostLayoutTasks()
 
     if (RenderView* renderView = this->renderView())
         renderView->updateWidgetPositions();
+
+    m_frame->document()->cachedResourceLoader()->scheduleImageLoadPriorityUpdate();
     
     // layout() protects FrameView, but it still can get destroyed when updateWidgets()
     // is called through the post layout timer.
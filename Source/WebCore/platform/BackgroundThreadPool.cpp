@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BackgroundThreadPool.h"
+
+#include <wtf/MainThread.h>
+#include <wtf/NumberOfCores.h>
+
+namespace WebCore {
+
+// Decoding and rasterizing are mostly bound by memory bandwidth; beyond a
+// handful of threads the work is not done any sooner.
+static const int maximumThreads = 4;
+
+BackgroundThreadPool& BackgroundThreadPool::shared()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(BackgroundThreadPool, pool, ());
+    return pool;
+}
+
+BackgroundThreadPool::BackgroundThreadPool()
+{
+}
+
+BackgroundThreadPool::~BackgroundThreadPool()
+{
+    // The pool is never destroyed; its threads live as long as the process.
+    ASSERT_NOT_REACHED();
+}
+
+void BackgroundThreadPool::dispatch(const Function<void ()>& function)
+{
+    ASSERT(isMainThread());
+
+    // Leave one core to the main thread.
+    if (m_threads.isEmpty()) {
+        int threadCount = std::max(1, std::min(maximumThreads, numberOfProcessorCores() - 1));
+        for (int i = 0; i < threadCount; ++i) {
+            if (ThreadIdentifier thread = createThread(BackgroundThreadPool::threadEntryPointCallback, this, "WebCore: Background"))
+                m_threads.append(thread);
+        }
+    }
+
+    m_queue.append(adoptPtr(new Function<void ()>(function)));
+}
+
+void BackgroundThreadPool::threadEntryPointCallback(void* pool)
+{
+    static_cast<BackgroundThreadPool*>(pool)->threadEntryPoint();
+}
+
+void BackgroundThreadPool::threadEntryPoint()
+{
+    ASSERT(!isMainThread());
+
+    while (OwnPtr<Function<void ()> > function = m_queue.waitForMessage())
+        (*function)();
+}
+
+} // namespace WebCore
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BackgroundThreadPool_h
+#define BackgroundThreadPool_h
+
+#include <wtf/Functional.h>
+#include <wtf/MessageQueue.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// A pool of threads shared by the main thread work that can be moved off it,
+// such as decoding images and rasterizing tiles. Functions run in the order
+// they were dispatched in, on whichever thread is free first. Anything they
+// need to hand back to the main thread goes through callOnMainThread().
+class BackgroundThreadPool {
+    WTF_MAKE_NONCOPYABLE(BackgroundThreadPool); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static BackgroundThreadPool& shared();
+
+    void dispatch(const Function<void ()>&);
+
+private:
+    BackgroundThreadPool();
+    ~BackgroundThreadPool();
+
+    // Called on the pool's threads.
+    static void threadEntryPointCallback(void*);
+    void threadEntryPoint();
+
+    Vector<ThreadIdentifier> m_threads;
+    MessageQueue<Function<void ()> > m_queue;
+};
+
+} // namespace WebCore
+
+#endif // BackgroundThreadPool_h
@@ -28,6 +28,7 @@
 #include "SharedBuffer.h"
 
 #include "PurgeableBuffer.h"
+#include <wtf/MainThread.h>
 #include <wtf/PassOwnPtr.h>
 #include <wtf/unicode/UTF8.h>
 #include <wtf/unicode/Unicode.h>
@@ -59,19 +60,29 @@ static inline void freeSegment(char* p)
     fastFree(p);
 }
 
+static SharedBuffer::Statistics& mutableStatistics()
+{
+    ASSERT(isMainThread());
+    static SharedBuffer::Statistics statistics = { 0, 0 };
+    return statistics;
+}
+
 SharedBuffer::SharedBuffer()
     : m_size(0)
+    , m_buffer(adoptRef(new DataBuffer))
 {
 }
 
 SharedBuffer::SharedBuffer(size_t size)
     : m_size(size)
-    , m_buffer(size)
+    , m_buffer(adoptRef(new DataBuffer))
 {
+    m_buffer->data.resize(size);
 }
 
 SharedBuffer::SharedBuffer(const char* data, int size)
     : m_size(0)
+    , m_buffer(adoptRef(new DataBuffer))
 {
     // FIXME: Use unsigned consistently, and check for invalid casts when calling into SharedBuffer from other code.
     if (size < 0)
@@ -82,6 +93,7 @@ SharedBuffer::SharedBuffer(const char* data, int size)
 
 SharedBuffer::SharedBuffer(const unsigned char* data, int size)
     : m_size(0)
+    , m_buffer(adoptRef(new DataBuffer))
 {
     // FIXME: Use unsigned consistently, and check for invalid casts when calling into SharedBuffer from other code.
     if (size < 0)
@@ -98,8 +110,8 @@ SharedBuffer::~SharedBuffer()
 PassRefPtr<SharedBuffer> SharedBuffer::adoptVector(Vector<char>& vector)
 {
     RefPtr<SharedBuffer> buffer = create();
-    buffer->m_buffer.swap(vector);
-    buffer->m_size = buffer->m_buffer.size();
+    buffer->m_buffer->data.swap(vector);
+    buffer->m_size = buffer->m_buffer->data.size();
     return buffer.release();
 }
 
@@ -172,14 +184,15 @@ void SharedBuffer::append(const char* data, unsigned length)
 
     maybeTransferPlatformData();
     
-    unsigned positionInSegment = offsetInSegment(m_size - m_buffer.size());
+    unsigned positionInSegment = offsetInSegment(m_size - m_buffer->data.size());
     m_size += length;
 
     if (m_size <= segmentSize) {
         // No need to use segments for small resource data
-        if (m_buffer.isEmpty())
-            m_buffer.reserveInitialCapacity(length);
-        m_buffer.append(data, length);
+        ensureBufferIsNotShared();
+        if (m_buffer->data.isEmpty())
+            m_buffer->data.reserveInitialCapacity(length);
+        m_buffer->data.append(data, length);
         return;
     }
 
@@ -221,7 +234,11 @@ void SharedBuffer::clear()
     m_segments.clear();
     m_size = 0;
 
-    m_buffer.clear();
+    // Another buffer may still use the bytes.
+    if (m_buffer->hasOneRef())
+        m_buffer->data.clear();
+    else
+        m_buffer = adoptRef(new DataBuffer);
     m_purgeableBuffer.clear();
 #if USE(NETWORK_CFDATA_ARRAY_CALLBACK)
     m_dataArray.clear();
@@ -236,14 +253,23 @@ PassRefPtr<SharedBuffer> SharedBuffer::copy() const
         return clone;
     }
 
+    // Neither buffer changes the bytes in place while they are shared.
+    buffer();
     clone->m_size = m_size;
-    clone->m_buffer.reserveCapacity(m_size);
-    clone->m_buffer.append(m_buffer.data(), m_buffer.size());
-    for (unsigned i = 0; i < m_segments.size(); ++i)
-        clone->m_buffer.append(m_segments[i], segmentSize);
+    clone->m_buffer = m_buffer;
     return clone;
 }
 
+void SharedBuffer::ensureBufferIsNotShared() const
+{
+    if (m_buffer->hasOneRef())
+        return;
+
+    RefPtr<DataBuffer> buffer = adoptRef(new DataBuffer);
+    buffer->data = m_buffer->data;
+    m_buffer = buffer.release();
+}
+
 PassOwnPtr<PurgeableBuffer> SharedBuffer::releasePurgeableBuffer()
 { 
     ASSERT(hasOneRef()); 
@@ -252,10 +278,19 @@ PassOwnPtr<PurgeableBuffer> SharedBuffer::releasePurgeableBuffer()
 
 const Vector<char>& SharedBuffer::buffer() const
 {
-    unsigned bufferSize = m_buffer.size();
+    unsigned bufferSize = m_buffer->data.size();
     if (m_size > bufferSize) {
-        m_buffer.resize(m_size);
-        char* destination = m_buffer.data() + bufferSize;
+        // Buffers flattened on other threads are left out, so that counting needs no lock.
+        if (isMainThread()) {
+            Statistics& statistics = mutableStatistics();
+            ++statistics.flattenCount;
+            // A buffer that is shared with a copy is copied as a whole before it grows.
+            statistics.flattenedBytes += m_buffer->hasOneRef() ? m_size - bufferSize : m_size;
+        }
+
+        ensureBufferIsNotShared();
+        m_buffer->data.resize(m_size);
+        char* destination = m_buffer->data.data() + bufferSize;
         unsigned bytesLeft = m_size - bufferSize;
         for (unsigned i = 0; i < m_segments.size(); ++i) {
             unsigned bytesToCopy = min(bytesLeft, segmentSize);
@@ -269,7 +304,19 @@ const Vector<char>& SharedBuffer::buffer() const
         copyDataArrayAndClear(destination, bytesLeft);
 #endif
     }
-    return m_buffer;
+    return m_buffer->data;
+}
+
+const SharedBuffer::Statistics& SharedBuffer::statistics()
+{
+    return mutableStatistics();
+}
+
+void SharedBuffer::resetStatistics()
+{
+    Statistics& statistics = mutableStatistics();
+    statistics.flattenCount = 0;
+    statistics.flattenedBytes = 0;
 }
 
 unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) const
@@ -287,9 +334,9 @@ unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) con
     }
 
     ASSERT_WITH_SECURITY_IMPLICATION(position < m_size);
-    unsigned consecutiveSize = m_buffer.size();
+    unsigned consecutiveSize = m_buffer->data.size();
     if (position < consecutiveSize) {
-        someData = m_buffer.data() + position;
+        someData = m_buffer->data.data() + position;
         return consecutiveSize - position;
     }
  
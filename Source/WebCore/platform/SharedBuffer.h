@@ -30,6 +30,8 @@
 #include <wtf/Forward.h>
 #include <wtf/OwnPtr.h>
 #include <wtf/RefCounted.h>
+#include <wtf/RefPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
 #include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
 
@@ -93,6 +95,9 @@ public:
     void append(CFDataRef);
 #endif
 
+    // The copy shares the flattened bytes with this buffer until either of them
+    // changes, so it's cheap once all the data has arrived. The bytes are
+    // reference counted thread safely; the copy may be used on another thread.
     PassRefPtr<SharedBuffer> copy() const;
     
     bool hasPurgeableBuffer() const { return m_purgeableBuffer.get(); }
@@ -118,6 +123,16 @@ public:
 
     void tryReplaceContentsWithPlatformBuffer(SharedBuffer*);
 
+    // Copies made on the main thread when the segments are merged into one flat
+    // buffer, which data() and copy() do. Consumers that go through getSomeData()
+    // instead don't add to these.
+    struct Statistics {
+        unsigned flattenCount;
+        unsigned long long flattenedBytes;
+    };
+    static const Statistics& statistics();
+    static void resetStatistics();
+
 private:
     SharedBuffer();
     explicit SharedBuffer(size_t);
@@ -135,8 +150,15 @@ private:
     void maybeTransferPlatformData();
     bool hasPlatformData() const;
     
+    struct DataBuffer : public ThreadSafeRefCounted<DataBuffer> {
+        Vector<char> data;
+    };
+
+    // Makes m_buffer safe to change, copying the bytes if another buffer shares them.
+    void ensureBufferIsNotShared() const;
+
     unsigned m_size;
-    mutable Vector<char> m_buffer;
+    mutable RefPtr<DataBuffer> m_buffer;
     mutable Vector<char*> m_segments;
     mutable OwnPtr<PurgeableBuffer> m_purgeableBuffer;
 #if USE(NETWORK_CFDATA_ARRAY_CALLBACK)
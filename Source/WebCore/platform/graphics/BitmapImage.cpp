@@ -32,12 +32,34 @@
 #include "IntRect.h"
 #include "MIMETypeRegistry.h"
 #include "Timer.h"
+
+#if USE(ASYNC_IMAGE_DECODING)
+#include "ImageDecoder.h"
+#include "ImageDecodingThreadPool.h"
+#include "SharedBuffer.h"
+#endif
+#include <limits>
 #include <wtf/CurrentTime.h>
+#include <wtf/MathExtras.h>
 #include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
 
 namespace WebCore {
 
+#if USE(ASYNC_IMAGE_DECODING)
+// Smaller images decode quickly enough that a thread hop costs more than it saves.
+static const unsigned minimumPixelsForAsyncDecoding = 512 * 512;
+
+bool BitmapImage::s_asyncDecodingEnabled = true;
+#endif
+
+// Animations keep at most this many bytes of decoded frames each...
+static const unsigned maximumFrameCacheBytesPerImage = 5242880;
+// ...and this many bytes all together.
+static const unsigned maximumFrameCacheBytes = 33554432;
+
+unsigned BitmapImage::s_frameCacheBytes = 0;
+
 BitmapImage::BitmapImage(ImageObserver* observer)
     : Image(observer)
     , m_currentFrame(0)
@@ -48,6 +70,7 @@ BitmapImage::BitmapImage(ImageObserver* observer)
     , m_repetitionsComplete(0)
     , m_desiredFrameStartTime(0)
     , m_decodedSize(0)
+    , m_frameCacheBytes(0)
     , m_decodedPropertiesSize(0)
     , m_frameCount(0)
     , m_isSolidColor(false)
@@ -58,13 +81,26 @@ BitmapImage::BitmapImage(ImageObserver* observer)
     , m_sizeAvailable(false)
     , m_hasUniformFrameSize(true)
     , m_haveFrameCount(false)
+#if USE(ASYNC_IMAGE_DECODING)
+    , m_waitingForAnimationFrame(false)
+#endif
+#if USE(SCALED_IMAGE_DECODING)
+    , m_needsIntrinsicSizeFrame(false)
+#endif
 {
 }
 
 BitmapImage::~BitmapImage()
 {
-    invalidatePlatformData();
+    // Stop first so that cancelAnimationFrameDecoding() doesn't start the animation again.
     stopAnimation();
+#if USE(ASYNC_IMAGE_DECODING)
+    cancelAsyncDecoding();
+    cancelAnimationFrameDecoding();
+#endif
+    ASSERT(s_frameCacheBytes >= m_frameCacheBytes);
+    s_frameCacheBytes -= m_frameCacheBytes;
+    invalidatePlatformData();
 }
 
 bool BitmapImage::isBitmapImage() const
@@ -80,6 +116,18 @@ bool BitmapImage::hasSingleSecurityOrigin() const
 
 void BitmapImage::destroyDecodedData(bool destroyAll)
 {
+#if USE(ASYNC_IMAGE_DECODING)
+    if (destroyAll) {
+        cancelAsyncDecoding();
+        cancelAnimationFrameDecoding();
+    }
+#endif
+#if USE(SCALED_IMAGE_DECODING)
+    // Once the frame is evicted, painting may pick a smaller size again.
+    if (destroyAll)
+        m_needsIntrinsicSizeFrame = false;
+#endif
+
     unsigned frameBytesCleared = 0;
     const size_t clearBeforeFrame = destroyAll ? m_frames.size() : m_currentFrame;
 
@@ -103,15 +151,42 @@ void BitmapImage::destroyDecodedData(bool destroyAll)
 
 void BitmapImage::destroyDecodedDataIfNecessary(bool destroyAll)
 {
-    // Animated images >5MB are considered large enough that we'll only hang on
-    // to one frame at a time.
-    static const unsigned cLargeAnimationCutoff = 5242880;
-    unsigned allFrameBytes = 0;
-    for (size_t i = 0; i < m_frames.size(); ++i)
-        allFrameBytes += m_frames[i].m_frameBytes;
+    // Animations that fit in the frame cache keep all their frames decoded.
+    size_t capacity = frameCacheCapacity();
+    if (capacity >= frameCount())
+        return;
 
-    if (allFrameBytes > cLargeAnimationCutoff)
-        destroyDecodedData(destroyAll);
+#if USE(ASYNC_IMAGE_DECODING)
+    if (m_animationFrameDecoder) {
+        destroyFramesOutsideFrameCache(capacity);
+        decodeAnimationFramesAhead();
+        return;
+    }
+#endif
+    destroyDecodedData(destroyAll);
+}
+
+size_t BitmapImage::frameCacheCapacity()
+{
+    // Frames already cached by this image don't count against its share.
+    ASSERT(s_frameCacheBytes >= m_frameCacheBytes);
+    unsigned otherFrameCacheBytes = s_frameCacheBytes - m_frameCacheBytes;
+    unsigned budget = otherFrameCacheBytes < maximumFrameCacheBytes ? maximumFrameCacheBytes - otherFrameCacheBytes : 0;
+    budget = std::min(budget, maximumFrameCacheBytesPerImage);
+
+    // All frames of an animation are as large as the image. Keep at least the
+    // current and the next frame, whatever the budget.
+    IntSize imageSize = size();
+    unsigned long long frameBytes = std::max(1ULL, static_cast<unsigned long long>(imageSize.width()) * imageSize.height() * 4);
+    return std::max<size_t>(2, static_cast<size_t>(budget / frameBytes));
+}
+
+void BitmapImage::updateFrameCacheAccounting()
+{
+    unsigned frameCacheBytes = m_frames.size() > 1 ? m_decodedSize : 0;
+    ASSERT(s_frameCacheBytes >= m_frameCacheBytes);
+    s_frameCacheBytes = s_frameCacheBytes - m_frameCacheBytes + frameCacheBytes;
+    m_frameCacheBytes = frameCacheBytes;
 }
 
 void BitmapImage::destroyMetadataAndNotify(unsigned frameBytesCleared)
@@ -122,6 +197,7 @@ void BitmapImage::destroyMetadataAndNotify(unsigned frameBytesCleared)
 
     ASSERT(m_decodedSize >= frameBytesCleared);
     m_decodedSize -= frameBytesCleared;
+    updateFrameCacheAccounting();
     if (frameBytesCleared > 0) {
         frameBytesCleared += m_decodedPropertiesSize;
         m_decodedPropertiesSize = 0;
@@ -156,6 +232,7 @@ void BitmapImage::cacheFrame(size_t index)
     if (m_frames[index].m_frame) {
         int deltaBytes = safeCast<int>(m_frames[index].m_frameBytes);
         m_decodedSize += deltaBytes;
+        updateFrameCacheAccounting();
         // The fully-decoded frame will subsume the partially decoded data used
         // to determine image properties.
         deltaBytes -= m_decodedPropertiesSize;
@@ -241,6 +318,11 @@ bool BitmapImage::dataChanged(bool allDataReceived)
     // start of the frame data), and any or none of them might be the particular
     // frame affected by appending new data here. Thus we have to clear all the
     // incomplete frames to be safe.
+#if USE(ASYNC_IMAGE_DECODING)
+    cancelAsyncDecoding();
+    cancelAnimationFrameDecoding();
+#endif
+
     unsigned frameBytesCleared = 0;
     for (size_t i = 0; i < m_frames.size(); ++i) {
         // NOTE: Don't call frameIsCompleteAtIndex() here, that will try to
@@ -258,7 +340,13 @@ bool BitmapImage::dataChanged(bool allDataReceived)
     
     m_haveFrameCount = false;
     m_hasUniformFrameSize = true;
-    return isSizeAvailable();
+
+    bool sizeAvailable = isSizeAvailable();
+#if USE(ASYNC_IMAGE_DECODING)
+    if (sizeAvailable && (m_frames.isEmpty() || !m_frames[0].m_frame) && shouldDecodeAsynchronously())
+        startAsyncDecoding();
+#endif
+    return sizeAvailable;
 }
 
 String BitmapImage::filenameExtension() const
@@ -295,8 +383,15 @@ bool BitmapImage::ensureFrameIsCached(size_t index)
     if (index >= frameCount())
         return false;
 
-    if (index >= m_frames.size() || !m_frames[index].m_frame)
+    if (index >= m_frames.size() || !m_frames[index].m_frame) {
+#if USE(ASYNC_IMAGE_DECODING)
+        // Painting skips the image while it is decoded on a decoding thread (see
+        // isWaitingForAsyncDecoding()), so somebody else needs the frame right
+        // now. Take over the decode rather than decoding the frame twice.
+        finishAsyncDecoding();
+#endif
         cacheFrame(index);
+    }
     return true;
 }
 
@@ -323,6 +418,16 @@ float BitmapImage::frameDurationAtIndex(size_t index)
 
 PassNativeImagePtr BitmapImage::nativeImageForCurrentFrame()
 {
+#if USE(SCALED_IMAGE_DECODING)
+    // Callers expect the frame at the intrinsic size. Keep decoding at that
+    // size until the frame is evicted, so painting the image scaled elsewhere
+    // does not replace it with a smaller frame again.
+    if (m_source.maxDecodedPixels()) {
+        m_source.setMaxDecodedPixels(0);
+        destroyDecodedData(true);
+    }
+    m_needsIntrinsicSizeFrame = true;
+#endif
     return frameAtIndex(currentFrame());
 }
 
@@ -367,6 +472,251 @@ bool BitmapImage::notSolidColor()
 
 
 
+unsigned BitmapImage::decodedSizeSavedByScaling() const
+{
+    if (m_frames.isEmpty() || !m_frames[0].m_frame)
+        return 0;
+
+    // Very large images overflow 32 bits here.
+    unsigned long long intrinsicBytes = static_cast<unsigned long long>(m_size.width()) * m_size.height() * 4;
+    if (intrinsicBytes <= m_frames[0].m_frameBytes)
+        return 0;
+    return static_cast<unsigned>(std::min<unsigned long long>(intrinsicBytes - m_frames[0].m_frameBytes, std::numeric_limits<unsigned>::max()));
+}
+
+#if USE(SCALED_IMAGE_DECODING)
+void BitmapImage::updateDecodedSizeForPaint(const FloatSize& paintedSize)
+{
+    // Animations composite frames on top of each other, which needs them all at the same size.
+    if (!m_allDataReceived || frameCount() != 1 || m_needsIntrinsicSizeFrame)
+        return;
+
+    IntSize imageSize = size();
+    unsigned long long intrinsicPixels = static_cast<unsigned long long>(imageSize.width()) * imageSize.height();
+    // Round up generously so that small changes in zoom don't cause another decode.
+    unsigned long long paintedPixels = static_cast<unsigned long long>(ceilf(paintedSize.width() * 1.25f)) * static_cast<unsigned long long>(ceilf(paintedSize.height() * 1.25f));
+
+    // Scaling only pays off when it at least halves the decoded size.
+    unsigned maxDecodedPixels = paintedPixels && paintedPixels * 2 <= intrinsicPixels ? static_cast<unsigned>(paintedPixels) : 0;
+    unsigned currentMaxDecodedPixels = m_source.maxDecodedPixels();
+    if (maxDecodedPixels == currentMaxDecodedPixels)
+        return;
+
+    // Never throw away a decoded frame for a smaller one. A pending decode on a
+    // decoding thread is simply restarted with the new size.
+    bool haveFrame = !m_frames.isEmpty() && m_frames[0].m_frame;
+    if (haveFrame && (!currentMaxDecodedPixels || (maxDecodedPixels && maxDecodedPixels < currentMaxDecodedPixels)))
+        return;
+
+    m_source.setMaxDecodedPixels(maxDecodedPixels);
+#if USE(ASYNC_IMAGE_DECODING)
+    // Keep painting the smaller frame until the decoding thread is done with
+    // the larger one; didFinishAsyncDecoding() replaces it.
+    cancelAsyncDecoding();
+    if (haveFrame && shouldDecodeAsynchronously()) {
+        startAsyncDecoding();
+        return;
+    }
+#endif
+    destroyDecodedData(true);
+#if USE(ASYNC_IMAGE_DECODING)
+    if (shouldDecodeAsynchronously())
+        startAsyncDecoding();
+#endif
+}
+#endif
+
+#if USE(ASYNC_IMAGE_DECODING)
+bool BitmapImage::shouldDecodeAsynchronously()
+{
+    // Without an observer nobody would repaint the image once the frame is ready.
+    if (!s_asyncDecodingEnabled || !m_allDataReceived || !imageObserver() || m_asyncDecodingTask)
+        return false;
+
+    // Only still images; animations decode their frames as they advance.
+    if (frameCount() != 1)
+        return false;
+
+    IntSize imageSize = size();
+    return static_cast<unsigned long long>(imageSize.width()) * imageSize.height() >= minimumPixelsForAsyncDecoding;
+}
+
+bool BitmapImage::isWaitingForAsyncDecoding() const
+{
+    return m_asyncDecodingTask && (m_frames.isEmpty() || !m_frames[0].m_frame);
+}
+
+void BitmapImage::startAsyncDecoding()
+{
+    ASSERT(!m_asyncDecodingTask);
+
+    // Formats that only the platform decoder handles keep decoding synchronously.
+    OwnPtr<ImageDecoder> decoder = adoptPtr(ImageDecoder::createForDecodingThread(*data(), m_source.alphaOption(), m_source.gammaAndColorProfileOption()));
+    if (!decoder)
+        return;
+
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    if (ImageSource::maxPixelsPerDecodedImage())
+        decoder->setMaxNumPixels(ImageSource::maxPixelsPerDecodedImage());
+#endif
+#if USE(SCALED_IMAGE_DECODING)
+    if (m_source.maxDecodedPixels())
+        decoder->setMaxNumPixels(m_source.maxDecodedPixels());
+#endif
+
+    // SharedBuffer isn't thread safe, so the decoding thread gets its own. The
+    // copy shares the bytes with data(), which no longer change, so it's cheap.
+    m_asyncDecodingTask = AsyncImageDecodingTask::create(this, decoder.release(), data()->copy());
+    m_asyncDecodingTask->start();
+}
+
+void BitmapImage::cancelAsyncDecoding()
+{
+    if (!m_asyncDecodingTask)
+        return;
+
+    m_asyncDecodingTask->cancel();
+    m_asyncDecodingTask = 0;
+}
+
+void BitmapImage::finishAsyncDecoding()
+{
+    if (!m_asyncDecodingTask)
+        return;
+
+    RefPtr<AsyncImageDecodingTask> task = m_asyncDecodingTask.release();
+    OwnPtr<ImageDecoder> decoder = task->takeDecoder();
+    if (!decoder || decoder->failed() || !decoder->frameIsCompleteAtIndex(0))
+        return;
+
+    // cacheFrame() picks the frame up from the decoder.
+    m_source.setDecoder(decoder.release());
+}
+
+void BitmapImage::didFinishAsyncDecoding(PassOwnPtr<ImageDecoder> decoder)
+{
+    ASSERT(m_asyncDecodingTask);
+    m_asyncDecodingTask = 0;
+
+    // If the frame couldn't be decoded, keep our own decoder; the next draw
+    // decodes synchronously and runs into the same error there.
+    if (decoder && !decoder->failed() && decoder->frameIsCompleteAtIndex(0)) {
+        // A frame decoded at a smaller size was painted in the meantime.
+        if (!m_frames.isEmpty() && m_frames[0].m_frame)
+            destroyDecodedData(true);
+        m_source.setDecoder(decoder);
+    }
+
+    if (imageObserver())
+        imageObserver()->changedInRect(this, IntRect(IntPoint(), size()));
+}
+
+void BitmapImage::destroyFramesOutsideFrameCache(size_t capacity)
+{
+    size_t numFrames = frameCount();
+    unsigned frameBytesCleared = 0;
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        size_t framesAhead = (i + numFrames - m_currentFrame) % numFrames;
+        if (framesAhead < capacity)
+            continue;
+        unsigned frameBytes = m_frames[i].m_frameBytes;
+        if (m_frames[i].clear(false))
+            frameBytesCleared += frameBytes;
+    }
+    if (frameBytesCleared)
+        destroyMetadataAndNotify(frameBytesCleared);
+}
+
+void BitmapImage::decodeAnimationFramesAhead()
+{
+    if (!m_animationFrameDecoder || m_animationFrameDecoder->isDecoding())
+        return;
+
+    // The current frame is decoded by draw() if need be; start with the first
+    // missing frame after it.
+    size_t numFrames = frameCount();
+    size_t capacity = std::min(frameCacheCapacity(), numFrames);
+    for (size_t framesAhead = 1; framesAhead < capacity; ++framesAhead) {
+        size_t index = (m_currentFrame + framesAhead) % numFrames;
+        if (index >= m_frames.size() || !m_frames[index].m_frame) {
+            m_animationFrameDecoder->decodeFrames(index, capacity - framesAhead, numFrames);
+            return;
+        }
+    }
+}
+
+void BitmapImage::cancelAnimationFrameDecoding()
+{
+    if (!m_animationFrameDecoder)
+        return;
+
+    m_animationFrameDecoder->cancel();
+    m_animationFrameDecoder = 0;
+
+    // The animation was stopped until the decoder came back with the next
+    // frame; start it again, the frame is decoded when it is drawn.
+    if (m_waitingForAnimationFrame) {
+        m_waitingForAnimationFrame = false;
+        startAnimation();
+    }
+}
+
+void BitmapImage::cacheDecodedAnimationFrame(size_t index, const ImageFrame& frame)
+{
+    size_t numFrames = frameCount();
+    if (index >= numFrames)
+        return;
+
+    // The animation may have moved on while the frame was being decoded.
+    size_t framesAhead = (index + numFrames - m_currentFrame) % numFrames;
+    if (framesAhead >= frameCacheCapacity())
+        return;
+
+    if (m_frames.size() < numFrames)
+        m_frames.grow(numFrames);
+    if (m_frames[index].m_frame)
+        return;
+
+    m_frames[index].m_frame = frame.asNewNativeImage();
+    m_frames[index].m_orientation = m_source.orientationAtIndex(index);
+    m_frames[index].m_haveMetadata = true;
+    m_frames[index].m_isComplete = true;
+    m_frames[index].m_duration = m_source.frameDurationAtIndex(index);
+    m_frames[index].m_hasAlpha = frame.hasAlpha();
+    m_frames[index].m_frameBytes = m_source.frameBytesAtIndex(index);
+    if (!m_frames[index].m_frame)
+        return;
+
+    int deltaBytes = safeCast<int>(m_frames[index].m_frameBytes);
+    m_decodedSize += deltaBytes;
+    updateFrameCacheAccounting();
+    deltaBytes -= m_decodedPropertiesSize;
+    m_decodedPropertiesSize = 0;
+    if (imageObserver())
+        imageObserver()->decodedSizeChanged(this, deltaBytes);
+}
+
+void BitmapImage::didDecodeAnimationFrames()
+{
+    if (m_waitingForAnimationFrame && frameIsReadyForAnimation((m_currentFrame + 1) % frameCount())) {
+        m_waitingForAnimationFrame = false;
+        startAnimation();
+    }
+    decodeAnimationFramesAhead();
+}
+#endif
+
+bool BitmapImage::frameIsReadyForAnimation(size_t index)
+{
+#if USE(ASYNC_IMAGE_DECODING)
+    if (m_animationFrameDecoder && frameCacheCapacity() < frameCount())
+        return index < m_frames.size() && m_frames[index].m_frame;
+#else
+    UNUSED_PARAM(index);
+#endif
+    return true;
+}
+
 int BitmapImage::repetitionCount(bool imageKnownToBeComplete)
 {
     if ((m_repetitionCountStatus == Unknown) || ((m_repetitionCountStatus == Uncertain) && imageKnownToBeComplete)) {
@@ -391,6 +741,15 @@ void BitmapImage::startAnimation(bool catchUpIfNecessary)
     if (m_frameTimer || !shouldAnimate() || frameCount() <= 1)
         return;
 
+#if USE(ASYNC_IMAGE_DECODING)
+    // Animations that fit in the frame cache keep their frames once decoded,
+    // so only larger ones decode ahead on a decoding thread.
+    if (!m_animationFrameDecoder && s_asyncDecodingEnabled && m_allDataReceived && data() && frameCacheCapacity() < frameCount()) {
+        if (OwnPtr<ImageDecoder> decoder = adoptPtr(ImageDecoder::createForDecodingThread(*data(), m_source.alphaOption(), m_source.gammaAndColorProfileOption())))
+            m_animationFrameDecoder = AnimationFrameDecoder::create(this, decoder.release(), data()->copy(), m_source.alphaOption(), m_source.gammaAndColorProfileOption());
+    }
+#endif
+
     // If we aren't already animating, set now as the animation start time.
     const double time = monotonicallyIncreasingTime();
     if (!m_desiredFrameStartTime)
@@ -401,6 +760,16 @@ void BitmapImage::startAnimation(bool catchUpIfNecessary)
     if (!m_allDataReceived && !frameIsCompleteAtIndex(nextFrame))
         return;
 
+#if USE(ASYNC_IMAGE_DECODING)
+    // Rather than decoding the next frame here, wait for the decoding thread;
+    // didDecodeAnimationFrames() starts the animation again.
+    if (!frameIsReadyForAnimation(nextFrame)) {
+        m_waitingForAnimationFrame = true;
+        decodeAnimationFramesAhead();
+        return;
+    }
+#endif
+
     // Don't advance past the last frame if we haven't decoded the whole image
     // yet and our repetition count is potentially unset.  The repetition count
     // in a GIF can potentially come after all the rest of the image data, so
@@ -443,7 +812,7 @@ void BitmapImage::startAnimation(bool catchUpIfNecessary)
         // See if we've also passed the time for frames after that to start, in
         // case we need to skip some frames entirely.  Remember not to advance
         // to an incomplete frame.
-        for (size_t frameAfterNext = (nextFrame + 1) % frameCount(); frameIsCompleteAtIndex(frameAfterNext); frameAfterNext = (nextFrame + 1) % frameCount()) {
+        for (size_t frameAfterNext = (nextFrame + 1) % frameCount(); frameIsCompleteAtIndex(frameAfterNext) && frameIsReadyForAnimation(frameAfterNext); frameAfterNext = (nextFrame + 1) % frameCount()) {
             // Should we skip the next frame?
             double frameAfterNextStartTime = m_desiredFrameStartTime + frameDurationAtIndex(nextFrame);
             if (time < frameAfterNextStartTime)
@@ -488,6 +857,9 @@ void BitmapImage::stopAnimation()
     // the timer unless all renderers have stopped drawing.
     delete m_frameTimer;
     m_frameTimer = 0;
+#if USE(ASYNC_IMAGE_DECODING)
+    m_waitingForAnimationFrame = false;
+#endif
 }
 
 void BitmapImage::resetAnimation()
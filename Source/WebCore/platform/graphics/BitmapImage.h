@@ -55,6 +55,9 @@ namespace WTF {
 
 namespace WebCore {
 
+class AnimationFrameDecoder;
+class AsyncImageDecodingTask;
+class ImageFrame;
 template <typename T> class Timer;
 
 // ================================================
@@ -133,6 +136,9 @@ public:
 
     virtual unsigned decodedSize() const;
 
+    // How many bytes smaller the decoded frames are than they would be at the intrinsic size.
+    unsigned decodedSizeSavedByScaling() const;
+
 #if PLATFORM(MAC)
     // Accessors for native image formats.
     virtual NSImage* getNSImage();
@@ -173,6 +179,29 @@ public:
     
     bool canAnimate();
 
+#if USE(SCALED_IMAGE_DECODING)
+    // Called before drawing with the size, in device pixels, the whole image
+    // would be painted at. Picks the size the frame is decoded at; an already
+    // decoded frame is only replaced if the image is now painted larger.
+    void updateDecodedSizeForPaint(const FloatSize&);
+#endif
+
+#if USE(ASYNC_IMAGE_DECODING)
+    // Called on the main thread when a decoding thread is done with the first frame.
+    void didFinishAsyncDecoding(PassOwnPtr<ImageDecoder>);
+
+    // Large images are decoded on a background thread once all their data has arrived.
+    static void setAsyncDecodingEnabled(bool enabled) { s_asyncDecodingEnabled = enabled; }
+
+    // Whether the frame is still being decoded on a background thread. Painting
+    // skips the image meanwhile; the observer is told to repaint once it's done.
+    bool isWaitingForAsyncDecoding() const;
+
+    // Called on the main thread as the animation decoder hands back frames.
+    void cacheDecodedAnimationFrame(size_t index, const ImageFrame&);
+    void didDecodeAnimationFrames();
+#endif
+
 private:
     void updateSize() const;
 
@@ -220,10 +249,19 @@ protected:
     // low without redecoding the whole image on every frame.
     virtual void destroyDecodedData(bool destroyAll = true);
 
-    // If the image is large enough, calls destroyDecodedData() and passes
-    // |destroyAll| along.
+    // If not all frames of the animation fit in the frame cache, throws away
+    // the frames that are not among the next frameCacheCapacity() ones,
+    // starting at the current frame. Without a decoding thread this calls
+    // destroyDecodedData() and passes |destroyAll| along.
     void destroyDecodedDataIfNecessary(bool destroyAll);
 
+    // How many decoded frames of this animation may be kept at a time. The
+    // budget is per image, and also shared by all animations.
+    size_t frameCacheCapacity();
+
+    // Keeps s_frameCacheBytes in sync with the decoded frames of this animation.
+    void updateFrameCacheAccounting();
+
     // Generally called by destroyDecodedData(), destroys whole-image metadata
     // and notifies observers that the memory footprint has (hopefully)
     // decreased by |frameBytesCleared|.
@@ -261,6 +299,26 @@ protected:
     
     virtual bool mayFillWithSolidColor();
     virtual Color solidColor() const;
+
+#if USE(ASYNC_IMAGE_DECODING)
+    bool shouldDecodeAsynchronously();
+    void startAsyncDecoding();
+    // Drops the pending background decode, if any; the frame is then decoded
+    // synchronously the next time it is needed.
+    void cancelAsyncDecoding();
+    // Waits for a background decode that is already running and takes over its decoder.
+    void finishAsyncDecoding();
+
+    // Animations that don't fit in the frame cache decode the frames ahead of
+    // the current one on a decoding thread once all their data has arrived.
+    // Cancelling restarts an animation that was waiting for the next frame.
+    void destroyFramesOutsideFrameCache(size_t capacity);
+    void decodeAnimationFramesAhead();
+    void cancelAnimationFrameDecoding();
+#endif
+
+    // Whether the animation can move on to the frame without decoding it first.
+    bool frameIsReadyForAnimation(size_t);
     
     ImageSource m_source;
     mutable IntSize m_size; // The size to use for the overall image (will just be the size of the first image).
@@ -283,6 +341,8 @@ protected:
     Color m_solidColor;  // If we're a 1x1 solid color, this is the color to use to fill.
 
     unsigned m_decodedSize; // The current size of all decoded frames.
+    unsigned m_frameCacheBytes; // The part of s_frameCacheBytes that is ours; m_decodedSize if we are animated.
+    static unsigned s_frameCacheBytes; // The size of the decoded frames of all animations.
     mutable unsigned m_decodedPropertiesSize; // The size of data decoded by the source to determine image properties (e.g. size, frame count, etc).
     size_t m_frameCount;
 
@@ -296,6 +356,16 @@ protected:
     bool m_sizeAvailable : 1; // Whether or not we can obtain the size of the first image frame yet from ImageIO.
     mutable bool m_hasUniformFrameSize : 1;
     mutable bool m_haveFrameCount : 1;
+
+#if USE(ASYNC_IMAGE_DECODING)
+    RefPtr<AsyncImageDecodingTask> m_asyncDecodingTask;
+    RefPtr<AnimationFrameDecoder> m_animationFrameDecoder;
+    bool m_waitingForAnimationFrame;
+    static bool s_asyncDecodingEnabled;
+#endif
+#if USE(SCALED_IMAGE_DECODING)
+    bool m_needsIntrinsicSizeFrame; // Whether a caller needed the current frame at the intrinsic size since the last eviction.
+#endif
 };
 
 }
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DisplayList.h"
+
+#include "GraphicsContext.h"
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+DisplayList::Statistics& DisplayList::mutableStatistics()
+{
+    // Painting only ever happens on the main thread.
+    ASSERT(isMainThread());
+    static Statistics statistics = { 0, 0, 0, 0 };
+    return statistics;
+}
+
+const DisplayList::Statistics& DisplayList::statistics()
+{
+    return mutableStatistics();
+}
+
+void DisplayList::resetStatistics()
+{
+    Statistics& statistics = mutableStatistics();
+    statistics.recordCount = 0;
+    statistics.recordTime = 0;
+    statistics.replayCount = 0;
+    statistics.replayTime = 0;
+}
+
+#if !PLATFORM(QT)
+PassOwnPtr<DisplayList> DisplayList::create(const IntRect&, float)
+{
+    return nullptr;
+}
+
+DisplayList::~DisplayList()
+{
+}
+
+GraphicsContext* DisplayList::beginRecording()
+{
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
+void DisplayList::endRecording()
+{
+    ASSERT_NOT_REACHED();
+}
+
+void DisplayList::replay(GraphicsContext*, const IntRect&)
+{
+    ASSERT_NOT_REACHED();
+}
+
+void DisplayList::rasterize(GraphicsContext*, const IntRect&)
+{
+    ASSERT_NOT_REACHED();
+}
+
+size_t DisplayList::sizeInBytes() const
+{
+    return 0;
+}
+#endif
+
+} // namespace WebCore
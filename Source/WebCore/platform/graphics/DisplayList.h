@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DisplayList_h
+#define DisplayList_h
+
+#include "IntRect.h"
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+
+#if PLATFORM(QT)
+#include <QPicture>
+QT_BEGIN_NAMESPACE
+class QPainter;
+QT_END_NAMESPACE
+#endif
+
+namespace WebCore {
+
+class GraphicsContext;
+#if PLATFORM(QT)
+class DisplayListRecordingDevice;
+#endif
+
+// A recording of the drawing commands issued to a GraphicsContext for one
+// rectangle of content. The commands are captured in content coordinates at
+// a fixed scale, so that replaying them at that same scale produces exactly
+// the pixels that painting the content directly would have produced.
+//
+// Not every port has a recording backend; isSupported() returns false there,
+// create() returns nullptr and callers paint directly instead.
+class DisplayList {
+    WTF_MAKE_NONCOPYABLE(DisplayList); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static bool isSupported();
+    static PassOwnPtr<DisplayList> create(const IntRect& bounds, float scale);
+    ~DisplayList();
+
+    // Returns the context to paint the content of bounds() into. It stays
+    // valid until endRecording() is called.
+    GraphicsContext* beginRecording();
+    void endRecording();
+
+    // Plays the recorded commands back into |context|, which must have the
+    // scale the list was recorded at. Nothing outside |clipRect| is touched.
+    void replay(GraphicsContext*, const IntRect& clipRect);
+
+    // Plays the recorded commands back into |context|, whose origin is the top
+    // left corner of |rect|, in device pixels at the recording scale. Unlike
+    // replay(), this can be called on any thread once recording has ended,
+    // provided canRasterizeOnAnyThread() is true and nothing else paints into
+    // |context| meanwhile.
+    void rasterize(GraphicsContext*, const IntRect& rect);
+
+    // Text is recorded as outlines, which are neither hinted nor antialiased
+    // like glyphs painted directly. A list that painted text is incomplete and
+    // must not be replayed or rasterized; the content is painted directly instead.
+    bool hasText() const { return m_hasText; }
+
+    // Images are recorded as thread-safe copies, except for tiled pixmaps,
+    // which can only be drawn on the main thread.
+    bool canRasterizeOnAnyThread() const { return !m_hasPixmaps; }
+
+    const IntRect& bounds() const { return m_bounds; }
+    float scale() const { return m_scale; }
+    size_t sizeInBytes() const;
+
+    struct Statistics {
+        unsigned recordCount;
+        double recordTime;
+        unsigned replayCount;
+        double replayTime;
+    };
+    static const Statistics& statistics();
+    static void resetStatistics();
+
+private:
+    DisplayList(const IntRect& bounds, float scale);
+
+    static Statistics& mutableStatistics();
+
+    IntRect m_bounds;
+    float m_scale;
+    OwnPtr<GraphicsContext> m_recordingContext;
+    double m_recordingStartTime;
+    bool m_hasText;
+    bool m_hasPixmaps;
+#if PLATFORM(QT)
+    QPicture m_picture;
+    OwnPtr<DisplayListRecordingDevice> m_recordingDevice;
+    OwnPtr<QPainter> m_painter;
+#endif
+};
+
+inline bool DisplayList::isSupported()
+{
+#if PLATFORM(QT)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace WebCore
+
+#endif // DisplayList_h
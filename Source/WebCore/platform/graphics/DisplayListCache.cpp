@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DisplayListCache.h"
+
+#include "GraphicsContext.h"
+
+namespace WebCore {
+
+// Cells are in content coordinates; a cell covers a couple of tiles at the
+// default tile size, which keeps the per-cell overhead low.
+static const int cellSize = 512;
+
+// Recorded commands keep references to the images they draw, so the real cost
+// is higher than what the lists report; stop recording well before that.
+static const size_t maximumSizeInBytes = 4 * 1024 * 1024;
+
+static inline int cellIndex(int coordinate)
+{
+    return coordinate >= 0 ? coordinate / cellSize : (coordinate + 1) / cellSize - 1;
+}
+
+DisplayListCache::DisplayListCache(DisplayListCacheClient* client)
+    : m_client(client)
+    , m_scale(1)
+    , m_sizeInBytes(0)
+{
+}
+
+DisplayListCache::~DisplayListCache()
+{
+}
+
+IntRect DisplayListCache::cellRect(const IntPoint& cell)
+{
+    return IntRect(cell.x() * cellSize, cell.y() * cellSize, cellSize, cellSize);
+}
+
+IntRect DisplayListCache::cellRange(const IntRect& rect)
+{
+    IntPoint first(cellIndex(rect.x()), cellIndex(rect.y()));
+    IntPoint last(cellIndex(rect.maxX() - 1), cellIndex(rect.maxY() - 1));
+    return IntRect(first, IntSize(last.x() - first.x() + 1, last.y() - first.y() + 1));
+}
+
+void DisplayListCache::paint(GraphicsContext* context, const IntRect& rect, float scale)
+{
+    if (rect.isEmpty())
+        return;
+
+    if (!DisplayList::isSupported()) {
+        m_client->paintDisplayListContents(context, rect);
+        return;
+    }
+
+    if (scale != m_scale) {
+        clear();
+        m_scale = scale;
+    }
+
+    IntRect range = cellRange(rect);
+
+    // Paint directly unless every cell can be replayed or recorded, so that
+    // the content is only walked more than once for a single paint when a
+    // cell turns out to have text.
+    bool canUseDisplayLists = true;
+    for (int y = range.y(); y < range.maxY(); ++y) {
+        for (int x = range.x(); x < range.maxX(); ++x) {
+            IntPoint cell(x, y);
+            if (m_cells.contains(cell))
+                continue;
+            if (m_paintedCells.add(cell).isNewEntry || m_cellsWithText.contains(cell) || m_sizeInBytes >= maximumSizeInBytes)
+                canUseDisplayLists = false;
+        }
+    }
+
+    for (int y = range.y(); y < range.maxY() && canUseDisplayLists; ++y) {
+        for (int x = range.x(); x < range.maxX(); ++x) {
+            IntPoint cell(x, y);
+            if (m_cells.contains(cell))
+                continue;
+            OwnPtr<DisplayList> displayList = DisplayList::create(cellRect(cell), m_scale);
+            m_client->paintDisplayListContents(displayList->beginRecording(), displayList->bounds());
+            displayList->endRecording();
+
+            // Cells with text are painted directly until they are invalidated.
+            if (displayList->hasText()) {
+                m_cellsWithText.add(cell);
+                canUseDisplayLists = false;
+                break;
+            }
+            m_sizeInBytes += displayList->sizeInBytes();
+            m_cells.set(cell, displayList.release());
+        }
+    }
+
+    if (!canUseDisplayLists) {
+        m_client->paintDisplayListContents(context, rect);
+        return;
+    }
+
+    for (int y = range.y(); y < range.maxY(); ++y) {
+        for (int x = range.x(); x < range.maxX(); ++x)
+            m_cells.get(IntPoint(x, y))->replay(context, rect);
+    }
+}
+
+void DisplayListCache::invalidate(const IntRect& rect)
+{
+    if (rect.isEmpty() || (m_cells.isEmpty() && m_paintedCells.isEmpty()))
+        return;
+
+    IntRect range = cellRange(rect);
+    for (int y = range.y(); y < range.maxY(); ++y) {
+        for (int x = range.x(); x < range.maxX(); ++x) {
+            IntPoint cell(x, y);
+            m_paintedCells.remove(cell);
+            m_cellsWithText.remove(cell);
+            OwnPtr<DisplayList> displayList = m_cells.take(cell);
+            if (displayList)
+                m_sizeInBytes -= displayList->sizeInBytes();
+        }
+    }
+}
+
+void DisplayListCache::clear()
+{
+    m_cells.clear();
+    m_paintedCells.clear();
+    m_cellsWithText.clear();
+    m_sizeInBytes = 0;
+}
+
+} // namespace WebCore
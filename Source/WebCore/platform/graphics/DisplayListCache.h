@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DisplayListCache_h
+#define DisplayListCache_h
+
+#include "DisplayList.h"
+#include "IntPointHash.h"
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+
+namespace WebCore {
+
+class DisplayListCacheClient {
+public:
+    virtual void paintDisplayListContents(GraphicsContext*, const IntRect&) = 0;
+
+protected:
+    virtual ~DisplayListCacheClient() { }
+};
+
+// Keeps display lists of the content of a layer, one per fixed-size cell, so
+// that tiles which have to be painted again without the content having changed
+// (after scrolling them back in, or when tiles are recreated) are replayed
+// instead of going through the render tree. Replay is clipped to the painted
+// rect, and only the cells that intersect it are played back.
+//
+// A cell is only recorded the second time it is painted without having been
+// invalidated in between; content that changes every frame is never recorded.
+// Cells that paint text are not kept either, see DisplayList::hasText(), and are
+// painted directly until they are invalidated. Text is not recorded in any form,
+// so the cache only helps layers without text, such as images, backgrounds,
+// borders and SVG graphics; layers of ordinary page content end up painted
+// directly after one recording per cell.
+class DisplayListCache {
+    WTF_MAKE_NONCOPYABLE(DisplayListCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit DisplayListCache(DisplayListCacheClient*);
+    ~DisplayListCache();
+
+    // Paints |rect| of the content into |context|, which is scaled by |scale|.
+    void paint(GraphicsContext*, const IntRect&, float scale);
+
+    void invalidate(const IntRect&);
+    void clear();
+
+    size_t sizeInBytes() const { return m_sizeInBytes; }
+
+private:
+    static IntRect cellRect(const IntPoint& cell);
+    static IntRect cellRange(const IntRect&);
+
+    DisplayListCacheClient* m_client;
+    HashMap<IntPoint, OwnPtr<DisplayList> > m_cells;
+    HashSet<IntPoint> m_paintedCells;
+    HashSet<IntPoint> m_cellsWithText;
+    float m_scale;
+    size_t m_sizeInBytes;
+};
+
+} // namespace WebCore
+
+#endif // DisplayListCache_h
@@ -302,6 +302,7 @@ private:
 
 #if PLATFORM(QT)
     void initFormatForTextLayout(QTextLayout*, const TextRun&) const;
+    friend class ShapedText;
 #endif
 
     static TypesettingFeatures s_defaultTypesettingFeatures;
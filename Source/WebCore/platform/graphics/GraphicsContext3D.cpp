@@ -35,6 +35,7 @@
 #include "Image.h"
 #include "ImageData.h"
 #include "ImageObserver.h"
+#include "PixelConversions.h"
 
 #if HAVE(ARM_NEON_INTRINSICS)
 #include "GraphicsContext3DNEON.h"
@@ -759,35 +760,12 @@ template<> ALWAYS_INLINE void pack<GraphicsContext3D::DataFormatRGBA8, GraphicsC
 
 template<> ALWAYS_INLINE void pack<GraphicsContext3D::DataFormatRGBA8, GraphicsContext3D::AlphaDoPremultiply, uint8_t, uint8_t>(const uint8_t* source, uint8_t* destination, unsigned pixelsPerRow)
 {
-    for (unsigned int i = 0; i < pixelsPerRow; ++i) {
-        float scaleFactor = source[3] / 255.0f;
-        uint8_t sourceR = static_cast<uint8_t>(static_cast<float>(source[0]) * scaleFactor);
-        uint8_t sourceG = static_cast<uint8_t>(static_cast<float>(source[1]) * scaleFactor);
-        uint8_t sourceB = static_cast<uint8_t>(static_cast<float>(source[2]) * scaleFactor);
-        destination[0] = sourceR;
-        destination[1] = sourceG;
-        destination[2] = sourceB;
-        destination[3] = source[3];
-        source += 4;
-        destination += 4;
-    }
+    premultiplyPixels(source, destination, pixelsPerRow);
 }
 
-// FIXME: this routine is lossy and must be removed.
 template<> ALWAYS_INLINE void pack<GraphicsContext3D::DataFormatRGBA8, GraphicsContext3D::AlphaDoUnmultiply, uint8_t, uint8_t>(const uint8_t* source, uint8_t* destination, unsigned pixelsPerRow)
 {
-    for (unsigned int i = 0; i < pixelsPerRow; ++i) {
-        float scaleFactor = source[3] ? 255.0f / source[3] : 1.0f;
-        uint8_t sourceR = static_cast<uint8_t>(static_cast<float>(source[0]) * scaleFactor);
-        uint8_t sourceG = static_cast<uint8_t>(static_cast<float>(source[1]) * scaleFactor);
-        uint8_t sourceB = static_cast<uint8_t>(static_cast<float>(source[2]) * scaleFactor);
-        destination[0] = sourceR;
-        destination[1] = sourceG;
-        destination[2] = sourceB;
-        destination[3] = source[3];
-        source += 4;
-        destination += 4;
-    }
+    unpremultiplyPixels(source, destination, pixelsPerRow);
 }
 
 template<> ALWAYS_INLINE void pack<GraphicsContext3D::DataFormatRGBA4444, GraphicsContext3D::AlphaDoNothing, uint8_t, uint16_t>(const uint8_t* source, uint16_t* destination, unsigned pixelsPerRow)
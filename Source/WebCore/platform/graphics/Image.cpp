@@ -170,7 +170,7 @@ void Image::drawTiled(GraphicsContext* ctxt, const FloatRect& dstRect, const Flo
     startAnimation();
 }
 
-#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING) || USE(SCALED_IMAGE_DECODING)
 FloatRect Image::adjustSourceRectForDownSampling(const FloatRect& srcRect, const IntSize& scaledSize) const
 {
     const IntSize unscaledSize = size();
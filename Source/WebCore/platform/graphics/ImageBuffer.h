@@ -47,6 +47,8 @@
 #include <wtf/Vector.h>
 
 #if PLATFORM(QT)
+#include <QImage>
+
 QT_BEGIN_NAMESPACE
 class QOpenGLContext;
 QT_END_NAMESPACE
@@ -117,6 +119,13 @@ namespace WebCore {
         void putByteArray(Multiply multiplied, Uint8ClampedArray*, const IntSize& sourceSize, const IntRect& sourceRect, const IntPoint& destPoint, CoordinateSystem = LogicalCoordinateSystem);
         
         void convertToLuminanceMask();
+
+#if PLATFORM(QT)
+        // The pixels, not shared with the buffer, which keeps drawing. Unlike
+        // the images returned by copyImage(), the result may be handed over
+        // to another thread.
+        QImage toQImage() const;
+#endif
         
         String toDataURL(const String& mimeType, const double* quality = 0, CoordinateSystem = LogicalCoordinateSystem) const;
 #if !USE(CG)
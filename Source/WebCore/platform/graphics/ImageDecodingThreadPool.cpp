@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ImageDecodingThreadPool.h"
+
+#if USE(ASYNC_IMAGE_DECODING)
+
+#include "BackgroundThreadPool.h"
+#include "BitmapImage.h"
+#include "ImageDecoder.h"
+#include "SharedBuffer.h"
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+AsyncImageDecodingTask::AsyncImageDecodingTask(BitmapImage* image, PassOwnPtr<ImageDecoder> decoder, PassRefPtr<SharedBuffer> data)
+    : m_image(image)
+    , m_data(data)
+    , m_decoder(decoder)
+    , m_state(Queued)
+    , m_cancelled(false)
+{
+    ASSERT(isMainThread());
+    ASSERT(m_decoder);
+}
+
+AsyncImageDecodingTask::~AsyncImageDecodingTask()
+{
+    ASSERT(!m_image);
+}
+
+void AsyncImageDecodingTask::start()
+{
+    ASSERT(isMainThread());
+
+    // The reference is adopted again in didFinishTask(), back on the main thread.
+    ref();
+    BackgroundThreadPool::shared().dispatch(bind(&AsyncImageDecodingTask::performTask, this));
+}
+
+void AsyncImageDecodingTask::cancel()
+{
+    ASSERT(isMainThread());
+    m_image = 0;
+
+    MutexLocker locker(m_mutex);
+    m_cancelled = true;
+}
+
+PassOwnPtr<ImageDecoder> AsyncImageDecodingTask::takeDecoder()
+{
+    ASSERT(isMainThread());
+    m_image = 0;
+
+    MutexLocker locker(m_mutex);
+    if (m_state == Queued) {
+        // Decoding here is no slower than waiting for a thread to pick the task up.
+        m_cancelled = true;
+        return nullptr;
+    }
+
+    while (m_state != Finished)
+        m_condition.wait(m_mutex);
+    return m_decoder.release();
+}
+
+void AsyncImageDecodingTask::performTask(AsyncImageDecodingTask* task)
+{
+    task->decode();
+    callOnMainThread(didFinishTask, task);
+}
+
+void AsyncImageDecodingTask::decode()
+{
+    ASSERT(!isMainThread());
+    {
+        MutexLocker locker(m_mutex);
+        if (m_cancelled) {
+            m_state = Finished;
+            return;
+        }
+        m_state = Decoding;
+    }
+
+    m_decoder->setData(m_data.get(), true);
+    m_decoder->frameBufferAtIndex(0);
+
+    MutexLocker locker(m_mutex);
+    m_state = Finished;
+    m_condition.signal();
+}
+
+void AsyncImageDecodingTask::didFinishTask(void* context)
+{
+    // Adopts the reference taken by start().
+    RefPtr<AsyncImageDecodingTask> task = adoptRef(static_cast<AsyncImageDecodingTask*>(context));
+    task->didFinish();
+}
+
+void AsyncImageDecodingTask::didFinish()
+{
+    ASSERT(isMainThread());
+
+    // The decoder keeps a reference to the data; drop ours here so that the
+    // last dereference never races with the decoding thread.
+    m_data = 0;
+
+    BitmapImage* image = m_image;
+    if (!image) {
+        m_decoder.clear();
+        return;
+    }
+
+    m_image = 0;
+    image->didFinishAsyncDecoding(m_decoder.release());
+}
+
+// Frame buffers kept around for reuse; a running animation only ever needs a couple.
+static const size_t maximumRecycledFrames = 2;
+
+AnimationFrameDecoder::AnimationFrameDecoder(BitmapImage* image, PassOwnPtr<ImageDecoder> decoder, PassRefPtr<SharedBuffer> data, ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
+    : m_image(image)
+    , m_isDecoding(false)
+    , m_data(data)
+    , m_decoder(decoder)
+    , m_alphaOption(alphaOption)
+    , m_gammaAndColorProfileOption(gammaAndColorProfileOption)
+    , m_nextFrameToDecode(0)
+    , m_requestedIndex(0)
+    , m_requestedCount(0)
+    , m_frameCount(0)
+    , m_cancelled(false)
+{
+    ASSERT(isMainThread());
+    ASSERT(m_decoder);
+    m_decoder->setData(m_data.get(), true);
+}
+
+AnimationFrameDecoder::~AnimationFrameDecoder()
+{
+    ASSERT(!m_image);
+}
+
+void AnimationFrameDecoder::decodeFrames(size_t index, size_t count, size_t frameCount)
+{
+    ASSERT(isMainThread());
+    ASSERT(index < frameCount);
+    if (m_isDecoding || !count)
+        return;
+
+    m_isDecoding = true;
+    m_requestedIndex = index;
+    m_requestedCount = std::min(count, frameCount);
+    m_frameCount = frameCount;
+    BackgroundThreadPool::shared().dispatch(bind(&AnimationFrameDecoder::decode, this));
+}
+
+void AnimationFrameDecoder::cancel()
+{
+    ASSERT(isMainThread());
+    m_image = 0;
+
+    MutexLocker locker(m_mutex);
+    m_cancelled = true;
+}
+
+void AnimationFrameDecoder::decode()
+{
+    ASSERT(!isMainThread());
+
+    for (size_t i = 0; i < m_requestedCount; ++i) {
+        if (!decodeFrame((m_requestedIndex + i) % m_frameCount))
+            break;
+        callOnMainThread(bind(&AnimationFrameDecoder::didDecodeFrames, this, false));
+    }
+    callOnMainThread(bind(&AnimationFrameDecoder::didDecodeFrames, this, true));
+}
+
+bool AnimationFrameDecoder::decodeFrame(size_t index)
+{
+    ASSERT(!isMainThread());
+    {
+        MutexLocker locker(m_mutex);
+        if (m_cancelled)
+            return false;
+    }
+
+    // The decoder can only move forward; start over to go back to an earlier
+    // frame. Only WebCore's own decoders may be created on this thread.
+    if (!m_decoder || index < m_nextFrameToDecode) {
+        m_decoder = adoptPtr(ImageDecoder::createForDecodingThread(*m_data, m_alphaOption, m_gammaAndColorProfileOption));
+        m_nextFrameToDecode = 0;
+        if (!m_decoder)
+            return false;
+        m_decoder->setData(m_data.get(), true);
+    }
+
+    ImageFrame* frame = m_decoder->frameBufferAtIndex(index);
+    if (!frame || frame->status() != ImageFrame::FrameComplete)
+        return false;
+    m_nextFrameToDecode = index + 1;
+
+    OwnPtr<ImageFrame> decodedFrame;
+    {
+        MutexLocker locker(m_mutex);
+        if (!m_recycledFrames.isEmpty()) {
+            decodedFrame = m_recycledFrames.last().release();
+            m_recycledFrames.removeLast();
+        }
+    }
+    if (!decodedFrame)
+        decodedFrame = adoptPtr(new ImageFrame);
+
+    // Reuses the pixel storage of a recycled frame, which has the same size.
+    *decodedFrame = *frame;
+
+    // Keep only what the next frame is built from.
+    m_decoder->clearFrameBufferCache(index + 1);
+
+    MutexLocker locker(m_mutex);
+    m_decodedFrameIndices.append(index);
+    m_decodedFrames.append(decodedFrame.release());
+    return true;
+}
+
+void AnimationFrameDecoder::didDecodeFrames(bool finished)
+{
+    ASSERT(isMainThread());
+
+    Vector<size_t> indices;
+    Vector<OwnPtr<ImageFrame> > frames;
+    {
+        MutexLocker locker(m_mutex);
+        indices.swap(m_decodedFrameIndices);
+        frames.swap(m_decodedFrames);
+    }
+    if (finished)
+        m_isDecoding = false;
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (m_image)
+            m_image->cacheDecodedAnimationFrame(indices[i], *frames[i]);
+
+        MutexLocker locker(m_mutex);
+        if (m_recycledFrames.size() < maximumRecycledFrames)
+            m_recycledFrames.append(frames[i].release());
+    }
+
+    if (m_image)
+        m_image->didDecodeAnimationFrames();
+}
+
+} // namespace WebCore
+
+#endif // USE(ASYNC_IMAGE_DECODING)
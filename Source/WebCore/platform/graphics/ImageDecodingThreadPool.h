@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ImageDecodingThreadPool_h
+#define ImageDecodingThreadPool_h
+
+#if USE(ASYNC_IMAGE_DECODING)
+
+#include "ImageSource.h"
+#include <wtf/Functional.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class BitmapImage;
+class ImageDecoder;
+class ImageFrame;
+class SharedBuffer;
+
+// Decodes the first frame of an image on the BackgroundThreadPool. The task
+// owns a SharedBuffer::copy() of the encoded data, which only shares the bytes,
+// and a decoder from ImageDecoder::createForDecodingThread(), so nothing in it
+// is used by the main thread while the decode is running. Once done, the decoder (with the
+// decoded frame cached in it) is handed back to the BitmapImage on the main
+// thread, unless the image cancelled the task.
+class AsyncImageDecodingTask : public ThreadSafeRefCounted<AsyncImageDecodingTask> {
+public:
+    static PassRefPtr<AsyncImageDecodingTask> create(BitmapImage* image, PassOwnPtr<ImageDecoder> decoder, PassRefPtr<SharedBuffer> data)
+    {
+        return adoptRef(new AsyncImageDecodingTask(image, decoder, data));
+    }
+    ~AsyncImageDecodingTask();
+
+    // Called on the main thread. Queues the decode on the BackgroundThreadPool.
+    void start();
+
+    // Called on the main thread. The image will not hear back from the task.
+    void cancel();
+
+    // Called on the main thread by an image that needs the frame right away for
+    // something else than painting, which skips the image meanwhile.
+    // Waits for a decode that is already running and returns its decoder. A
+    // decode that has not started yet is cancelled instead, and 0 is returned
+    // so that the image decodes synchronously. Either way the image will not
+    // hear back from the task.
+    PassOwnPtr<ImageDecoder> takeDecoder();
+
+private:
+    AsyncImageDecodingTask(BitmapImage*, PassOwnPtr<ImageDecoder>, PassRefPtr<SharedBuffer>);
+
+    // Called on a decoding thread.
+    static void performTask(AsyncImageDecodingTask*);
+    void decode();
+
+    // Called on the main thread.
+    static void didFinishTask(void*);
+    void didFinish();
+
+    enum State { Queued, Decoding, Finished };
+
+    BitmapImage* m_image; // Only accessed on the main thread.
+    RefPtr<SharedBuffer> m_data;
+    OwnPtr<ImageDecoder> m_decoder;
+
+    Mutex m_mutex; // Guards the members below.
+    ThreadCondition m_condition;
+    State m_state;
+    bool m_cancelled;
+};
+
+// Decodes the frames of an animation ahead of the one being shown. Frames of
+// an animation are built on top of each other, so the decoder, again working on
+// its own SharedBuffer::copy() of the data, lives as long as the animation does and decodes the
+// frames in order, going back to the first frame only after the last one.
+// Decoded pixels are copied out into spare ImageFrames, which the main thread
+// hands back once it has turned them into native images, so that running
+// animations don't reallocate a frame buffer for every frame they show.
+class AnimationFrameDecoder : public ThreadSafeRefCounted<AnimationFrameDecoder> {
+public:
+    // |decoder| comes from ImageDecoder::createForDecodingThread(), like the
+    // decoders the animation starts over with later.
+    static PassRefPtr<AnimationFrameDecoder> create(BitmapImage* image, PassOwnPtr<ImageDecoder> decoder, PassRefPtr<SharedBuffer> data, ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
+    {
+        return adoptRef(new AnimationFrameDecoder(image, decoder, data, alphaOption, gammaAndColorProfileOption));
+    }
+    ~AnimationFrameDecoder();
+
+    // Called on the main thread. Decodes |count| frames starting at |index|,
+    // wrapping around after the last of the |frameCount| frames. Each frame is
+    // passed to BitmapImage::cacheDecodedAnimationFrame() as soon as it's done.
+    void decodeFrames(size_t index, size_t count, size_t frameCount);
+    bool isDecoding() const { return m_isDecoding; }
+
+    // Called on the main thread. The image will not hear back from the decoder.
+    void cancel();
+
+private:
+    AnimationFrameDecoder(BitmapImage*, PassOwnPtr<ImageDecoder>, PassRefPtr<SharedBuffer>, ImageSource::AlphaOption, ImageSource::GammaAndColorProfileOption);
+
+    // Called on a decoding thread.
+    void decode();
+    bool decodeFrame(size_t index);
+
+    // Called on the main thread.
+    void didDecodeFrames(bool finished);
+
+    BitmapImage* m_image; // Only accessed on the main thread.
+    bool m_isDecoding; // Only accessed on the main thread.
+
+    // Only accessed on the decoding thread while a request is running.
+    RefPtr<SharedBuffer> m_data;
+    OwnPtr<ImageDecoder> m_decoder;
+    ImageSource::AlphaOption m_alphaOption;
+    ImageSource::GammaAndColorProfileOption m_gammaAndColorProfileOption;
+    size_t m_nextFrameToDecode;
+    size_t m_requestedIndex;
+    size_t m_requestedCount;
+    size_t m_frameCount;
+
+    Mutex m_mutex; // Guards the members below.
+    Vector<size_t> m_decodedFrameIndices;
+    Vector<OwnPtr<ImageFrame> > m_decodedFrames;
+    Vector<OwnPtr<ImageFrame> > m_recycledFrames;
+    bool m_cancelled;
+};
+
+} // namespace WebCore
+
+#endif // USE(ASYNC_IMAGE_DECODING)
+
+#endif // ImageDecodingThreadPool_h
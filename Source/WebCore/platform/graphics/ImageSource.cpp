@@ -44,6 +44,9 @@ ImageSource::ImageSource(ImageSource::AlphaOption alphaOption, ImageSource::Gamm
     : m_decoder(0)
     , m_alphaOption(alphaOption)
     , m_gammaAndColorProfileOption(gammaAndColorProfileOption)
+#if USE(SCALED_IMAGE_DECODING)
+    , m_maxDecodedPixels(0)
+#endif
 {
 }
 
@@ -82,6 +85,10 @@ void ImageSource::setData(SharedBuffer* data, bool allDataReceived)
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
         if (m_decoder && s_maxPixelsPerDecodedImage)
             m_decoder->setMaxNumPixels(s_maxPixelsPerDecodedImage);
+#endif
+#if USE(SCALED_IMAGE_DECODING)
+        if (m_decoder && m_maxDecodedPixels)
+            m_decoder->setMaxNumPixels(m_maxDecodedPixels);
 #endif
     }
 
@@ -89,6 +96,14 @@ void ImageSource::setData(SharedBuffer* data, bool allDataReceived)
         m_decoder->setData(data, allDataReceived);
 }
 
+#if USE(ASYNC_IMAGE_DECODING)
+void ImageSource::setDecoder(PassOwnPtr<ImageDecoder> decoder)
+{
+    delete m_decoder;
+    m_decoder = decoder.leakPtr();
+}
+#endif
+
 String ImageSource::filenameExtension() const
 {
     return m_decoder ? m_decoder->filenameExtension() : String();
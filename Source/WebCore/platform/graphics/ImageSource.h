@@ -156,6 +156,23 @@ public:
     // decoded then return 0.
     unsigned frameBytesAtIndex(size_t) const;
 
+#if USE(ASYNC_IMAGE_DECODING)
+    AlphaOption alphaOption() const { return m_alphaOption; }
+    GammaAndColorProfileOption gammaAndColorProfileOption() const { return m_gammaAndColorProfileOption; }
+
+    // Replaces the decoder with one that has already decoded frames elsewhere,
+    // e.g. on a background thread.
+    void setDecoder(PassOwnPtr<ImageDecoder>);
+#endif
+
+#if USE(SCALED_IMAGE_DECODING)
+    // Lets the decoder produce frames of at most |maxPixels| pixels instead of
+    // the intrinsic size; zero means no limit. Takes effect the next time the
+    // decoder is created, i.e. after clear(true).
+    unsigned maxDecodedPixels() const { return m_maxDecodedPixels; }
+    void setMaxDecodedPixels(unsigned maxPixels) { m_maxDecodedPixels = maxPixels; }
+#endif
+
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
     static unsigned maxPixelsPerDecodedImage() { return s_maxPixelsPerDecodedImage; }
     static void setMaxPixelsPerDecodedImage(unsigned maxPixels) { s_maxPixelsPerDecodedImage = maxPixels; }
@@ -171,6 +188,9 @@ private:
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
     static unsigned s_maxPixelsPerDecodedImage;
 #endif
+#if USE(SCALED_IMAGE_DECODING)
+    unsigned m_maxDecodedPixels;
+#endif
 };
 
 }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PaintCacheBudget_h
+#define PaintCacheBudget_h
+
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+
+// Accounts for the memory that objects keep from one paint to the next, such
+// as filter results or bitmaps of content, and evicts the least recently used
+// objects when they add up to more than the budget. Evicting an object calls
+// the function the budget was created with, which releases what the object keeps.
+template<typename T> class PaintCacheBudget {
+    WTF_MAKE_NONCOPYABLE(PaintCacheBudget);
+public:
+    typedef void (*EvictFunction)(T*);
+
+    PaintCacheBudget(size_t maximumSizeInBytes, EvictFunction evict)
+        : m_maximumSizeInBytes(maximumSizeInBytes)
+        , m_sizeInBytes(0)
+        , m_evict(evict)
+    {
+    }
+
+    size_t maximumSizeInBytes() const { return m_maximumSizeInBytes; }
+    size_t sizeInBytes() const { return m_sizeInBytes; }
+
+    // Called after |object| has been painted keeping |sizeInBytes|, which makes
+    // it the most recently used object. The object used last is kept even if
+    // it is over the budget on its own.
+    void didUse(T* object, size_t sizeInBytes)
+    {
+        typename HashMap<T*, size_t>::AddResult result = m_sizes.add(object, sizeInBytes);
+        if (!result.isNewEntry) {
+            m_sizeInBytes -= result.iterator->value;
+            result.iterator->value = sizeInBytes;
+        }
+        m_sizeInBytes += sizeInBytes;
+        m_objects.appendOrMoveToLast(object);
+
+        while (m_sizeInBytes > m_maximumSizeInBytes && m_objects.size() > 1)
+            evict(m_objects.first());
+    }
+
+    // Stops accounting for |object| without evicting it.
+    void remove(T* object)
+    {
+        typename HashMap<T*, size_t>::iterator it = m_sizes.find(object);
+        if (it == m_sizes.end())
+            return;
+
+        m_sizeInBytes -= it->value;
+        m_sizes.remove(it);
+        m_objects.remove(object);
+    }
+
+    void evictAll()
+    {
+        while (!m_objects.isEmpty())
+            evict(m_objects.first());
+        ASSERT(!m_sizeInBytes);
+    }
+
+private:
+    void evict(T* object)
+    {
+        remove(object);
+        m_evict(object);
+    }
+
+    size_t m_maximumSizeInBytes;
+    size_t m_sizeInBytes;
+    EvictFunction m_evict;
+    ListHashSet<T*> m_objects;
+    HashMap<T*, size_t> m_sizes;
+};
+
+} // namespace WebCore
+
+#endif // PaintCacheBudget_h
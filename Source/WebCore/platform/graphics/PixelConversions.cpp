@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "PixelConversions.h"
+
+#if HAVE(ARM_NEON_INTRINSICS)
+#include "PixelConversionsNEON.h"
+#elif defined(__SSE2__)
+#include "PixelConversionsSSE2.h"
+#endif
+
+namespace WebCore {
+
+// The vectorized versions in PixelConversionsNEON.h and PixelConversionsSSE2.h
+// convert all but the last few pixels and must produce the same results.
+
+static inline uint8_t premultiplyChannel(unsigned channel, unsigned alpha)
+{
+    // Exactly round(channel * alpha / 255) for 8-bit values, without a division.
+    unsigned product = channel * alpha + 128;
+    return (product + (product >> 8)) >> 8;
+}
+
+static inline uint8_t unpremultiplyChannel(unsigned channel, unsigned alpha)
+{
+    // Invalid premultiplied colors, brighter than their alpha, saturate.
+    unsigned value = (channel * 255 + alpha / 2) / alpha;
+    return value < 255 ? value : 255;
+}
+
+void premultiplyPixels(const uint8_t* source, uint8_t* destination, unsigned pixelCount, PixelChannelOrder order)
+{
+#if HAVE(ARM_NEON_INTRINSICS) || defined(__SSE2__)
+    SIMD::premultiplyPixels(source, destination, pixelCount, order);
+#endif
+
+    const unsigned red = order == SwapRedAndBlue ? 2 : 0;
+    const unsigned blue = 2 - red;
+    for (unsigned i = 0; i < pixelCount; ++i) {
+        unsigned alpha = source[3];
+        uint8_t channel0 = premultiplyChannel(source[red], alpha);
+        uint8_t channel1 = premultiplyChannel(source[1], alpha);
+        uint8_t channel2 = premultiplyChannel(source[blue], alpha);
+        destination[0] = channel0;
+        destination[1] = channel1;
+        destination[2] = channel2;
+        destination[3] = alpha;
+        source += 4;
+        destination += 4;
+    }
+}
+
+void unpremultiplyPixels(const uint8_t* source, uint8_t* destination, unsigned pixelCount, PixelChannelOrder order)
+{
+#if HAVE(ARM_NEON_INTRINSICS) || defined(__SSE2__)
+    SIMD::unpremultiplyPixels(source, destination, pixelCount, order);
+#endif
+
+    const unsigned red = order == SwapRedAndBlue ? 2 : 0;
+    const unsigned blue = 2 - red;
+    for (unsigned i = 0; i < pixelCount; ++i) {
+        unsigned alpha = source[3];
+        if (alpha) {
+            uint8_t channel0 = unpremultiplyChannel(source[red], alpha);
+            uint8_t channel1 = unpremultiplyChannel(source[1], alpha);
+            uint8_t channel2 = unpremultiplyChannel(source[blue], alpha);
+            destination[0] = channel0;
+            destination[1] = channel1;
+            destination[2] = channel2;
+            destination[3] = alpha;
+        } else
+            destination[0] = destination[1] = destination[2] = destination[3] = 0;
+        source += 4;
+        destination += 4;
+    }
+}
+
+} // namespace WebCore
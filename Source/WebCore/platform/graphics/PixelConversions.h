@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PixelConversions_h
+#define PixelConversions_h
+
+#include <stdint.h>
+
+namespace WebCore {
+
+// The conversions below work on pixels of four 8-bit channels with alpha last,
+// i.e. RGBA or BGRA in memory. SwapRedAndBlue converts from one order to the
+// other on the way. Source and destination may be the same buffer.
+enum PixelChannelOrder {
+    KeepChannelOrder,
+    SwapRedAndBlue
+};
+
+// Each color channel becomes round(channel * alpha / 255).
+void premultiplyPixels(const uint8_t* source, uint8_t* destination, unsigned pixelCount, PixelChannelOrder = KeepChannelOrder);
+
+// Each color channel becomes min(255, (channel * 255 + alpha / 2) / alpha),
+// and zero if alpha is zero.
+void unpremultiplyPixels(const uint8_t* source, uint8_t* destination, unsigned pixelCount, PixelChannelOrder = KeepChannelOrder);
+
+} // namespace WebCore
+
+#endif // PixelConversions_h
@@ -39,6 +39,10 @@ public:
 
     virtual bool isDirty() const = 0;
     virtual void invalidate(const IntRect&) = 0;
+    // Called on every dirty tile, closest to the viewport first, before any of
+    // them is asked to update its back buffer. The distance is zero for tiles
+    // in view. Tiles that paint asynchronously start painting here.
+    virtual void scheduleBackBufferUpdate(double /* distanceFromViewport */) { }
     virtual Vector<IntRect> updateBackBuffer() = 0;
     virtual void swapBackBufferToFront() = 0;
     virtual bool isReadyToPaint() const = 0;
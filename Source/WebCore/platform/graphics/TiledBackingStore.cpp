@@ -103,6 +103,11 @@ void TiledBackingStore::invalidate(const IntRect& contentsDirtyRect)
     startTileBufferUpdateTimer();
 }
 
+static bool compareTileDistance(const std::pair<double, RefPtr<Tile> >& a, const std::pair<double, RefPtr<Tile> >& b)
+{
+    return a.first < b.first;
+}
+
 void TiledBackingStore::updateTileBuffers()
 {
     if (m_contentsFrozen)
@@ -111,12 +116,13 @@ void TiledBackingStore::updateTileBuffers()
     m_client->tiledBackingStorePaintBegin();
 
     Vector<IntRect> paintedArea;
-    Vector<RefPtr<Tile> > dirtyTiles;
+    Vector<std::pair<double, RefPtr<Tile> > > dirtyTiles;
+    IntRect visibleRect = this->visibleRect();
     TileMap::iterator end = m_tiles.end();
     for (TileMap::iterator it = m_tiles.begin(); it != end; ++it) {
         if (!it->value->isDirty())
             continue;
-        dirtyTiles.append(it->value);
+        dirtyTiles.append(std::make_pair(tileDistance(visibleRect, it->key), it->value));
     }
 
     if (dirtyTiles.isEmpty()) {
@@ -124,14 +130,16 @@ void TiledBackingStore::updateTileBuffers()
         return;
     }
 
-    // FIXME: In single threaded case, tile back buffers could be updated asynchronously 
-    // one by one and then swapped to front in one go. This would minimize the time spent
-    // blocking on tile updates.
+    // Tiles painting asynchronously all get started before the first one is waited on.
+    std::sort(dirtyTiles.begin(), dirtyTiles.end(), compareTileDistance);
     unsigned size = dirtyTiles.size();
+    for (unsigned n = 0; n < size; ++n)
+        dirtyTiles[n].second->scheduleBackBufferUpdate(dirtyTiles[n].first);
+
     for (unsigned n = 0; n < size; ++n) {
-        Vector<IntRect> paintedRects = dirtyTiles[n]->updateBackBuffer();
+        Vector<IntRect> paintedRects = dirtyTiles[n].second->updateBackBuffer();
         paintedArea.appendVector(paintedRects);
-        dirtyTiles[n]->swapBackBufferToFront();
+        dirtyTiles[n].second->swapBackBufferToFront();
     }
 
     m_client->tiledBackingStorePaintEnd(paintedArea);
@@ -78,6 +78,7 @@ public:
     bool visibleAreaIsCovered() const;
     void removeAllNonVisibleTiles();
 
+    bool supportsAlpha() const { return m_supportsAlpha; }
     void setSupportsAlpha(bool);
 
 private:
@@ -43,6 +43,7 @@ BitmapImage::BitmapImage(PassRefPtr<cairo_surface_t> nativeImage, ImageObserver*
     , m_repetitionCountStatus(Unknown)
     , m_repetitionsComplete(0)
     , m_decodedSize(0)
+    , m_frameCacheBytes(0)
     , m_frameCount(1)
     , m_isSolidColor(false)
     , m_checkedForSolidColor(false)
@@ -72,6 +72,7 @@ BitmapImage::BitmapImage(CGImageRef cgImage, ImageObserver* observer)
     , m_repetitionCountStatus(Unknown)
     , m_repetitionsComplete(0)
     , m_decodedSize(0)
+    , m_frameCacheBytes(0)
     , m_decodedPropertiesSize(0)
     , m_frameCount(1)
     , m_isSolidColor(false)
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PixelConversionsNEON_h
+#define PixelConversionsNEON_h
+
+#if HAVE(ARM_NEON_INTRINSICS)
+
+#include "PixelConversions.h"
+#include <arm_neon.h>
+
+namespace WebCore {
+
+namespace SIMD {
+
+// Each function converts eight pixels at a time, advances the pointers, and
+// leaves the number of pixels that are left over in |pixelCount|.
+
+ALWAYS_INLINE uint8x8_t premultiplyChannel(uint8x8_t channel, uint8x8_t alpha)
+{
+    // (product + (product >> 8)) >> 8, with product = channel * alpha + 128.
+    uint16x8_t product = vaddq_u16(vmull_u8(channel, alpha), vdupq_n_u16(128));
+    return vshrn_n_u16(vaddq_u16(product, vshrq_n_u16(product, 8)), 8);
+}
+
+ALWAYS_INLINE float32x4_t reciprocal(uint32x4_t value)
+{
+    // The estimate and two Newton-Raphson steps are accurate enough for
+    // divide() to be off by at most one before its correction.
+    float32x4_t floatValue = vcvtq_f32_u32(value);
+    float32x4_t result = vrecpeq_f32(floatValue);
+    result = vmulq_f32(vrecpsq_f32(floatValue, result), result);
+    return vmulq_f32(vrecpsq_f32(floatValue, result), result);
+}
+
+ALWAYS_INLINE uint32x4_t divide(uint32x4_t numerator, uint32x4_t denominator, float32x4_t reciprocalOfDenominator)
+{
+    uint32x4_t quotient = vcvtq_u32_f32(vmulq_f32(vcvtq_f32_u32(numerator), reciprocalOfDenominator));
+
+    // Comparison results are all ones, i.e. minus one, where true.
+    uint32x4_t product = vmulq_u32(quotient, denominator);
+    quotient = vaddq_u32(quotient, vcgtq_u32(product, numerator));
+    quotient = vsubq_u32(quotient, vcleq_u32(vaddq_u32(product, denominator), numerator));
+
+    // Zero where the denominator is zero.
+    return vandq_u32(quotient, vtstq_u32(denominator, denominator));
+}
+
+ALWAYS_INLINE uint8x8_t unpremultiplyChannel(uint8x8_t channel, uint32x4_t alphaLow, uint32x4_t alphaHigh, float32x4_t reciprocalLow, float32x4_t reciprocalHigh)
+{
+    // (channel * 255 + alpha / 2) / alpha, saturated to 255 when narrowed.
+    uint16x8_t wideChannel = vmovl_u8(channel);
+    uint32x4_t numeratorLow = vmlaq_n_u32(vshrq_n_u32(alphaLow, 1), vmovl_u16(vget_low_u16(wideChannel)), 255);
+    uint32x4_t numeratorHigh = vmlaq_n_u32(vshrq_n_u32(alphaHigh, 1), vmovl_u16(vget_high_u16(wideChannel)), 255);
+    uint16x4_t quotientLow = vqmovn_u32(divide(numeratorLow, alphaLow, reciprocalLow));
+    uint16x4_t quotientHigh = vqmovn_u32(divide(numeratorHigh, alphaHigh, reciprocalHigh));
+    return vqmovn_u16(vcombine_u16(quotientLow, quotientHigh));
+}
+
+ALWAYS_INLINE void premultiplyPixels(const uint8_t*& source, uint8_t*& destination, unsigned& pixelCount, PixelChannelOrder order)
+{
+    const unsigned red = order == SwapRedAndBlue ? 2 : 0;
+    const unsigned blue = 2 - red;
+    for (; pixelCount >= 8; pixelCount -= 8, source += 32, destination += 32) {
+        uint8x8x4_t pixels = vld4_u8(source);
+        uint8x8x4_t result;
+        result.val[0] = premultiplyChannel(pixels.val[red], pixels.val[3]);
+        result.val[1] = premultiplyChannel(pixels.val[1], pixels.val[3]);
+        result.val[2] = premultiplyChannel(pixels.val[blue], pixels.val[3]);
+        result.val[3] = pixels.val[3];
+        vst4_u8(destination, result);
+    }
+}
+
+ALWAYS_INLINE void unpremultiplyPixels(const uint8_t*& source, uint8_t*& destination, unsigned& pixelCount, PixelChannelOrder order)
+{
+    const unsigned red = order == SwapRedAndBlue ? 2 : 0;
+    const unsigned blue = 2 - red;
+    for (; pixelCount >= 8; pixelCount -= 8, source += 32, destination += 32) {
+        uint8x8x4_t pixels = vld4_u8(source);
+        uint16x8_t alpha = vmovl_u8(pixels.val[3]);
+        uint32x4_t alphaLow = vmovl_u16(vget_low_u16(alpha));
+        uint32x4_t alphaHigh = vmovl_u16(vget_high_u16(alpha));
+        float32x4_t reciprocalLow = reciprocal(alphaLow);
+        float32x4_t reciprocalHigh = reciprocal(alphaHigh);
+
+        uint8x8x4_t result;
+        result.val[0] = unpremultiplyChannel(pixels.val[red], alphaLow, alphaHigh, reciprocalLow, reciprocalHigh);
+        result.val[1] = unpremultiplyChannel(pixels.val[1], alphaLow, alphaHigh, reciprocalLow, reciprocalHigh);
+        result.val[2] = unpremultiplyChannel(pixels.val[blue], alphaLow, alphaHigh, reciprocalLow, reciprocalHigh);
+        result.val[3] = pixels.val[3];
+        vst4_u8(destination, result);
+    }
+}
+
+} // namespace SIMD
+
+} // namespace WebCore
+
+#endif // HAVE(ARM_NEON_INTRINSICS)
+
+#endif // PixelConversionsNEON_h
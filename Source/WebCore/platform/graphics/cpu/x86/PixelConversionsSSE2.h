@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PixelConversionsSSE2_h
+#define PixelConversionsSSE2_h
+
+#if defined(__SSE2__)
+
+#include "PixelConversions.h"
+#include <emmintrin.h>
+
+namespace WebCore {
+
+namespace SIMD {
+
+// Each function converts four pixels at a time, advances the pointers, and
+// leaves the number of pixels that are left over in |pixelCount|.
+
+template<PixelChannelOrder order>
+ALWAYS_INLINE __m128i unpackPixels(__m128i pixels, bool high)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i channels = high ? _mm_unpackhi_epi8(pixels, zero) : _mm_unpacklo_epi8(pixels, zero);
+    if (order == SwapRedAndBlue)
+        channels = _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+    return channels;
+}
+
+// |channels| holds two pixels of 16-bit channels.
+ALWAYS_INLINE __m128i premultiplyTwoPixels(__m128i channels)
+{
+    // The alpha channel is multiplied by 255, which leaves it unchanged.
+    const __m128i colorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(_mm_and_si128(alpha, colorLanes), alphaLanes);
+
+    // (product + (product >> 8)) >> 8, with product = channel * alpha + 128.
+    __m128i product = _mm_add_epi16(_mm_mullo_epi16(channels, alpha), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+}
+
+// |channels| holds one pixel of 32-bit channels.
+ALWAYS_INLINE __m128i unpremultiplyPixel(__m128i channels)
+{
+    const __m128i colorLanes = _mm_set_epi32(0, -1, -1, -1);
+    __m128i alpha = _mm_shuffle_epi32(channels, _MM_SHUFFLE(3, 3, 3, 3));
+
+    // channel * 255 + alpha / 2. The quotient of the single precision division
+    // truncates to the same value as the integer division would for any 8-bit
+    // channel and alpha. Dividing by a zero alpha gives 0x80000000, which
+    // saturates to zero when packed.
+    __m128i numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(channels, 8), channels), _mm_srli_epi32(alpha, 1));
+    __m128i quotient = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(numerator), _mm_cvtepi32_ps(alpha)));
+    return _mm_or_si128(_mm_and_si128(quotient, colorLanes), _mm_andnot_si128(colorLanes, channels));
+}
+
+template<PixelChannelOrder order>
+ALWAYS_INLINE void premultiplyPixels(const uint8_t*& source, uint8_t*& destination, unsigned& pixelCount)
+{
+    for (; pixelCount >= 4; pixelCount -= 4, source += 16, destination += 16) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        __m128i low = premultiplyTwoPixels(unpackPixels<order>(pixels, false));
+        __m128i high = premultiplyTwoPixels(unpackPixels<order>(pixels, true));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_packus_epi16(low, high));
+    }
+}
+
+template<PixelChannelOrder order>
+ALWAYS_INLINE void unpremultiplyPixels(const uint8_t*& source, uint8_t*& destination, unsigned& pixelCount)
+{
+    __m128i zero = _mm_setzero_si128();
+    for (; pixelCount >= 4; pixelCount -= 4, source += 16, destination += 16) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        __m128i low = unpackPixels<order>(pixels, false);
+        __m128i high = unpackPixels<order>(pixels, true);
+        low = _mm_packs_epi32(unpremultiplyPixel(_mm_unpacklo_epi16(low, zero)), unpremultiplyPixel(_mm_unpackhi_epi16(low, zero)));
+        high = _mm_packs_epi32(unpremultiplyPixel(_mm_unpacklo_epi16(high, zero)), unpremultiplyPixel(_mm_unpackhi_epi16(high, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_packus_epi16(low, high));
+    }
+}
+
+ALWAYS_INLINE void premultiplyPixels(const uint8_t*& source, uint8_t*& destination, unsigned& pixelCount, PixelChannelOrder order)
+{
+    if (order == SwapRedAndBlue)
+        premultiplyPixels<SwapRedAndBlue>(source, destination, pixelCount);
+    else
+        premultiplyPixels<KeepChannelOrder>(source, destination, pixelCount);
+}
+
+ALWAYS_INLINE void unpremultiplyPixels(const uint8_t*& source, uint8_t*& destination, unsigned& pixelCount, PixelChannelOrder order)
+{
+    if (order == SwapRedAndBlue)
+        unpremultiplyPixels<SwapRedAndBlue>(source, destination, pixelCount);
+    else
+        unpremultiplyPixels<KeepChannelOrder>(source, destination, pixelCount);
+}
+
+} // namespace SIMD
+
+} // namespace WebCore
+
+#endif // defined(__SSE2__)
+
+#endif // PixelConversionsSSE2_h
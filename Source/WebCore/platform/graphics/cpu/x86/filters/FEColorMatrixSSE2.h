@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEColorMatrixSSE2_h
+#define FEColorMatrixSSE2_h
+
+#if ENABLE(FILTERS) && defined(__SSE2__)
+
+#include "FEColorMatrix.h"
+#include "SSE2Helpers.h"
+
+namespace WebCore {
+
+// Applies the row-major 4x5 |matrix| of feColorMatrix type="matrix" to each
+// unpremultiplied pixel, computing the four output channels at once. Products
+// are summed in the same order as in the scalar matrix(), and the result is
+// clamped and rounded like Uint8ClampedArray::set() does, so the output is
+// identical.
+inline void colorMatrixSSE2(unsigned char* pixels, unsigned pixelArrayLength, const float* matrix)
+{
+    __m128 redColumn = _mm_setr_ps(matrix[0], matrix[5], matrix[10], matrix[15]);
+    __m128 greenColumn = _mm_setr_ps(matrix[1], matrix[6], matrix[11], matrix[16]);
+    __m128 blueColumn = _mm_setr_ps(matrix[2], matrix[7], matrix[12], matrix[17]);
+    __m128 alphaColumn = _mm_setr_ps(matrix[3], matrix[8], matrix[13], matrix[18]);
+    __m128 offset = _mm_setr_ps(matrix[4] * 255, matrix[9] * 255, matrix[14] * 255, matrix[19] * 255);
+    __m128 zero = _mm_setzero_ps();
+    __m128 max255 = _mm_set1_ps(255);
+
+    uint32_t* pixel = reinterpret_cast<uint32_t*>(pixels);
+    uint32_t* endPixel = pixel + (pixelArrayLength >> 2);
+    for (; pixel < endPixel; ++pixel) {
+        __m128 channels = loadRGBA8AsFloat(pixel);
+        __m128 result = _mm_mul_ps(redColumn, _mm_shuffle_ps(channels, channels, _MM_SHUFFLE(0, 0, 0, 0)));
+        result = _mm_add_ps(result, _mm_mul_ps(greenColumn, _mm_shuffle_ps(channels, channels, _MM_SHUFFLE(1, 1, 1, 1))));
+        result = _mm_add_ps(result, _mm_mul_ps(blueColumn, _mm_shuffle_ps(channels, channels, _MM_SHUFFLE(2, 2, 2, 2))));
+        result = _mm_add_ps(result, _mm_mul_ps(alphaColumn, _mm_shuffle_ps(channels, channels, _MM_SHUFFLE(3, 3, 3, 3))));
+        result = _mm_add_ps(result, offset);
+
+        // _mm_max_ps() returns its second operand for NaN, which turns it into zero.
+        result = _mm_min_ps(_mm_max_ps(result, zero), max255);
+        storeIntAsRGBA8(_mm_cvtps_epi32(result), pixel);
+    }
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS) && defined(__SSE2__)
+
+#endif // FEColorMatrixSSE2_h
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FECompositeArithmeticSSE2_h
+#define FECompositeArithmeticSSE2_h
+
+#if ENABLE(FILTERS) && defined(__SSE2__)
+
+#include "FEComposite.h"
+#include <emmintrin.h>
+
+namespace WebCore {
+
+// Computes k1 * i1 * i2 + k2 * i1 + k3 * i2 + k4 for four pixels at a time, in
+// the same order of operations as the scalar computeArithmeticPixels(), which
+// the output is identical to. Returns the number of bytes processed; the few
+// bytes left over are for the caller to handle.
+template <int b1, int b4>
+inline unsigned computeArithmeticPixelsSSE2(unsigned char* source, unsigned char* destination,
+    unsigned pixelArrayLength, float k1, float k2, float k3, float k4)
+{
+    __m128 k1x4 = _mm_set1_ps(k1 / 255.0f);
+    __m128 k2x4 = _mm_set1_ps(k2);
+    __m128 k3x4 = _mm_set1_ps(k3);
+    __m128 k4x4 = _mm_set1_ps(k4 * 255.0f);
+    __m128 zero = _mm_setzero_ps();
+    __m128 max255 = _mm_set1_ps(255);
+    __m128i zeroInt = _mm_setzero_si128();
+
+    unsigned length = pixelArrayLength & ~15;
+    for (unsigned offset = 0; offset < length; offset += 16) {
+        __m128i sourceBytes = _mm_loadu_si128(reinterpret_cast<__m128i*>(source + offset));
+        __m128i destinationBytes = _mm_loadu_si128(reinterpret_cast<__m128i*>(destination + offset));
+        __m128i sourceWords[2] = { _mm_unpacklo_epi8(sourceBytes, zeroInt), _mm_unpackhi_epi8(sourceBytes, zeroInt) };
+        __m128i destinationWords[2] = { _mm_unpacklo_epi8(destinationBytes, zeroInt), _mm_unpackhi_epi8(destinationBytes, zeroInt) };
+
+        __m128i results[4];
+        for (int i = 0; i < 4; ++i) {
+            __m128i sourceInts = (i & 1) ? _mm_unpackhi_epi16(sourceWords[i >> 1], zeroInt) : _mm_unpacklo_epi16(sourceWords[i >> 1], zeroInt);
+            __m128i destinationInts = (i & 1) ? _mm_unpackhi_epi16(destinationWords[i >> 1], zeroInt) : _mm_unpacklo_epi16(destinationWords[i >> 1], zeroInt);
+            __m128 i1 = _mm_cvtepi32_ps(sourceInts);
+            __m128 i2 = _mm_cvtepi32_ps(destinationInts);
+
+            __m128 result = _mm_add_ps(_mm_mul_ps(k2x4, i1), _mm_mul_ps(k3x4, i2));
+            if (b1)
+                result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(k1x4, i1), i2));
+            if (b4)
+                result = _mm_add_ps(result, k4x4);
+
+            // Clamped results are truncated, like the conversion to unsigned char does.
+            results[i] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(result, zero), max255));
+        }
+
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(results[0], results[1]), _mm_packs_epi32(results[2], results[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset), packed);
+    }
+    return length;
+}
+
+inline unsigned platformArithmeticSSE2(unsigned char* source, unsigned char* destination,
+    unsigned pixelArrayLength, float k1, float k2, float k3, float k4)
+{
+    if (!k4) {
+        if (!k1)
+            return computeArithmeticPixelsSSE2<0, 0>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+        return computeArithmeticPixelsSSE2<1, 0>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+    }
+
+    if (!k1)
+        return computeArithmeticPixelsSSE2<0, 1>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+    return computeArithmeticPixelsSSE2<1, 1>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS) && defined(__SSE2__)
+
+#endif // FECompositeArithmeticSSE2_h
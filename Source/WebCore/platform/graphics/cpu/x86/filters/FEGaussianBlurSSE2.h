@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEGaussianBlurSSE2_h
+#define FEGaussianBlurSSE2_h
+
+#if ENABLE(FILTERS) && defined(__SSE2__)
+
+#include "FEGaussianBlur.h"
+#include "SSE2Helpers.h"
+
+namespace WebCore {
+
+// Blurs the four channels of a pixel at once. The channel sums are kept as
+// integers, and truncating their single precision quotient gives the same
+// result as the integer division of boxBlur() for any kernel size up to
+// gMaxKernelSize, so the output is identical.
+inline void boxBlurSSE2(Uint8ClampedArray* srcPixelArray, Uint8ClampedArray* dstPixelArray,
+                        unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int effectHeight)
+{
+    const uint32_t* sourcePixel = reinterpret_cast<uint32_t*>(srcPixelArray->data());
+    uint32_t* destinationPixel = reinterpret_cast<uint32_t*>(dstPixelArray->data());
+
+    __m128 divisor = _mm_set1_ps(dx);
+    int pixelLine = strideLine / 4;
+    int pixelStride = stride / 4;
+
+    for (int y = 0; y < effectHeight; ++y) {
+        int line = y * pixelLine;
+        __m128i sum = _mm_setzero_si128();
+        // Fill the kernel
+        int maxKernelSize = std::min(dxRight, effectWidth);
+        for (int i = 0; i < maxKernelSize; ++i)
+            sum = _mm_add_epi32(sum, loadRGBA8AsInt(sourcePixel + line + i * pixelStride));
+
+        // Blurring
+        for (int x = 0; x < effectWidth; ++x) {
+            int pixelOffset = line + x * pixelStride;
+            storeIntAsRGBA8(_mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(sum), divisor)), destinationPixel + pixelOffset);
+            if (x >= dxLeft)
+                sum = _mm_sub_epi32(sum, loadRGBA8AsInt(sourcePixel + pixelOffset - dxLeft * pixelStride));
+            if (x + dxRight < effectWidth)
+                sum = _mm_add_epi32(sum, loadRGBA8AsInt(sourcePixel + pixelOffset + dxRight * pixelStride));
+        }
+    }
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS) && defined(__SSE2__)
+
+#endif // FEGaussianBlurSSE2_h
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEMorphologySSE2_h
+#define FEMorphologySSE2_h
+
+#if ENABLE(FILTERS) && defined(__SSE2__)
+
+#include "FEMorphology.h"
+#include <emmintrin.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+template<MorphologyOperatorType type>
+ALWAYS_INLINE __m128i morphologyExtrema(__m128i a, __m128i b)
+{
+    return type == FEMORPHOLOGY_OPERATOR_ERODE ? _mm_min_epu8(a, b) : _mm_max_epu8(a, b);
+}
+
+// Follows FEMorphology::platformApplyGeneric() step by step, except that the
+// four channels of a pixel are handled at once, and that the extrema of the
+// kernel are reduced four columns at a time. Taking the minimum or maximum of
+// each byte gives the same values as the scalar comparisons do.
+template<MorphologyOperatorType type>
+inline void morphologySSE2(FEMorphology::PaintingData* paintingData, int yStart, int yEnd)
+{
+    const uint32_t* source = reinterpret_cast<uint32_t*>(paintingData->srcPixelArray->data());
+    uint32_t* destination = reinterpret_cast<uint32_t*>(paintingData->dstPixelArray->data());
+    const int width = paintingData->width;
+    const int height = paintingData->height;
+    const int radiusX = paintingData->radiusX;
+    const int radiusY = paintingData->radiusY;
+
+    Vector<uint32_t> extrema;
+    for (int y = yStart; y < yEnd; ++y) {
+        int extremaStartY = std::max(0, y - radiusY);
+        int extremaEndY = std::min(height - 1, y + radiusY);
+        extrema.clear();
+
+        // Compute extremas for each columns
+        for (int x = 0; x <= radiusX; ++x) {
+            __m128i columnExtrema = _mm_cvtsi32_si128(source[extremaStartY * width + x]);
+            for (int eY = extremaStartY + 1; eY < extremaEndY; ++eY)
+                columnExtrema = morphologyExtrema<type>(columnExtrema, _mm_cvtsi32_si128(source[eY * width + x]));
+            extrema.append(_mm_cvtsi128_si32(columnExtrema));
+        }
+
+        // Kernel is filled, get extrema of next column. Columns leaving the
+        // kernel are skipped over rather than removed from the front.
+        size_t firstColumn = 0;
+        for (int x = 0; x < width; ++x) {
+            const int endX = std::min(x + radiusX, width - 1);
+            __m128i columnExtrema = _mm_cvtsi32_si128(source[extremaStartY * width + endX]);
+            for (int i = extremaStartY + 1; i <= extremaEndY; ++i)
+                columnExtrema = morphologyExtrema<type>(columnExtrema, _mm_cvtsi32_si128(source[i * width + endX]));
+            if (x - radiusX >= 0)
+                ++firstColumn;
+            if (x + radiusX <= width)
+                extrema.append(_mm_cvtsi128_si32(columnExtrema));
+
+            const uint32_t* column = extrema.data() + firstColumn;
+            size_t columnCount = extrema.size() - firstColumn;
+            __m128i entireExtrema = _mm_set1_epi32(column[0]);
+            size_t kernelIndex = 1;
+            for (; kernelIndex + 4 <= columnCount; kernelIndex += 4)
+                entireExtrema = morphologyExtrema<type>(entireExtrema, _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + kernelIndex)));
+            for (; kernelIndex < columnCount; ++kernelIndex)
+                entireExtrema = morphologyExtrema<type>(entireExtrema, _mm_set1_epi32(column[kernelIndex]));
+            entireExtrema = morphologyExtrema<type>(entireExtrema, _mm_shuffle_epi32(entireExtrema, _MM_SHUFFLE(1, 0, 3, 2)));
+            entireExtrema = morphologyExtrema<type>(entireExtrema, _mm_shuffle_epi32(entireExtrema, _MM_SHUFFLE(2, 3, 0, 1)));
+            destination[y * width + x] = _mm_cvtsi128_si32(entireExtrema);
+        }
+    }
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS) && defined(__SSE2__)
+
+#endif // FEMorphologySSE2_h
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SSE2Helpers_h
+#define SSE2Helpers_h
+
+#if ENABLE(FILTERS) && defined(__SSE2__)
+
+#include <emmintrin.h>
+
+namespace WebCore {
+
+// Expands the four 8-bit channels of a pixel into 32-bit lanes.
+ALWAYS_INLINE __m128i loadRGBA8AsInt(const uint32_t* source)
+{
+    __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*source), zero), zero);
+}
+
+ALWAYS_INLINE __m128 loadRGBA8AsFloat(const uint32_t* source)
+{
+    return _mm_cvtepi32_ps(loadRGBA8AsInt(source));
+}
+
+// Packs four 32-bit lanes back into a pixel, saturating each channel to 0..255.
+ALWAYS_INLINE void storeIntAsRGBA8(__m128i data, uint32_t* destination)
+{
+    __m128i packed = _mm_packs_epi32(data, data);
+    *destination = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS) && defined(__SSE2__)
+
+#endif // SSE2Helpers_h
@@ -25,6 +25,7 @@
 #if ENABLE(FILTERS)
 #include "FEColorMatrix.h"
 
+#include "FEColorMatrixSSE2.h"
 #include "Filter.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
@@ -116,6 +117,28 @@ void effectType(Uint8ClampedArray* pixelArray, const Vector<float>& values)
     else if (filterType == FECOLORMATRIX_TYPE_HUEROTATE)
         FEColorMatrix::calculateHueRotateComponents(components, values[0]);
 
+#if defined(__SSE2__)
+    // Luminance to alpha is computed in double precision, which the vector
+    // path would not match.
+    if (filterType != FECOLORMATRIX_TYPE_LUMINANCETOALPHA) {
+        float matrixValues[20];
+        if (filterType == FECOLORMATRIX_TYPE_MATRIX) {
+            for (unsigned i = 0; i < 20; ++i)
+                matrixValues[i] = values[i];
+        } else {
+            const float saturateAndHueRotateMatrix[20] = {
+                components[0], components[1], components[2], 0, 0,
+                components[3], components[4], components[5], 0, 0,
+                components[6], components[7], components[8], 0, 0,
+                0, 0, 0, 1, 0
+            };
+            memcpy(matrixValues, saturateAndHueRotateMatrix, sizeof(matrixValues));
+        }
+        colorMatrixSSE2(pixelArray->data(), pixelArrayLength, matrixValues);
+        return;
+    }
+#endif
+
     for (unsigned pixelByteOffset = 0; pixelByteOffset < pixelArrayLength; pixelByteOffset += 4) {
         float red = pixelArray->item(pixelByteOffset);
         float green = pixelArray->item(pixelByteOffset + 1);
@@ -27,6 +27,7 @@
 #include "FEComposite.h"
 
 #include "FECompositeArithmeticNEON.h"
+#include "FECompositeArithmeticSSE2.h"
 #include "Filter.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
@@ -223,6 +224,9 @@ inline void FEComposite::platformArithmeticSoftware(Uint8ClampedArray* source, U
 #if HAVE(ARM_NEON_INTRINSICS)
     ASSERT(!(length & 0x3));
     platformArithmeticNeon(source->data(), destination->data(), length, k1, k2, k3, k4);
+#elif defined(__SSE2__)
+    unsigned processedLength = platformArithmeticSSE2(source->data(), destination->data(), length, k1, k2, k3, k4);
+    arithmeticSoftware(source->data() + processedLength, destination->data() + processedLength, length - processedLength, k1, k2, k3, k4);
 #else
     arithmeticSoftware(source->data(), destination->data(), length, k1, k2, k3, k4);
 #endif
@@ -26,6 +26,7 @@
 #if ENABLE(FILTERS)
 #include "FEMorphology.h"
 
+#include "FEMorphologySSE2.h"
 #include "Filter.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
@@ -106,6 +107,17 @@ bool FEMorphology::setRadiusY(float radiusY)
 
 void FEMorphology::platformApplyGeneric(PaintingData* paintingData, int yStart, int yEnd)
 {
+#if defined(__SSE2__)
+    if (m_type == FEMORPHOLOGY_OPERATOR_ERODE) {
+        morphologySSE2<FEMORPHOLOGY_OPERATOR_ERODE>(paintingData, yStart, yEnd);
+        return;
+    }
+    if (m_type == FEMORPHOLOGY_OPERATOR_DILATE) {
+        morphologySSE2<FEMORPHOLOGY_OPERATOR_DILATE>(paintingData, yStart, yEnd);
+        return;
+    }
+#endif
+
     Uint8ClampedArray* srcPixelArray = paintingData->srcPixelArray;
     Uint8ClampedArray* dstPixelArray = paintingData->dstPixelArray;
     const int width = paintingData->width;
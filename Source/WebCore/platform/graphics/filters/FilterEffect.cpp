@@ -26,6 +26,7 @@
 #include "FilterEffect.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "ImageBuffer.h"
 #include "TextStream.h"
 #include <wtf/Uint8ClampedArray.h>
@@ -38,6 +39,7 @@ namespace WebCore {
 
 FilterEffect::FilterEffect(Filter* filter)
     : m_alphaImage(false)
+    , m_isInResultCache(false)
     , m_filter(filter)
     , m_hasX(false)
     , m_hasY(false)
@@ -52,6 +54,8 @@ FilterEffect::FilterEffect(Filter* filter)
 
 FilterEffect::~FilterEffect()
 {
+    if (m_isInResultCache)
+        FilterResultCache::shared().remove(this);
 }
 
 inline bool isFilterSizeValid(IntRect rect)
@@ -237,6 +241,18 @@ void FilterEffect::clearResult()
 #endif
 }
 
+size_t FilterEffect::resultSizeInBytes() const
+{
+    size_t size = 0;
+    if (m_imageBufferResult)
+        size += m_imageBufferResult->internalSize().width() * m_imageBufferResult->internalSize().height() * 4;
+    if (m_unmultipliedImageResult)
+        size += m_unmultipliedImageResult->length();
+    if (m_premultipliedImageResult)
+        size += m_premultipliedImageResult->length();
+    return size;
+}
+
 void FilterEffect::clearResultsRecursive()
 {
     // Clear all results, regardless that the current effect has
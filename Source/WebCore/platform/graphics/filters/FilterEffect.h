@@ -62,6 +62,9 @@ public:
     void clearResult();
     void clearResultsRecursive();
 
+    // The memory used by the results of this effect, not including its inputs.
+    size_t resultSizeInBytes() const;
+
     ImageBuffer* asImageBuffer();
     PassRefPtr<Uint8ClampedArray> asUnmultipliedImage(const IntRect&);
     PassRefPtr<Uint8ClampedArray> asPremultipliedImage(const IntRect&);
@@ -178,6 +181,8 @@ protected:
     void forceValidPreMultipliedPixels();
 
 private:
+    friend class FilterResultCache;
+
     OwnPtr<ImageBuffer> m_imageBufferResult;
     RefPtr<Uint8ClampedArray> m_unmultipliedImageResult;
     RefPtr<Uint8ClampedArray> m_premultipliedImageResult;
@@ -187,6 +192,7 @@ private:
 #endif
 
     bool m_alphaImage;
+    bool m_isInResultCache;
 
     IntRect m_absolutePaintRect;
     
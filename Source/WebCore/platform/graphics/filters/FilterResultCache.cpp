@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "FilterResultCache.h"
+
+#if ENABLE(FILTERS)
+
+#include "FilterEffect.h"
+#include <wtf/HashSet.h>
+#include <wtf/MainThread.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// A blurred layer of 1024x768 keeps around 10MB of results: the source graphic,
+// the blurred pixels and the image buffer they are drawn from.
+static const size_t maximumSizeInBytes = 32 * 1024 * 1024;
+
+static size_t resultSizeInBytes(FilterEffect* effect, HashSet<FilterEffect*>& visitedEffects)
+{
+    if (!visitedEffects.add(effect).isNewEntry)
+        return 0;
+
+    size_t size = effect->resultSizeInBytes();
+    unsigned numberOfInputs = effect->numberOfEffectInputs();
+    for (unsigned i = 0; i < numberOfInputs; ++i)
+        size += resultSizeInBytes(effect->inputEffect(i), visitedEffects);
+    return size;
+}
+
+FilterResultCache& FilterResultCache::shared()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(FilterResultCache, cache, ());
+    return cache;
+}
+
+FilterResultCache::FilterResultCache()
+    : m_budget(maximumSizeInBytes, evictResults)
+{
+}
+
+bool FilterResultCache::canCacheResultOfSize(const IntSize& size)
+{
+    // Leave room for a few graphs of a few results each.
+    return static_cast<size_t>(size.width()) * size.height() * 4 <= maximumSizeInBytes / 8;
+}
+
+void FilterResultCache::didPaintResults(FilterEffect* lastEffect)
+{
+    HashSet<FilterEffect*> visitedEffects;
+    lastEffect->m_isInResultCache = true;
+    m_budget.didUse(lastEffect, resultSizeInBytes(lastEffect, visitedEffects));
+}
+
+void FilterResultCache::remove(FilterEffect* lastEffect)
+{
+    m_budget.remove(lastEffect);
+    lastEffect->m_isInResultCache = false;
+}
+
+void FilterResultCache::releaseAllResults()
+{
+    m_budget.evictAll();
+}
+
+void FilterResultCache::evictResults(FilterEffect* lastEffect)
+{
+    lastEffect->m_isInResultCache = false;
+    lastEffect->clearResultsRecursive();
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS)
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FilterResultCache_h
+#define FilterResultCache_h
+
+#if ENABLE(FILTERS)
+
+#include "IntSize.h"
+#include "PaintCacheBudget.h"
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+
+class FilterEffect;
+
+// Filters keep the results of their effects from one paint to the next, so
+// that content which has not changed is not filtered again. This accounts
+// for the memory of all the results kept that way, and releases the least
+// recently painted ones when they add up to more than the budget.
+//
+// A graph of effects is represented by its last effect. Releasing it clears
+// the results of every effect of the graph, which are computed again the next
+// time the filter is painted.
+class FilterResultCache {
+    WTF_MAKE_NONCOPYABLE(FilterResultCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static FilterResultCache& shared();
+
+    // Whether results of this size are worth keeping at all.
+    static bool canCacheResultOfSize(const IntSize&);
+
+    // Called after the graph ending in |lastEffect| has been painted with its
+    // results kept. The graph becomes the most recently used one.
+    void didPaintResults(FilterEffect* lastEffect);
+
+    // Stops accounting for the graph; its results are left alone.
+    void remove(FilterEffect* lastEffect);
+
+    // Clears the results of every graph, when the system is low on memory.
+    void releaseAllResults();
+
+    size_t sizeInBytes() const { return m_budget.sizeInBytes(); }
+
+private:
+    FilterResultCache();
+
+    static void evictResults(FilterEffect* lastEffect);
+
+    PaintCacheBudget<FilterEffect> m_budget;
+};
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS)
+
+#endif // FilterResultCache_h
@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DisplayList.h"
+
+#include "GraphicsContext.h"
+#include <QPaintEngine>
+#include <QPainter>
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/MathExtras.h>
+
+namespace WebCore {
+
+// QPicture is Qt's own display list: a QPainter opened on it serializes every
+// call into a compact command stream, and QPainter::drawPicture() plays the
+// stream back through the target painter's paint engine.
+//
+// Recording goes through the engine below rather than straight into the
+// picture, so that text can be kept out of it: the picture engine turns glyph
+// runs into paths on playback, which renders them differently. The engine
+// also records pixmaps as images, since the picture keeps a reference to what
+// it draws and pixmaps may not be used off the main thread.
+class DisplayListRecordingEngine : public QPaintEngine {
+public:
+    explicit DisplayListRecordingEngine(QPicture* picture)
+        : QPaintEngine(AllFeatures)
+        , m_picture(picture)
+        , m_hasText(false)
+        , m_hasPixmaps(false)
+    {
+    }
+
+    bool hasText() const { return m_hasText; }
+    bool hasPixmaps() const { return m_hasPixmaps; }
+
+    virtual bool begin(QPaintDevice*) OVERRIDE { return m_target.begin(m_picture); }
+    virtual bool end() OVERRIDE { return m_target.end(); }
+    virtual Type type() const OVERRIDE { return User; }
+
+    virtual void updateState(const QPaintEngineState&) OVERRIDE;
+
+    using QPaintEngine::drawRects;
+    using QPaintEngine::drawLines;
+    using QPaintEngine::drawEllipse;
+    using QPaintEngine::drawPoints;
+    using QPaintEngine::drawPolygon;
+
+    virtual void drawRects(const QRectF* rects, int rectCount) OVERRIDE { m_target.drawRects(rects, rectCount); }
+    virtual void drawLines(const QLineF* lines, int lineCount) OVERRIDE { m_target.drawLines(lines, lineCount); }
+    virtual void drawEllipse(const QRectF& rect) OVERRIDE { m_target.drawEllipse(rect); }
+    virtual void drawPath(const QPainterPath& path) OVERRIDE { m_target.drawPath(path); }
+    virtual void drawPoints(const QPointF* points, int pointCount) OVERRIDE { m_target.drawPoints(points, pointCount); }
+    virtual void drawPolygon(const QPointF* points, int pointCount, PolygonDrawMode) OVERRIDE;
+    virtual void drawPixmap(const QRectF& rect, const QPixmap& pixmap, const QRectF& sourceRect) OVERRIDE { m_target.drawImage(rect, pixmap.toImage(), sourceRect); }
+    virtual void drawTiledPixmap(const QRectF& rect, const QPixmap& pixmap, const QPointF& offset) OVERRIDE
+    {
+        m_target.drawTiledPixmap(rect, pixmap, offset);
+        m_hasPixmaps = true;
+    }
+    virtual void drawImage(const QRectF& rect, const QImage& image, const QRectF& sourceRect, Qt::ImageConversionFlags flags) OVERRIDE { m_target.drawImage(rect, image, sourceRect, flags); }
+
+    // Nothing is recorded, the list is only flagged; see DisplayList::hasText().
+    virtual void drawTextItem(const QPointF&, const QTextItem&) OVERRIDE { m_hasText = true; }
+
+private:
+    QPicture* m_picture;
+    QPainter m_target;
+    bool m_hasText;
+    bool m_hasPixmaps;
+};
+
+static QBrush brushWithTextureImage(const QBrush& brush)
+{
+    if (brush.style() != Qt::TexturePattern)
+        return brush;
+    QBrush imageBrush(brush);
+    imageBrush.setTextureImage(brush.textureImage());
+    return imageBrush;
+}
+
+void DisplayListRecordingEngine::updateState(const QPaintEngineState& state)
+{
+    // The transform comes first, since the painter maps clips through it.
+    QPaintEngine::DirtyFlags flags = state.state();
+    if (flags & DirtyPen) {
+        QPen pen = state.pen();
+        pen.setBrush(brushWithTextureImage(pen.brush()));
+        m_target.setPen(pen);
+    }
+    if (flags & DirtyBrush)
+        m_target.setBrush(brushWithTextureImage(state.brush()));
+    if (flags & DirtyBrushOrigin)
+        m_target.setBrushOrigin(state.brushOrigin());
+    if (flags & DirtyBackground)
+        m_target.setBackground(state.backgroundBrush());
+    if (flags & DirtyBackgroundMode)
+        m_target.setBackgroundMode(state.backgroundMode());
+    if (flags & DirtyTransform)
+        m_target.setTransform(state.transform());
+    if (flags & DirtyClipRegion)
+        m_target.setClipRegion(state.clipRegion(), state.clipOperation());
+    if (flags & DirtyClipPath)
+        m_target.setClipPath(state.clipPath(), state.clipOperation());
+    if (flags & DirtyClipEnabled)
+        m_target.setClipping(state.isClipEnabled());
+    if (flags & DirtyHints) {
+        m_target.setRenderHints(m_target.renderHints(), false);
+        m_target.setRenderHints(state.renderHints());
+    }
+    if (flags & DirtyCompositionMode)
+        m_target.setCompositionMode(state.compositionMode());
+    if (flags & DirtyOpacity)
+        m_target.setOpacity(state.opacity());
+}
+
+void DisplayListRecordingEngine::drawPolygon(const QPointF* points, int pointCount, PolygonDrawMode mode)
+{
+    switch (mode) {
+    case OddEvenMode:
+        m_target.drawPolygon(points, pointCount, Qt::OddEvenFill);
+        break;
+    case WindingMode:
+        m_target.drawPolygon(points, pointCount, Qt::WindingFill);
+        break;
+    case ConvexMode:
+        m_target.drawConvexPolygon(points, pointCount);
+        break;
+    case PolylineMode:
+        m_target.drawPolyline(points, pointCount);
+        break;
+    }
+}
+
+// Has the metrics of the picture, so that painting into it is laid out exactly
+// like painting into the picture would be.
+class DisplayListRecordingDevice : public QPaintDevice {
+public:
+    explicit DisplayListRecordingDevice(QPicture* picture)
+        : m_picture(picture)
+        , m_engine(picture)
+    {
+    }
+
+    bool hasText() const { return m_engine.hasText(); }
+    bool hasPixmaps() const { return m_engine.hasPixmaps(); }
+
+    virtual QPaintEngine* paintEngine() const OVERRIDE { return &m_engine; }
+
+protected:
+    virtual int metric(PaintDeviceMetric) const OVERRIDE;
+
+private:
+    QPicture* m_picture;
+    mutable DisplayListRecordingEngine m_engine;
+};
+
+int DisplayListRecordingDevice::metric(PaintDeviceMetric metric) const
+{
+    switch (metric) {
+    case PdmWidth:
+        return m_picture->width();
+    case PdmHeight:
+        return m_picture->height();
+    case PdmWidthMM:
+        return m_picture->widthMM();
+    case PdmHeightMM:
+        return m_picture->heightMM();
+    case PdmNumColors:
+        return m_picture->colorCount();
+    case PdmDepth:
+        return m_picture->depth();
+    case PdmDpiX:
+        return m_picture->logicalDpiX();
+    case PdmDpiY:
+        return m_picture->logicalDpiY();
+    case PdmPhysicalDpiX:
+        return m_picture->physicalDpiX();
+    case PdmPhysicalDpiY:
+        return m_picture->physicalDpiY();
+    default:
+        return QPaintDevice::metric(metric);
+    }
+}
+
+PassOwnPtr<DisplayList> DisplayList::create(const IntRect& bounds, float scale)
+{
+    return adoptPtr(new DisplayList(bounds, scale));
+}
+
+DisplayList::DisplayList(const IntRect& bounds, float scale)
+    : m_bounds(bounds)
+    , m_scale(scale)
+    , m_recordingStartTime(0)
+    , m_hasText(false)
+    , m_hasPixmaps(false)
+{
+}
+
+DisplayList::~DisplayList()
+{
+    ASSERT(!m_painter);
+}
+
+GraphicsContext* DisplayList::beginRecording()
+{
+    ASSERT(!m_painter);
+    m_recordingStartTime = monotonicallyIncreasingTime();
+
+    m_picture = QPicture();
+    m_recordingDevice = adoptPtr(new DisplayListRecordingDevice(&m_picture));
+    m_painter = adoptPtr(new QPainter(m_recordingDevice.get()));
+
+    // The picture reports its bounding rect as the size of the paint device,
+    // which transparency layers rely on. Opening the painter resets it, so it
+    // is only set once recording has begun.
+    m_picture.setBoundingRect(QRect(0, 0, ceilf(m_bounds.width() * m_scale), ceilf(m_bounds.height() * m_scale)));
+
+    m_recordingContext = adoptPtr(new GraphicsContext(m_painter.get()));
+    m_recordingContext->scale(FloatSize(m_scale, m_scale));
+    m_recordingContext->translate(-m_bounds.x(), -m_bounds.y());
+    m_recordingContext->clip(m_bounds);
+    return m_recordingContext.get();
+}
+
+void DisplayList::endRecording()
+{
+    ASSERT(m_painter);
+    m_recordingContext.clear();
+    m_painter->end();
+    m_painter.clear();
+    m_hasText = m_recordingDevice->hasText();
+    m_hasPixmaps = m_recordingDevice->hasPixmaps();
+    m_recordingDevice.clear();
+
+    Statistics& statistics = mutableStatistics();
+    ++statistics.recordCount;
+    statistics.recordTime += monotonicallyIncreasingTime() - m_recordingStartTime;
+}
+
+void DisplayList::replay(GraphicsContext* context, const IntRect& clipRect)
+{
+    ASSERT(!m_painter);
+    ASSERT(!m_hasText);
+    IntRect rect = intersection(clipRect, m_bounds);
+    if (rect.isEmpty() || context->paintingDisabled())
+        return;
+
+    double startTime = monotonicallyIncreasingTime();
+
+    context->save();
+    context->clip(rect);
+    context->translate(m_bounds.x(), m_bounds.y());
+    context->scale(FloatSize(1 / m_scale, 1 / m_scale));
+    context->platformContext()->drawPicture(QPointF(), m_picture);
+    context->restore();
+
+    Statistics& statistics = mutableStatistics();
+    ++statistics.replayCount;
+    statistics.replayTime += monotonicallyIncreasingTime() - startTime;
+}
+
+void DisplayList::rasterize(GraphicsContext* context, const IntRect& rect)
+{
+    ASSERT(!m_painter);
+    ASSERT(!m_hasText);
+    ASSERT(isMainThread() || !m_hasPixmaps);
+    if (context->paintingDisabled())
+        return;
+
+    QPainter* painter = context->platformContext();
+    painter->save();
+    painter->translate(m_bounds.x() * m_scale - rect.x(), m_bounds.y() * m_scale - rect.y());
+    painter->drawPicture(QPointF(), m_picture);
+    painter->restore();
+}
+
+size_t DisplayList::sizeInBytes() const
+{
+    return m_picture.size();
+}
+
+} // namespace WebCore
@@ -54,7 +54,15 @@ FontCustomPlatformData* createFontCustomPlatformData(SharedBuffer* buffer)
     }
 #endif // USE(ZLIB)
 
-    const QByteArray fontData(buffer->data(), buffer->size());
+    // QRawFont keeps its own copy of the data; fill it from the segments rather than flattening the buffer.
+    QByteArray fontData;
+    fontData.reserve(buffer->size());
+    const char* segment;
+    unsigned position = 0;
+    while (unsigned length = buffer->getSomeData(segment, position)) {
+        fontData.append(segment, length);
+        position += length;
+    }
 #if !USE(ZLIB)
     if (fontData.startsWith("wOFF")) {
         qWarning("WOFF support requires QtWebKit to be built with zlib support.");
@@ -45,6 +45,10 @@
 #include <qalgorithms.h>
 
 #include <limits.h>
+#include <wtf/HashMap.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/text/StringHash.h>
 
 namespace WebCore {
 
@@ -217,6 +221,154 @@ private:
     QTextLine m_line;
 };
 
+// Shaping a complex run through QTextLayout is expensive, and the same words are shaped
+// when measured during line breaking, when painted and when hit tested. ShapedTextCache
+// keeps the shaped layouts, keyed by everything that feeds into the shaping. The direction
+// of the run is always set, so that measuring and painting a run share one layout.
+class ShapedText {
+    WTF_MAKE_NONCOPYABLE(ShapedText); WTF_MAKE_FAST_ALLOCATED;
+public:
+    ShapedText(const String& text, const Font& font, const TextRun& run)
+        : m_text(text)
+        , m_rawFont(font.rawFont())
+        , m_layout(fromRawDataWithoutRef(m_text))
+    {
+        m_layout.setRawFont(m_rawFont);
+        font.initFormatForTextLayout(&m_layout, run);
+        m_line = setupLayout(&m_layout, run, true);
+    }
+
+    const QRawFont& rawFont() const { return m_rawFont; }
+    const QTextLine& line() const { return m_line; }
+
+private:
+    String m_text; // Owns the characters m_layout refers to.
+    QRawFont m_rawFont;
+    QTextLayout m_layout;
+    QTextLine m_line;
+};
+
+class ShapedTextCacheKey {
+public:
+    ShapedTextCacheKey()
+    {
+        memset(&m_parameters, 0, sizeof(m_parameters));
+    }
+
+    ShapedTextCacheKey(WTF::HashTableDeletedValueType)
+        : m_text(WTF::HashTableDeletedValue)
+    {
+        memset(&m_parameters, 0, sizeof(m_parameters));
+    }
+
+    ShapedTextCacheKey(const String& text, const Font& font, const TextRun& run)
+        : m_text(text)
+    {
+        memset(&m_parameters, 0, sizeof(m_parameters));
+        m_parameters.fontData = font.primaryFont();
+        if (!run.spacingDisabled()) {
+            m_parameters.wordSpacing = font.wordSpacing();
+            m_parameters.letterSpacing = font.letterSpacing();
+        }
+        m_parameters.expansion = run.expansion();
+        m_parameters.flags = static_cast<unsigned>(run.rtl())
+            | static_cast<unsigned>(!!(font.typesettingFeatures() & Kerning)) << 1
+            | static_cast<unsigned>(font.isSmallCaps()) << 2;
+    }
+
+    bool isHashTableDeletedValue() const { return m_text.isHashTableDeletedValue(); }
+    bool isHashTableEmptyValue() const { return m_text.isNull(); }
+
+    unsigned hash() const
+    {
+        return pairIntHash(m_text.impl()->hash(), StringHasher::hashMemory<sizeof(Parameters)>(&m_parameters));
+    }
+
+    bool operator==(const ShapedTextCacheKey& other) const
+    {
+        return !memcmp(&m_parameters, &other.m_parameters, sizeof(m_parameters)) && equal(m_text.impl(), other.m_text.impl());
+    }
+
+private:
+    struct Parameters {
+        const SimpleFontData* fontData;
+        float wordSpacing;
+        float letterSpacing;
+        float expansion;
+        unsigned flags;
+    };
+
+    String m_text;
+    Parameters m_parameters;
+};
+
+struct ShapedTextCacheKeyHash {
+    static unsigned hash(const ShapedTextCacheKey& key) { return key.hash(); }
+    static bool equal(const ShapedTextCacheKey& a, const ShapedTextCacheKey& b) { return a == b; }
+    static const bool safeToCompareToEmptyOrDeleted = false;
+};
+
+struct ShapedTextCacheKeyTraits : WTF::SimpleClassHashTraits<ShapedTextCacheKey> {
+    static const bool hasIsEmptyValueFunction = true;
+    static bool isEmptyValue(const ShapedTextCacheKey& key) { return key.isHashTableEmptyValue(); }
+};
+
+class ShapedTextCache {
+    WTF_MAKE_NONCOPYABLE(ShapedTextCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    ShapedTextCache()
+        : m_characterCount(0)
+    {
+    }
+
+    // The returned ShapedText stays valid until the next call.
+    ShapedText* shape(const String& text, const Font& font, const TextRun& run)
+    {
+        if (text.length() > s_maxTextLength) {
+            m_uncachedText = adoptPtr(new ShapedText(text, font, run));
+            return m_uncachedText.get();
+        }
+
+        ShapedTextCacheKey key(text, font, run);
+        Map::iterator it = m_map.find(key);
+        if (it != m_map.end()) {
+            // The font data pointer in the key may have been reused for a different font.
+            if (it->value->rawFont() == font.rawFont())
+                return it->value.get();
+            m_characterCount -= text.length();
+            m_map.remove(it);
+        }
+
+        // No need to be fancy: we're just trying to avoid pathological growth.
+        if (m_map.size() >= s_maxEntries || m_characterCount + text.length() > s_maxCharacterCount) {
+            m_map.clear();
+            m_characterCount = 0;
+        }
+
+        OwnPtr<ShapedText> shapedText = adoptPtr(new ShapedText(text, font, run));
+        ShapedText* result = shapedText.get();
+        m_map.add(key, shapedText.release());
+        m_characterCount += text.length();
+        return result;
+    }
+
+private:
+    typedef HashMap<ShapedTextCacheKey, OwnPtr<ShapedText>, ShapedTextCacheKeyHash, ShapedTextCacheKeyTraits> Map;
+    static const unsigned s_maxTextLength = 256;
+    static const unsigned s_maxEntries = 2048;
+    static const unsigned s_maxCharacterCount = 64 * 1024;
+
+    Map m_map;
+    unsigned m_characterCount;
+    OwnPtr<ShapedText> m_uncachedText;
+};
+
+static ShapedText* shapeComplexText(const Font& font, const TextRun& run)
+{
+    DEFINE_STATIC_LOCAL(ShapedTextCache, cache, ());
+    return cache.shape(Font::normalizeSpaces(run.characters16(), run.length()), font, run);
+}
+
 PassOwnPtr<TextLayout> Font::createLayout(RenderText* text, float xPos, bool collapseWhiteSpace) const
 {
     if (!collapseWhiteSpace || !TextLayout::isNeeded(text, *this))
@@ -236,12 +388,7 @@ float Font::width(TextLayout& layout, unsigned from, unsigned len, HashSet<const
 
 void Font::drawComplexText(GraphicsContext* ctx, const TextRun& run, const FloatPoint& point, int from, int to) const
 {
-    String sanitized = Font::normalizeSpaces(run.characters16(), run.length());
-    const QString string = fromRawDataWithoutRef(sanitized);
-    QTextLayout layout(string);
-    layout.setRawFont(rawFont());
-    initFormatForTextLayout(&layout, run);
-    QTextLine line = setupLayout(&layout, run, true);
+    const QTextLine& line = shapeComplexText(*this, run)->line();
     const QPointF adjustedPoint(point.x(), point.y() - line.ascent());
 
     QList<QGlyphRun> runs = line.glyphRuns(from, to - from);
@@ -259,13 +406,8 @@ float Font::floatWidthForComplexText(const TextRun& run, HashSet<const SimpleFon
 
     if (run.length() == 1 && treatAsSpace(run[0]))
         return primaryFont()->spaceWidth() + run.expansion();
-    String sanitized = Font::normalizeSpaces(run.characters16(), run.length());
-    QString string = fromRawDataWithoutRef(sanitized);
 
-    QTextLayout layout(string);
-    layout.setRawFont(rawFont());
-    initFormatForTextLayout(&layout, run);
-    QTextLine line = setupLayout(&layout, run, false);
+    const QTextLine& line = shapeComplexText(*this, run)->line();
     float x1 = line.cursorToX(0);
     float x2 = line.cursorToX(run.length());
     float width = qAbs(x2 - x1);
@@ -275,25 +417,12 @@ float Font::floatWidthForComplexText(const TextRun& run, HashSet<const SimpleFon
 
 int Font::offsetForPositionForComplexText(const TextRun& run, float position, bool) const
 {
-    String sanitized = Font::normalizeSpaces(run.characters16(), run.length());
-    QString string = fromRawDataWithoutRef(sanitized);
-
-    QTextLayout layout(string);
-    layout.setRawFont(rawFont());
-    initFormatForTextLayout(&layout, run);
-    QTextLine line = setupLayout(&layout, run, false);
-    return line.xToCursor(position);
+    return shapeComplexText(*this, run)->line().xToCursor(position);
 }
 
 FloatRect Font::selectionRectForComplexText(const TextRun& run, const FloatPoint& pt, int h, int from, int to) const
 {
-    String sanitized = Font::normalizeSpaces(run.characters16(), run.length());
-    QString string = fromRawDataWithoutRef(sanitized);
-
-    QTextLayout layout(string);
-    layout.setRawFont(rawFont());
-    initFormatForTextLayout(&layout, run);
-    QTextLine line = setupLayout(&layout, run, false);
+    const QTextLine& line = shapeComplexText(*this, run)->line();
 
     float x1 = line.cursorToX(from);
     float x2 = line.cursorToX(to);
@@ -46,7 +46,7 @@ struct ImageBufferDataPrivate;
 class ImageBufferData
 {
 public:
-    ImageBufferData(const IntSize&, bool);
+    ImageBufferData(const IntSize&, bool accelerated, bool usePlatformBackingStore);
     OwnPtr<QPainter> m_painter;
     OwnPtr<ImageBufferDataPrivate> m_impl;
 };
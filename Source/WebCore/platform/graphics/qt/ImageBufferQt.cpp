@@ -33,6 +33,7 @@
 #include "GraphicsContext.h"
 #include "ImageData.h"
 #include "MIMETypeRegistry.h"
+#include "PixelConversions.h"
 #include "StillImageQt.h"
 #include "TransparencyLayer.h"
 #include <wtf/text/CString.h>
@@ -427,8 +428,97 @@ void ImageBufferDataPrivateUnaccelerated::platformTransformColorSpace(const Vect
         painter->begin(&m_pixmap);
 }
 
+/*************** QImage implementation ****************/
+
+// Backed by plain memory rather than by a QPixmap, so that it can be drawn
+// into on any thread. Only the pixel access functions stay on that thread;
+// drawing the buffer into another context goes through a QPixmap.
+struct ImageBufferDataPrivateImage : public ImageBufferDataPrivate {
+    ImageBufferDataPrivateImage(const IntSize& size);
+    QPaintDevice* paintDevice() { return m_image.isNull() ? 0 : &m_image; }
+    QImage toQImage() const { return m_image; }
+    PassRefPtr<Image> copyImage(BackingStoreCopy) const;
+    virtual bool isAccelerated() const { return false; }
+    PlatformLayer* platformLayer() { return 0; }
+    void draw(GraphicsContext* destContext, ColorSpace styleColorSpace, const FloatRect& destRect,
+              const FloatRect& srcRect, CompositeOperator op, BlendMode blendMode, bool useLowQualityScale,
+              bool ownContext);
+    void drawPattern(GraphicsContext* destContext, const FloatRect& srcRect, const AffineTransform& patternTransform,
+                     const FloatPoint& phase, ColorSpace styleColorSpace, CompositeOperator op,
+                     const FloatRect& destRect, bool ownContext);
+    void clip(GraphicsContext* context, const FloatRect& floatRect) const;
+    void platformTransformColorSpace(const Vector<int>& lookUpTable);
+
+    QImage m_image;
+};
+
+ImageBufferDataPrivateImage::ImageBufferDataPrivateImage(const IntSize& size)
+    : m_image(size, QImage::Format_ARGB32_Premultiplied)
+{
+    m_image.fill(Qt::transparent);
+}
+
+PassRefPtr<Image> ImageBufferDataPrivateImage::copyImage(BackingStoreCopy) const
+{
+    // The pixmap is a copy either way.
+    return StillImage::create(QPixmap::fromImage(m_image));
+}
+
+void ImageBufferDataPrivateImage::draw(GraphicsContext* destContext, ColorSpace styleColorSpace, const FloatRect& destRect,
+                                       const FloatRect& srcRect, CompositeOperator op, BlendMode blendMode,
+                                       bool useLowQualityScale, bool ownContext)
+{
+    RefPtr<Image> copy = copyImage(CopyBackingStore);
+    destContext->drawImage(copy.get(), ownContext ? ColorSpaceDeviceRGB : styleColorSpace, destRect, srcRect, op, blendMode, DoNotRespectImageOrientation, useLowQualityScale);
+}
+
+void ImageBufferDataPrivateImage::drawPattern(GraphicsContext* destContext, const FloatRect& srcRect, const AffineTransform& patternTransform,
+                                              const FloatPoint& phase, ColorSpace styleColorSpace, CompositeOperator op,
+                                              const FloatRect& destRect, bool)
+{
+    RefPtr<Image> copy = copyImage(CopyBackingStore);
+    copy->drawPattern(destContext, srcRect, patternTransform, phase, styleColorSpace, op, destRect);
+}
+
+void ImageBufferDataPrivateImage::clip(GraphicsContext* context, const FloatRect& floatRect) const
+{
+    IntRect rect = enclosingIntRect(floatRect);
+    context->pushTransparencyLayerInternal(rect, 1.0, QPixmap::fromImage(m_image));
+}
+
+void ImageBufferDataPrivateImage::platformTransformColorSpace(const Vector<int>& lookUpTable)
+{
+    QPainter* painter = paintDevice()->paintEngine()->painter();
+
+    bool isPainting = painter->isActive();
+    if (isPainting)
+        painter->end();
+
+    QImage image = m_image.convertToFormat(QImage::Format_ARGB32);
+    ASSERT(!image.isNull());
+
+    uchar* bits = image.bits();
+    const int bytesPerLine = image.bytesPerLine();
+
+    for (int y = 0; y < image.height(); ++y) {
+        quint32* scanLine = reinterpret_cast_ptr<quint32*>(bits + y * bytesPerLine);
+        for (int x = 0; x < image.width(); ++x) {
+            QRgb& pixel = scanLine[x];
+            pixel = qRgba(lookUpTable[qRed(pixel)],
+                          lookUpTable[qGreen(pixel)],
+                          lookUpTable[qBlue(pixel)],
+                          qAlpha(pixel));
+        }
+    }
+
+    m_image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    if (isPainting)
+        painter->begin(&m_image);
+}
+
 // ********************************************************
-ImageBufferData::ImageBufferData(const IntSize& size, bool accelerated)
+ImageBufferData::ImageBufferData(const IntSize& size, bool accelerated, bool usePlatformBackingStore)
 {
     QPainter* painter = new QPainter;
     m_painter = adoptPtr(painter);
@@ -438,6 +528,9 @@ ImageBufferData::ImageBufferData(const IntSize& size, bool accelerated)
         m_impl = adoptPtr(new ImageBufferDataPrivateAccelerated(size));
     } else
 #endif
+    if (!usePlatformBackingStore)
+        m_impl = adoptPtr(new ImageBufferDataPrivateImage(size));
+    else
         m_impl = adoptPtr(new ImageBufferDataPrivateUnaccelerated(size));
 
     if (!m_impl->paintDevice())
@@ -460,7 +553,7 @@ ImageBufferData::ImageBufferData(const IntSize& size, bool accelerated)
 }
 
 ImageBuffer::ImageBuffer(const IntSize& size, float /* resolutionScale */, ColorSpace, RenderingMode renderingMode, bool& success)
-    : m_data(size, renderingMode == Accelerated)
+    : m_data(size, renderingMode == Accelerated, renderingMode != UnacceleratedNonPlatformBuffer)
     , m_size(size)
     , m_logicalSize(size)
 {
@@ -496,6 +589,14 @@ PassRefPtr<Image> ImageBuffer::copyImage(BackingStoreCopy copyBehavior, ScaleBeh
     return m_data.m_impl->copyImage(copyBehavior);
 }
 
+QImage ImageBuffer::toQImage() const
+{
+    QImage image = m_data.m_impl->toQImage();
+    // The painter draws into the buffer without detaching it.
+    image.detach();
+    return image;
+}
+
 BackingStoreCopy ImageBuffer::fastCopyImageMode()
 {
     return DontCopyBackingStore;
@@ -523,6 +624,31 @@ void ImageBuffer::platformTransformColorSpace(const Vector<int>& lookUpTable)
     m_data.m_impl->platformTransformColorSpace(lookUpTable);
 }
 
+#if CPU(BIG_ENDIAN) || CPU(MIDDLE_ENDIAN)
+// ARGB32 pixels start with alpha here; RGBA8888 ones are RGBA in memory on any machine.
+static const QImage::Format premultipliedPixelFormat = QImage::Format_RGBA8888_Premultiplied;
+static const PixelChannelOrder channelOrderFromRGBA = KeepChannelOrder;
+#else
+// ARGB32 pixels are BGRA in memory here.
+static const QImage::Format premultipliedPixelFormat = QImage::Format_ARGB32_Premultiplied;
+static const PixelChannelOrder channelOrderFromRGBA = SwapRedAndBlue;
+#endif
+
+static inline void copyPixels(const uint8_t* source, uint8_t* destination, unsigned pixelCount, PixelChannelOrder order)
+{
+    if (order == KeepChannelOrder) {
+        memcpy(destination, source, pixelCount * 4);
+        return;
+    }
+
+    for (unsigned i = 0; i < pixelCount; ++i, source += 4, destination += 4) {
+        destination[0] = source[2];
+        destination[1] = source[1];
+        destination[2] = source[0];
+        destination[3] = source[3];
+    }
+}
+
 template <Multiply multiplied>
 PassRefPtr<Uint8ClampedArray> getImageData(const IntRect& rect, const ImageBufferData& imageData, const IntSize& size)
 {
@@ -532,15 +658,25 @@ PassRefPtr<Uint8ClampedArray> getImageData(const IntRect& rect, const ImageBuffe
 
     RefPtr<Uint8ClampedArray> result = Uint8ClampedArray::createUninitialized(rect.width() * rect.height() * 4);
 
-    QImage::Format format = (multiplied == Unmultiplied) ? QImage::Format_RGBA8888 : QImage::Format_RGBA8888_Premultiplied;
-    QImage image(result->data(), rect.width(), rect.height(), format);
-    if (rect.x() < 0 || rect.y() < 0 || rect.maxX() > size.width() || rect.maxY() > size.height())
-        image.fill(0);
-
-    // Let drawImage deal with the conversion.
-    QPainter p(&image);
-    p.setCompositionMode(QPainter::CompositionMode_Source);
-    p.drawImage(QPoint(0,0), imageData.m_impl->toQImage(), rect);
+    QImage image = imageData.m_impl->toQImage();
+    if (image.format() != premultipliedPixelFormat)
+        image = image.convertToFormat(premultipliedPixelFormat);
+
+    IntRect sourceRect = intersection(rect, IntRect(IntPoint(), size));
+    sourceRect.intersect(IntRect(0, 0, image.width(), image.height()));
+    if (sourceRect != rect)
+        result->zeroFill();
+
+    unsigned destinationBytesPerRow = rect.width() * 4;
+    uint8_t* destination = result->data() + (sourceRect.y() - rect.y()) * destinationBytesPerRow + (sourceRect.x() - rect.x()) * 4;
+    for (int y = sourceRect.y(); y < sourceRect.maxY(); ++y) {
+        const uint8_t* source = image.constScanLine(y) + sourceRect.x() * 4;
+        if (multiplied == Unmultiplied)
+            unpremultiplyPixels(source, destination, sourceRect.width(), channelOrderFromRGBA);
+        else
+            copyPixels(source, destination, sourceRect.width(), channelOrderFromRGBA);
+        destination += destinationBytesPerRow;
+    }
 
     return result.release();
 }
@@ -572,12 +708,19 @@ void ImageBuffer::putByteArray(Multiply multiplied, Uint8ClampedArray* source, c
         m_data.m_painter->setClipping(false);
     }
 
-    // Let drawImage deal with the conversion.
-    QImage::Format format = (multiplied == Unmultiplied) ? QImage::Format_RGBA8888 : QImage::Format_RGBA8888_Premultiplied;
-    QImage image(source->data(), sourceSize.width(), sourceSize.height(), format);
+    // Convert to the format of the backing store so that drawImage() only has to copy.
+    QImage image(sourceRect.width(), sourceRect.height(), premultipliedPixelFormat);
+    const uint8_t* sourceRow = source->data() + (sourceRect.y() * sourceSize.width() + sourceRect.x()) * 4;
+    for (int y = 0; y < sourceRect.height(); ++y) {
+        if (multiplied == Unmultiplied)
+            premultiplyPixels(sourceRow, image.scanLine(y), sourceRect.width(), channelOrderFromRGBA);
+        else
+            copyPixels(sourceRow, image.scanLine(y), sourceRect.width(), channelOrderFromRGBA);
+        sourceRow += sourceSize.width() * 4;
+    }
 
     m_data.m_painter->setCompositionMode(QPainter::CompositionMode_Source);
-    m_data.m_painter->drawImage(destPoint + sourceRect.location(), image, sourceRect);
+    m_data.m_painter->drawImage(destPoint + sourceRect.location(), image);
 
     if (!isPainting)
         m_data.m_painter->end();
@@ -29,12 +29,47 @@
 #include "config.h"
 #include "ImageDecoderQt.h"
 
-#include <QtCore/QBuffer>
-#include <QtCore/QByteArray>
+#include <QtCore/QIODevice>
 #include <QtGui/QImageReader>
 
 namespace WebCore {
 
+// Reads the image data straight from the segments of the buffer, so that it does not
+// have to be flattened into a copy first.
+class SharedBufferDevice : public QIODevice {
+public:
+    explicit SharedBufferDevice(PassRefPtr<SharedBuffer> buffer)
+        : m_buffer(buffer)
+    {
+    }
+
+    virtual bool isSequential() const { return false; }
+    virtual qint64 size() const { return m_buffer->size(); }
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize)
+    {
+        qint64 bytesRead = 0;
+        unsigned position = pos();
+        const char* segment;
+        while (bytesRead < maxSize) {
+            unsigned length = m_buffer->getSomeData(segment, position);
+            if (!length)
+                break;
+            length = std::min<qint64>(length, maxSize - bytesRead);
+            memcpy(data + bytesRead, segment, length);
+            bytesRead += length;
+            position += length;
+        }
+        return bytesRead;
+    }
+
+    virtual qint64 writeData(const char*, qint64) { return -1; }
+
+private:
+    RefPtr<SharedBuffer> m_buffer;
+};
+
 ImageDecoderQt::ImageDecoderQt(ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
     : ImageDecoder(alphaOption, gammaAndColorProfileOption)
     , m_repetitionCount(cAnimationNone)
@@ -62,9 +97,7 @@ void ImageDecoderQt::setData(SharedBuffer* data, bool allDataReceived)
     ASSERT(!m_reader);
 
     // Attempt to load the data
-    QByteArray imageData = QByteArray::fromRawData(m_data->data(), m_data->size());
-    m_buffer = adoptPtr(new QBuffer);
-    m_buffer->setData(imageData);
+    m_buffer = adoptPtr(new SharedBufferDevice(m_data));
     m_buffer->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
     m_reader = adoptPtr(new QImageReader(m_buffer.get(), m_format));
 
@@ -28,7 +28,6 @@
 #define ImageDecoderQt_h
 
 #include "ImageDecoder.h"
-#include <QtCore/QBuffer>
 #include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtGui/QImageReader>
@@ -68,7 +67,7 @@ private:
 
 private:
     QByteArray m_format;
-    OwnPtr<QBuffer> m_buffer;
+    OwnPtr<QIODevice> m_buffer;
     OwnPtr<QImageReader> m_reader;
     mutable int m_repetitionCount;
 };
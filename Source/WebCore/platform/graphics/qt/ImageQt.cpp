@@ -136,6 +136,11 @@ void Image::setPlatformResource(const char* name, const QPixmap& pixmap)
 void Image::drawPattern(GraphicsContext* ctxt, const FloatRect& tileRect, const AffineTransform& patternTransform,
     const FloatPoint& phase, ColorSpace, CompositeOperator op, const FloatRect& destRect, BlendMode)
 {
+#if USE(ASYNC_IMAGE_DECODING)
+    if (isBitmapImage() && static_cast<BitmapImage*>(this)->isWaitingForAsyncDecoding())
+        return;
+#endif
+
     QPixmap* framePixmap = nativeImageForCurrentFrame();
     if (!framePixmap) // If it's too early we won't have an image yet.
         return;
@@ -211,6 +216,7 @@ BitmapImage::BitmapImage(QPixmap* pixmap, ImageObserver* observer)
     , m_repetitionCountStatus(Unknown)
     , m_repetitionsComplete(0)
     , m_decodedSize(0)
+    , m_frameCacheBytes(0)
     , m_frameCount(1)
     , m_isSolidColor(false)
     , m_checkedForSolidColor(false)
@@ -219,6 +225,9 @@ BitmapImage::BitmapImage(QPixmap* pixmap, ImageObserver* observer)
     , m_haveSize(true)
     , m_sizeAvailable(true)
     , m_haveFrameCount(true)
+#if USE(ASYNC_IMAGE_DECODING)
+    , m_waitingForAnimationFrame(false)
+#endif
 {
     int width = pixmap->width();
     int height = pixmap->height();
@@ -294,7 +303,24 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dst,
     if (normalizedSrc.isEmpty() || normalizedDst.isEmpty())
         return;
 
+#if USE(SCALED_IMAGE_DECODING)
+    FloatRect deviceDst = ctxt->getCTM().mapRect(FloatRect(normalizedDst));
+    FloatSize imageSize = size();
+    updateDecodedSizeForPaint(FloatSize(imageSize.width() * deviceDst.width() / normalizedSrc.width(), imageSize.height() * deviceDst.height() / normalizedSrc.height()));
+#endif
+
+#if USE(ASYNC_IMAGE_DECODING)
+    // Leave the image out until the decoding thread is done; didFinishAsyncDecoding() repaints it.
+    if (isWaitingForAsyncDecoding())
+        return;
+#endif
+
+#if USE(SCALED_IMAGE_DECODING)
+    // The frame may be smaller than the image; the source rect is adjusted below.
+    QPixmap* image = frameAtIndex(currentFrame());
+#else
     QPixmap* image = nativeImageForCurrentFrame();
+#endif
     if (!image)
         return;
 
@@ -303,7 +329,7 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dst,
         return;
     }
 
-#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING) || USE(SCALED_IMAGE_DECODING)
     normalizedSrc = adjustSourceRectForDownSampling(normalizedSrc, image->size());
 #endif
 
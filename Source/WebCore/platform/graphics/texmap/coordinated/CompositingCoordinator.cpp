@@ -400,6 +400,23 @@ bool CompositingCoordinator::paintToSurface(const IntSize& size, CoordinatedSurf
     return m_updateAtlases.last()->paintOnAvailableBuffer(size, atlasID, offset, client);
 }
 
+PassRefPtr<CoordinatedSurface> CompositingCoordinator::createSurfaceForRasterization(const IntSize& size, CoordinatedSurface::Flags flags)
+{
+    RefPtr<CoordinatedSurface> surface = CoordinatedSurface::create(UpdateAtlas::adoptableSurfaceSize(size), flags);
+    if (!surface || !surface->canPaintOnAnyThread())
+        return 0;
+    return surface.release();
+}
+
+uint32_t CompositingCoordinator::adoptRasterizedSurface(PassRefPtr<CoordinatedSurface> surface)
+{
+    // The surface becomes an atlas of its own, which later updates can reuse
+    // like any other once it has been swapped.
+    m_updateAtlases.append(adoptPtr(new UpdateAtlas(this, surface)));
+    scheduleReleaseInactiveAtlases();
+    return m_updateAtlases.last()->id();
+}
+
 const double ReleaseInactiveAtlasesTimerInterval = 0.5;
 
 void CompositingCoordinator::scheduleReleaseInactiveAtlases()
@@ -115,6 +115,8 @@ private:
     virtual PassRefPtr<CoordinatedImageBacking> createImageBackingIfNeeded(Image*) OVERRIDE;
     virtual void detachLayer(CoordinatedGraphicsLayer*) OVERRIDE;
     virtual bool paintToSurface(const WebCore::IntSize&, WebCore::CoordinatedSurface::Flags, uint32_t& /* atlasID */, WebCore::IntPoint&, WebCore::CoordinatedSurface::Client*) OVERRIDE;
+    virtual PassRefPtr<CoordinatedSurface> createSurfaceForRasterization(const IntSize&, CoordinatedSurface::Flags) OVERRIDE;
+    virtual uint32_t adoptRasterizedSurface(PassRefPtr<CoordinatedSurface>) OVERRIDE;
     virtual void syncLayerState(CoordinatedLayerID, CoordinatedGraphicsLayerState&) OVERRIDE;
 
     // UpdateAtlas::Client
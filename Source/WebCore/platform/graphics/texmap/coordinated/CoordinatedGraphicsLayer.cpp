@@ -31,6 +31,7 @@
 #include "FrameView.h"
 #include "GraphicsContext.h"
 #include "GraphicsLayer.h"
+#include "Logging.h"
 #include "Page.h"
 #include "ScrollableArea.h"
 #include "TextureMapperPlatformLayer.h"
@@ -116,6 +117,7 @@ CoordinatedGraphicsLayer::CoordinatedGraphicsLayer(GraphicsLayerClient* client)
     , m_pendingCanvasOperation(None)
 #endif
     , m_coordinator(0)
+    , m_displayListCache(this)
     , m_compositedNativeImagePtr(0)
     , m_canvasPlatformLayer(0)
     , m_animationStartedTimer(this, &CoordinatedGraphicsLayer::animationStartedTimerFired)
@@ -268,6 +270,8 @@ void CoordinatedGraphicsLayer::setDrawsContent(bool b)
     if (drawsContent() == b)
         return;
     GraphicsLayer::setDrawsContent(b);
+    if (!b)
+        m_displayListCache.clear();
     m_layerState.drawsContent = b;
     m_layerState.flagsChanged = true;
 
@@ -548,6 +552,7 @@ void CoordinatedGraphicsLayer::setNeedsDisplayInRect(const FloatRect& rect)
 {
     if (m_mainBackingStore)
         m_mainBackingStore->invalidate(IntRect(rect));
+    m_displayListCache.invalidate(enclosingIntRect(rect));
 
     didChangeLayerState();
 
@@ -911,11 +916,23 @@ void CoordinatedGraphicsLayer::tiledBackingStorePaint(GraphicsContext* context,
 {
     if (rect.isEmpty())
         return;
+    m_displayListCache.paint(context, rect, m_mainBackingStore ? m_mainBackingStore->contentsScale() : effectiveContentsScale());
+}
+
+void CoordinatedGraphicsLayer::paintDisplayListContents(GraphicsContext* context, const IntRect& rect)
+{
     paintGraphicsLayerContents(*context, rect);
 }
 
 void CoordinatedGraphicsLayer::tiledBackingStorePaintEnd(const Vector<IntRect>& updatedRects)
 {
+#if !LOG_DISABLED
+    const DisplayList::Statistics& statistics = DisplayList::statistics();
+    if (!updatedRects.isEmpty())
+        LOG(Compositing, "CoordinatedGraphicsLayer %u: %u display lists recorded in %.3fs, %u replayed in %.3fs, %zu bytes cached",
+            m_id, statistics.recordCount, statistics.recordTime, statistics.replayCount, statistics.replayTime, m_displayListCache.sizeInBytes());
+#endif
+
     if (!isShowingRepaintCounter() || updatedRects.isEmpty())
         return;
 
@@ -975,6 +992,26 @@ bool CoordinatedGraphicsLayer::paintToSurface(const IntSize& size, uint32_t& atl
     return m_coordinator->paintToSurface(size, contentsOpaque() ? CoordinatedSurface::NoFlags : CoordinatedSurface::SupportsAlpha, atlas, offset, client);
 }
 
+PassRefPtr<CoordinatedSurface> CoordinatedGraphicsLayer::createSurfaceForRasterization(const IntSize& size)
+{
+    ASSERT(m_coordinator);
+    return m_coordinator->createSurfaceForRasterization(size, contentsOpaque() ? CoordinatedSurface::NoFlags : CoordinatedSurface::SupportsAlpha);
+}
+
+uint32_t CoordinatedGraphicsLayer::adoptRasterizedSurface(PassRefPtr<CoordinatedSurface> surface)
+{
+    ASSERT(m_coordinator);
+    ASSERT(m_coordinator->isFlushingLayerChanges());
+    return m_coordinator->adoptRasterizedSurface(surface);
+}
+
+void CoordinatedGraphicsLayer::didFinishTileRasterization()
+{
+    // The tile is committed by the next flush.
+    if (client())
+        client()->notifyFlushRequired(this);
+}
+
 void CoordinatedGraphicsLayer::createTile(uint32_t tileID, const SurfaceUpdateInfo& updateInfo, const IntRect& tileRect)
 {
     ASSERT(m_coordinator);
@@ -1060,6 +1097,7 @@ void CoordinatedGraphicsLayer::purgeBackingStores()
     TemporaryChange<bool> updateModeProtector(m_isPurging, true);
     m_mainBackingStore.clear();
     m_previousBackingStore.clear();
+    m_displayListCache.clear();
 
     releaseImageBackingIfNeeded();
 
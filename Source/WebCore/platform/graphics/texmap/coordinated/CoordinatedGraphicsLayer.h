@@ -24,6 +24,7 @@
 #include "CoordinatedGraphicsState.h"
 #include "CoordinatedImageBacking.h"
 #include "CoordinatedTile.h"
+#include "DisplayListCache.h"
 #include "FloatPoint3D.h"
 #include "GraphicsLayer.h"
 #include "GraphicsLayerAnimation.h"
@@ -54,6 +55,8 @@ public:
     virtual PassRefPtr<CoordinatedImageBacking> createImageBackingIfNeeded(Image*) = 0;
     virtual void detachLayer(CoordinatedGraphicsLayer*) = 0;
     virtual bool paintToSurface(const IntSize&, CoordinatedSurface::Flags, uint32_t& atlasID, IntPoint&, CoordinatedSurface::Client*) = 0;
+    virtual PassRefPtr<CoordinatedSurface> createSurfaceForRasterization(const IntSize&, CoordinatedSurface::Flags) = 0;
+    virtual uint32_t adoptRasterizedSurface(PassRefPtr<CoordinatedSurface>) = 0;
 
     virtual void syncLayerState(CoordinatedLayerID, CoordinatedGraphicsLayerState&) = 0;
 };
@@ -62,6 +65,7 @@ class CoordinatedGraphicsLayer : public GraphicsLayer
     , public TiledBackingStoreClient
     , public CoordinatedImageBacking::Host
     , public CoordinatedTileClient
+    , public DisplayListCacheClient
     , public TextureMapperPlatformLayer::Client {
 public:
     explicit CoordinatedGraphicsLayer(GraphicsLayerClient*);
@@ -147,6 +151,12 @@ public:
     virtual void updateTile(uint32_t tileID, const SurfaceUpdateInfo&, const IntRect&) OVERRIDE;
     virtual void removeTile(uint32_t tileID) OVERRIDE;
     virtual bool paintToSurface(const IntSize&, uint32_t& /* atlasID */, IntPoint&, CoordinatedSurface::Client*) OVERRIDE;
+    virtual PassRefPtr<CoordinatedSurface> createSurfaceForRasterization(const IntSize&) OVERRIDE;
+    virtual uint32_t adoptRasterizedSurface(PassRefPtr<CoordinatedSurface>) OVERRIDE;
+    virtual void didFinishTileRasterization() OVERRIDE;
+
+    // DisplayListCacheClient
+    virtual void paintDisplayListContents(GraphicsContext*, const IntRect&) OVERRIDE;
 
     // TexturePlatformLayerClient
     virtual void setPlatformLayerNeedsDisplay() OVERRIDE { setContentsNeedsDisplay(); }
@@ -244,6 +254,7 @@ private:
     CoordinatedGraphicsLayerClient* m_coordinator;
     OwnPtr<TiledBackingStore> m_mainBackingStore;
     OwnPtr<TiledBackingStore> m_previousBackingStore;
+    DisplayListCache m_displayListCache;
 
     RefPtr<Image> m_compositedImage;
     NativeImagePtr m_compositedNativeImagePtr;
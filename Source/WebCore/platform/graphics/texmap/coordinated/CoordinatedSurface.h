@@ -55,6 +55,10 @@ public:
 
     virtual void paintToSurface(const IntRect&, Client*) = 0;
 
+    // Whether paintToSurface() may be called on a thread other than the main
+    // thread, as long as nothing else paints into the surface meanwhile.
+    virtual bool canPaintOnAnyThread() const { return false; }
+
 #if USE(TEXTURE_MAPPER)
     virtual void copyToTexture(PassRefPtr<BitmapTexture>, const IntRect& target, const IntPoint& sourceOffset) = 0;
 #endif
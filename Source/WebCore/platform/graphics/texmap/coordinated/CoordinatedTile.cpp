@@ -31,6 +31,7 @@
 #include "GraphicsContext.h"
 #include "ImageBuffer.h"
 #include "SurfaceUpdateInfo.h"
+#include "TileRasterizer.h"
 #include "TiledBackingStoreClient.h"
 
 namespace WebCore {
@@ -44,11 +45,14 @@ CoordinatedTile::CoordinatedTile(CoordinatedTileClient* client, TiledBackingStor
     , m_rect(tiledBackingStore->tileRectForCoordinate(tileCoordinate))
     , m_ID(InvalidCoordinatedTileID)
     , m_dirtyRect(m_rect)
+    , m_waitsForRasterization(false)
+    , m_paintsDirectly(false)
 {
 }
 
 CoordinatedTile::~CoordinatedTile()
 {
+    cancelRasterization();
     if (m_ID != InvalidCoordinatedTileID)
         m_client->removeTile(m_ID);
 }
@@ -64,7 +68,63 @@ void CoordinatedTile::invalidate(const IntRect& dirtyRect)
     if (tileDirtyRect.isEmpty())
         return;
 
+    // Whatever is being rasterized is out of date now.
+    cancelRasterization();
     m_dirtyRect.unite(tileDirtyRect);
+
+    // Content that is repainted as a whole is recorded anew.
+    if (m_dirtyRect == m_rect)
+        m_paintsDirectly = false;
+}
+
+void CoordinatedTile::scheduleBackBufferUpdate(double distanceFromViewport)
+{
+    if (!isDirty() || m_paintsDirectly || !TileRasterizer::isSupported())
+        return;
+
+    // Tiles in view have to be up to date at the end of this update. The others
+    // are updated by the first update after their rasterization is done.
+    m_waitsForRasterization = !distanceFromViewport;
+
+    if (m_rasterizationJob) {
+        TileRasterizer::shared().setPriority(m_rasterizationJob.get(), distanceFromViewport);
+        return;
+    }
+
+    // Walking the render tree has to happen here on the main thread; recording
+    // it is cheap compared to rasterizing it.
+    IntRect contentsRect = m_tiledBackingStore->mapToContents(m_dirtyRect);
+    OwnPtr<DisplayList> displayList = DisplayList::create(contentsRect, m_tiledBackingStore->contentsScale());
+    m_tiledBackingStore->client()->tiledBackingStorePaint(displayList->beginRecording(), contentsRect);
+    displayList->endRecording();
+
+    // Tiles with text are painted directly by updateBackBuffer(), and so are
+    // the ones whose display list or surface can only be painted on the main
+    // thread. They keep being painted that way, without recording them first.
+    RefPtr<CoordinatedSurface> surface;
+    if (!displayList->hasText() && displayList->canRasterizeOnAnyThread())
+        surface = m_client->createSurfaceForRasterization(m_dirtyRect.size());
+    if (!surface) {
+        m_paintsDirectly = true;
+        return;
+    }
+
+    m_rasterizationJob = TileRasterizationJob::create(this, displayList.release(), m_dirtyRect, surface.release());
+    TileRasterizer::shared().schedule(m_rasterizationJob, distanceFromViewport);
+}
+
+void CoordinatedTile::cancelRasterization()
+{
+    if (!m_rasterizationJob)
+        return;
+    TileRasterizer::shared().cancel(m_rasterizationJob.get());
+    m_rasterizationJob = 0;
+}
+
+void CoordinatedTile::didFinishRasterization(TileRasterizationJob* job)
+{
+    ASSERT_UNUSED(job, job == m_rasterizationJob);
+    m_client->didFinishTileRasterization();
 }
 
 Vector<IntRect> CoordinatedTile::updateBackBuffer()
@@ -72,9 +132,21 @@ Vector<IntRect> CoordinatedTile::updateBackBuffer()
     if (!isDirty())
         return Vector<IntRect>();
 
+    if (m_rasterizationJob) {
+        ASSERT(m_rasterizationJob->rect() == m_dirtyRect);
+        TileRasterizer& rasterizer = TileRasterizer::shared();
+        if (!m_waitsForRasterization && !rasterizer.isFinished(m_rasterizationJob.get()))
+            return Vector<IntRect>();
+        rasterizer.waitForJob(m_rasterizationJob.get());
+    }
+
     SurfaceUpdateInfo updateInfo;
 
-    if (!m_client->paintToSurface(m_dirtyRect.size(), updateInfo.atlasID, updateInfo.surfaceOffset, this))
+    if (m_rasterizationJob) {
+        // The job painted the dirty rect at the origin of a surface of its own.
+        updateInfo.atlasID = m_client->adoptRasterizedSurface(m_rasterizationJob->surface());
+        cancelRasterization();
+    } else if (!m_client->paintToSurface(m_dirtyRect.size(), updateInfo.atlasID, updateInfo.surfaceOffset, this))
         return Vector<IntRect>();
 
     updateInfo.updateRect = m_dirtyRect;
@@ -121,8 +193,10 @@ void CoordinatedTile::paint(GraphicsContext*, const IntRect&)
 
 void CoordinatedTile::resize(const IntSize& newSize)
 {
+    cancelRasterization();
     m_rect = IntRect(m_rect.location(), newSize);
     m_dirtyRect = m_rect;
+    m_paintsDirectly = false;
 }
 
 CoordinatedTileBackend::CoordinatedTileBackend(CoordinatedTileClient* client)
@@ -38,6 +38,7 @@ namespace WebCore {
 class CoordinatedTileClient;
 class ImageBuffer;
 class SurfaceUpdateInfo;
+class TileRasterizationJob;
 class TiledBackingStore;
 
 class CoordinatedTile : public Tile, public CoordinatedSurface::Client {
@@ -47,6 +48,7 @@ public:
 
     bool isDirty() const;
     void invalidate(const IntRect&);
+    void scheduleBackBufferUpdate(double distanceFromViewport);
     Vector<IntRect> updateBackBuffer();
     void swapBackBufferToFront();
     bool isReadyToPaint() const;
@@ -58,9 +60,13 @@ public:
 
     virtual void paintToSurfaceContext(GraphicsContext*) OVERRIDE;
 
+    void didFinishRasterization(TileRasterizationJob*);
+
 private:
     CoordinatedTile(CoordinatedTileClient*, TiledBackingStore*, const Coordinate&);
 
+    void cancelRasterization();
+
     CoordinatedTileClient* m_client;
     TiledBackingStore* m_tiledBackingStore;
     Coordinate m_coordinate;
@@ -69,6 +75,13 @@ private:
     uint32_t m_ID;
     IntRect m_dirtyRect;
 
+    RefPtr<TileRasterizationJob> m_rasterizationJob;
+    bool m_waitsForRasterization;
+
+    // Set once recording the tile turned out to be of no use off the main
+    // thread, until the whole tile is repainted.
+    bool m_paintsDirectly;
+
     OwnPtr<ImageBuffer> m_localBuffer;
 };
 
@@ -79,6 +92,11 @@ public:
     virtual void updateTile(uint32_t tileID, const SurfaceUpdateInfo&, const IntRect&) = 0;
     virtual void removeTile(uint32_t tileID) = 0;
     virtual bool paintToSurface(const IntSize&, uint32_t& atlasID, IntPoint&, CoordinatedSurface::Client*) = 0;
+    // Returns 0 if the surfaces can't be painted on other threads.
+    virtual PassRefPtr<CoordinatedSurface> createSurfaceForRasterization(const IntSize&) = 0;
+    // Returns the ID of the atlas that now holds the surface.
+    virtual uint32_t adoptRasterizedSurface(PassRefPtr<CoordinatedSurface>) = 0;
+    virtual void didFinishTileRasterization() = 0;
 };
 
 class CoordinatedTileBackend : public TiledBackingStoreBackend {
@@ -34,7 +34,8 @@ namespace WebCore {
 
 PassRefPtr<ThreadSafeCoordinatedSurface> ThreadSafeCoordinatedSurface::create(const IntSize& size, CoordinatedSurface::Flags flags)
 {
-    return adoptRef(new ThreadSafeCoordinatedSurface(size, flags, ImageBuffer::create(size)));
+    // Platform backed buffers, such as pixmaps, can only be painted on the main thread.
+    return adoptRef(new ThreadSafeCoordinatedSurface(size, flags, ImageBuffer::create(size, 1, ColorSpaceDeviceRGB, ImageBuffer::UnacceleratedNonPlatformBuffer)));
 }
 
 ThreadSafeCoordinatedSurface::ThreadSafeCoordinatedSurface(const IntSize& size, CoordinatedSurface::Flags flags, PassOwnPtr<ImageBuffer> buffer)
@@ -39,6 +39,7 @@ public:
     static PassRefPtr<ThreadSafeCoordinatedSurface> create(const IntSize&, Flags);
 
     virtual void paintToSurface(const IntRect&, CoordinatedSurface::Client*) OVERRIDE;
+    virtual bool canPaintOnAnyThread() const OVERRIDE { return true; }
     virtual void copyToTexture(PassRefPtr<BitmapTexture>, const IntRect& target, const IntPoint& sourceOffset) OVERRIDE;
 
 private:
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TileRasterizer.h"
+
+#if USE(TILED_BACKING_STORE)
+
+#include "BackgroundThreadPool.h"
+#include "CoordinatedTile.h"
+#include "GraphicsContext.h"
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+TileRasterizationJob::TileRasterizationJob(CoordinatedTile* tile, PassOwnPtr<DisplayList> displayList, const IntRect& rect, PassRefPtr<CoordinatedSurface> surface)
+    : m_tile(tile)
+    , m_displayList(displayList)
+    , m_rect(rect)
+    , m_surface(surface)
+    , m_state(Pending)
+    , m_priority(0)
+{
+    ASSERT(isMainThread());
+    ASSERT(m_displayList->canRasterizeOnAnyThread());
+    ASSERT(m_surface->canPaintOnAnyThread());
+    ASSERT(IntRect(IntPoint::zero(), m_surface->size()).contains(IntRect(IntPoint::zero(), m_rect.size())));
+}
+
+TileRasterizationJob::~TileRasterizationJob()
+{
+    // The display list holds on to images which must be released on the main thread.
+    ASSERT(isMainThread());
+    ASSERT(!m_tile);
+}
+
+void TileRasterizationJob::rasterize()
+{
+    m_surface->paintToSurface(IntRect(IntPoint::zero(), m_rect.size()), this);
+}
+
+void TileRasterizationJob::paintToSurfaceContext(GraphicsContext* context)
+{
+    // The surface is new, so it is cleared first. Opaque content is expected to
+    // cover the whole rect, like it would when painted into a tile directly.
+    IntRect rect(IntPoint::zero(), m_rect.size());
+    if (m_surface->supportsAlpha()) {
+        context->setCompositeOperation(CompositeCopy);
+        context->fillRect(rect, Color::transparent, ColorSpaceDeviceRGB);
+        context->setCompositeOperation(CompositeSourceOver);
+    } else
+        context->fillRect(rect, Color::white, ColorSpaceDeviceRGB);
+
+    m_displayList->rasterize(context, m_rect);
+}
+
+TileRasterizer& TileRasterizer::shared()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(TileRasterizer, rasterizer, ());
+    return rasterizer;
+}
+
+TileRasterizer::TileRasterizer()
+{
+}
+
+void TileRasterizer::schedule(PassRefPtr<TileRasterizationJob> job, double priority)
+{
+    ASSERT(isMainThread());
+    {
+        MutexLocker locker(m_mutex);
+        job->m_priority = priority;
+        m_queue.append(job);
+    }
+
+    // The job that runs isn't necessarily this one, but the most urgent one
+    // by then. Jobs taken off the queue before that leave a call with nothing to do.
+    BackgroundThreadPool::shared().dispatch(bind(&TileRasterizer::runNextJob, this));
+}
+
+void TileRasterizer::setPriority(TileRasterizationJob* job, double priority)
+{
+    ASSERT(isMainThread());
+    MutexLocker locker(m_mutex);
+    job->m_priority = priority;
+}
+
+bool TileRasterizer::isFinished(TileRasterizationJob* job)
+{
+    ASSERT(isMainThread());
+    MutexLocker locker(m_mutex);
+    return job->m_state == TileRasterizationJob::Finished;
+}
+
+void TileRasterizer::waitForJob(TileRasterizationJob* job)
+{
+    ASSERT(isMainThread());
+    RefPtr<TileRasterizationJob> protector;
+    {
+        MutexLocker locker(m_mutex);
+        if (job->m_state == TileRasterizationJob::Pending) {
+            size_t index = m_queue.find(job);
+            ASSERT(index != notFound);
+            protector = m_queue[index].release();
+            m_queue.remove(index);
+            job->m_state = TileRasterizationJob::Running;
+        } else {
+            while (job->m_state != TileRasterizationJob::Finished)
+                m_jobFinished.wait(m_mutex);
+            return;
+        }
+    }
+
+    job->rasterize();
+
+    MutexLocker locker(m_mutex);
+    job->m_state = TileRasterizationJob::Finished;
+}
+
+void TileRasterizer::cancel(TileRasterizationJob* job)
+{
+    ASSERT(isMainThread());
+    job->m_tile = 0;
+
+    // A pending job is dropped from the queue here rather than on a rasterizer
+    // thread, so that it is destroyed on the main thread.
+    RefPtr<TileRasterizationJob> protector;
+    MutexLocker locker(m_mutex);
+    if (job->m_state != TileRasterizationJob::Pending)
+        return;
+    size_t index = m_queue.find(job);
+    ASSERT(index != notFound);
+    protector = m_queue[index].release();
+    m_queue.remove(index);
+}
+
+PassRefPtr<TileRasterizationJob> TileRasterizer::takeNextJob()
+{
+    if (m_queue.isEmpty())
+        return 0;
+
+    size_t next = 0;
+    for (size_t i = 1; i < m_queue.size(); ++i) {
+        if (m_queue[i]->m_priority < m_queue[next]->m_priority)
+            next = i;
+    }
+
+    RefPtr<TileRasterizationJob> job = m_queue[next].release();
+    m_queue.remove(next);
+    job->m_state = TileRasterizationJob::Running;
+    return job.release();
+}
+
+void TileRasterizer::runNextJob()
+{
+    ASSERT(!isMainThread());
+
+    RefPtr<TileRasterizationJob> job;
+    {
+        MutexLocker locker(m_mutex);
+        job = takeNextJob();
+    }
+    if (!job)
+        return;
+
+    job->rasterize();
+
+    {
+        MutexLocker locker(m_mutex);
+        job->m_state = TileRasterizationJob::Finished;
+        m_jobFinished.broadcast();
+    }
+
+    // The reference is adopted again in didFinishJob(), so that the job is
+    // always destroyed on the main thread.
+    callOnMainThread(didFinishJob, job.release().leakRef());
+}
+
+void TileRasterizer::didFinishJob(void* context)
+{
+    RefPtr<TileRasterizationJob> job = adoptRef(static_cast<TileRasterizationJob*>(context));
+    if (CoordinatedTile* tile = job->m_tile)
+        tile->didFinishRasterization(job.get());
+}
+
+} // namespace WebCore
+
+#endif // USE(TILED_BACKING_STORE)
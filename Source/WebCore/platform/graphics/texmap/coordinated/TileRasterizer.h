@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TileRasterizer_h
+#define TileRasterizer_h
+
+#if USE(TILED_BACKING_STORE)
+
+#include "CoordinatedSurface.h"
+#include "DisplayList.h"
+#include "IntRect.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class CoordinatedTile;
+
+// Rasterizes the display list of the dirty part of a tile into a surface of
+// its own, on the BackgroundThreadPool. The list and the surface are set up on
+// the main thread and not touched there again until the job has finished,
+// after which the surface is handed to the compositor as it is.
+class TileRasterizationJob : public ThreadSafeRefCounted<TileRasterizationJob>, public CoordinatedSurface::Client {
+public:
+    // |rect| is the dirty rect of the tile, in backing store coordinates. It is
+    // painted at the origin of |surface|, which must be at least as large and
+    // support painting on any thread.
+    static PassRefPtr<TileRasterizationJob> create(CoordinatedTile* tile, PassOwnPtr<DisplayList> displayList, const IntRect& rect, PassRefPtr<CoordinatedSurface> surface)
+    {
+        return adoptRef(new TileRasterizationJob(tile, displayList, rect, surface));
+    }
+    ~TileRasterizationJob();
+
+    const IntRect& rect() const { return m_rect; }
+
+    // Only valid once the job has finished.
+    PassRefPtr<CoordinatedSurface> surface() const { return m_surface; }
+
+    virtual void paintToSurfaceContext(GraphicsContext*) OVERRIDE;
+
+private:
+    friend class TileRasterizer;
+
+    TileRasterizationJob(CoordinatedTile*, PassOwnPtr<DisplayList>, const IntRect&, PassRefPtr<CoordinatedSurface>);
+
+    void rasterize();
+
+    enum State {
+        Pending,
+        Running,
+        Finished
+    };
+
+    CoordinatedTile* m_tile; // Only accessed on the main thread.
+    OwnPtr<DisplayList> m_displayList;
+    IntRect m_rect;
+    RefPtr<CoordinatedSurface> m_surface;
+
+    // Guarded by the rasterizer's mutex.
+    State m_state;
+    double m_priority;
+};
+
+// Schedules tile rasterization on the BackgroundThreadPool, closest to the
+// viewport first. Jobs of tiles that get invalidated or destroyed before their
+// job has run are cancelled. When a job finishes on a background thread, its
+// tile hears about it on the main thread unless the job was cancelled in the
+// meantime.
+class TileRasterizer {
+    WTF_MAKE_NONCOPYABLE(TileRasterizer); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static bool isSupported() { return DisplayList::isSupported(); }
+    static TileRasterizer& shared();
+
+    // Jobs with a lower priority run first.
+    void schedule(PassRefPtr<TileRasterizationJob>, double priority);
+    void setPriority(TileRasterizationJob*, double priority);
+
+    bool isFinished(TileRasterizationJob*);
+
+    // Runs the job on the calling thread unless a background thread has
+    // already picked it up, in which case this waits for that thread to finish it.
+    void waitForJob(TileRasterizationJob*);
+
+    // The tile won't hear back from the job anymore.
+    void cancel(TileRasterizationJob*);
+
+private:
+    TileRasterizer();
+
+    // Called on the background threads, once per scheduled job. Runs the most
+    // urgent job still queued, if any.
+    void runNextJob();
+
+    // Must be called with m_mutex locked.
+    PassRefPtr<TileRasterizationJob> takeNextJob();
+
+    static void didFinishJob(void*);
+
+    Mutex m_mutex; // Guards the members below.
+    ThreadCondition m_jobFinished;
+    Vector<RefPtr<TileRasterizationJob> > m_queue;
+};
+
+} // namespace WebCore
+
+#endif // USE(TILED_BACKING_STORE)
+
+#endif // TileRasterizer_h
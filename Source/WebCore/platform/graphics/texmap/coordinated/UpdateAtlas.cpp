@@ -56,18 +56,45 @@ private:
     bool m_supportsAlpha;
 };
 
+static const int minimumAllocation = 32;
+
+static uint32_t generateUpdateAtlasID()
+{
+    static uint32_t nextID = 0;
+    return ++nextID;
+}
+
 UpdateAtlas::UpdateAtlas(Client* client, int dimension, CoordinatedSurface::Flags flags)
     : m_client(client)
     , m_inactivityInSeconds(0)
+    , m_ID(generateUpdateAtlasID())
 {
-    static uint32_t nextID = 0;
-    m_ID = ++nextID;
     IntSize size = nextPowerOfTwo(IntSize(dimension, dimension));
     m_surface = CoordinatedSurface::create(size, flags);
 
     m_client->createUpdateAtlas(m_ID, m_surface);
 }
 
+UpdateAtlas::UpdateAtlas(Client* client, PassRefPtr<CoordinatedSurface> surface)
+    : m_client(client)
+    , m_surface(surface)
+    , m_inactivityInSeconds(0)
+    , m_ID(generateUpdateAtlasID())
+{
+    ASSERT(size() == adoptableSurfaceSize(size()));
+    m_client->createUpdateAtlas(m_ID, m_surface);
+
+    // An allocation of the whole area always starts at the origin.
+    buildLayoutIfNeeded();
+    IntRect rect = m_areaAllocator->allocate(size());
+    ASSERT_UNUSED(rect, rect.location() == IntPoint::zero());
+}
+
+IntSize UpdateAtlas::adoptableSurfaceSize(const IntSize& size)
+{
+    return nextPowerOfTwo(size.expandedTo(IntSize(minimumAllocation, minimumAllocation)));
+}
+
 UpdateAtlas::~UpdateAtlas()
 {
     if (m_surface)
@@ -78,7 +105,7 @@ void UpdateAtlas::buildLayoutIfNeeded()
 {
     if (!m_areaAllocator) {
         m_areaAllocator = adoptPtr(new GeneralAreaAllocator(size()));
-        m_areaAllocator->setMinimumAllocation(IntSize(32, 32));
+        m_areaAllocator->setMinimumAllocation(IntSize(minimumAllocation, minimumAllocation));
     }
 }
 
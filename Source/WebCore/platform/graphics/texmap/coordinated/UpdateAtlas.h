@@ -41,8 +41,17 @@ public:
     };
 
     UpdateAtlas(Client*, int dimension, CoordinatedSurface::Flags);
+    // Adopts a surface that has already been painted, typically on another
+    // thread, and keeps all of it in use until the next didSwapBuffers().
+    // The surface must be adoptableSurfaceSize().
+    UpdateAtlas(Client*, PassRefPtr<CoordinatedSurface>);
     ~UpdateAtlas();
 
+    // The size of a surface that fits |size| and can be adopted by an atlas.
+    static IntSize adoptableSurfaceSize(const IntSize&);
+
+    uint32_t id() const { return m_ID; }
+
     inline IntSize size() const { return m_surface->size(); }
 
     // Returns false if there is no available buffer.
@@ -138,6 +138,32 @@ ImageDecoder* ImageDecoder::create(const SharedBuffer& data, ImageSource::AlphaO
     return 0;
 }
 
+#if USE(ASYNC_IMAGE_DECODING)
+ImageDecoder* ImageDecoder::createForDecodingThread(const SharedBuffer& data, ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
+{
+    static const unsigned lengthOfLongestSignature = 8; // The PNG signature.
+    char contents[lengthOfLongestSignature];
+    unsigned length = copyFromSharedBuffer(contents, lengthOfLongestSignature, data, 0);
+    if (length < lengthOfLongestSignature)
+        return 0;
+
+    if (matchesGIFSignature(contents))
+        return new GIFImageDecoder(alphaOption, gammaAndColorProfileOption);
+
+#if !PLATFORM(QT) || (PLATFORM(QT) && USE(LIBPNG))
+    if (matchesPNGSignature(contents))
+        return new PNGImageDecoder(alphaOption, gammaAndColorProfileOption);
+#endif
+
+#if !PLATFORM(QT) || (PLATFORM(QT) && USE(LIBJPEG))
+    if (matchesJPEGSignature(contents))
+        return new JPEGImageDecoder(alphaOption, gammaAndColorProfileOption);
+#endif
+
+    return 0;
+}
+#endif
+
 ImageFrame::ImageFrame()
     : m_hasAlpha(false)
     , m_status(FrameEmpty)
@@ -297,7 +323,7 @@ unsigned ImageDecoder::frameBytesAtIndex(size_t index) const
     if (m_frameBufferCache.size() <= index)
         return 0;
     // FIXME: Use the dimension of the requested frame.
-    return m_size.area() * sizeof(ImageFrame::PixelData);
+    return scaledSize().area() * sizeof(ImageFrame::PixelData);
 }
 
 void ImageDecoder::prepareScaleDataIfNecessary()
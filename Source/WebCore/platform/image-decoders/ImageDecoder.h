@@ -217,6 +217,13 @@ namespace WebCore {
         // because there isn't enough data yet).
         static ImageDecoder* create(const SharedBuffer& data, ImageSource::AlphaOption, ImageSource::GammaAndColorProfileOption);
 
+#if USE(ASYNC_IMAGE_DECODING)
+        // Like create(), but only returns WebCore's own GIF, PNG and JPEG decoders.
+        // Those keep no toolkit objects, so they can be created, used and destroyed
+        // on a decoding thread. Returns 0 for anything else.
+        static ImageDecoder* createForDecodingThread(const SharedBuffer& data, ImageSource::AlphaOption, ImageSource::GammaAndColorProfileOption);
+#endif
+
         virtual String filenameExtension() const = 0;
 
         bool isAllDataReceived() const { return m_isAllDataReceived; }
@@ -364,7 +371,7 @@ namespace WebCore {
         // compositing).
         virtual void clearFrameBufferCache(size_t) { }
 
-#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING) || USE(SCALED_IMAGE_DECODING)
         void setMaxNumPixels(int m) { m_maxNumPixels = m; }
 #endif
 
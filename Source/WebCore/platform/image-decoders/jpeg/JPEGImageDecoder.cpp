@@ -68,6 +68,11 @@ inline J_COLOR_SPACE rgbOutputColorSpace() { return JCS_RGB; }
 inline bool colorSpaceHasAlpha(J_COLOR_SPACE) { return false; }
 #endif
 
+#if defined(__SSE2__) && ASSUME_LITTLE_ENDIAN && !defined(TURBO_JPEG_RGB_SWIZZLE)
+#include <emmintrin.h>
+#define SSE2_YCBCR_TO_BGRA
+#endif
+
 #if USE(LOW_QUALITY_IMAGE_NO_JPEG_DITHERING)
 inline J_DCT_METHOD dctMethod() { return JDCT_IFAST; }
 inline J_DITHER_MODE ditherMode() { return JDITHER_NONE; }
@@ -370,7 +375,7 @@ public:
 
             m_decoder->setOrientation(readImageOrientation(info()));
 
-#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING) && defined(TURBO_JPEG_RGB_SWIZZLE)
+#if (ENABLE(IMAGE_DECODER_DOWN_SAMPLING) || USE(SCALED_IMAGE_DECODING)) && defined(TURBO_JPEG_RGB_SWIZZLE)
             // There's no point swizzle decoding if image down sampling will
             // be applied. Revert to using JSC_RGB in that case.
             if (m_decoder->willDownSample() && turboSwizzled(m_info.out_color_space))
@@ -391,6 +396,17 @@ public:
 #endif
             }
 
+#if defined(SSE2_YCBCR_TO_BGRA)
+            // Without libjpeg-turbo's swizzled output, skip libjpeg's color
+            // conversion and convert YCbCr rows ourselves, 8 pixels at a time.
+            if (m_info.jpeg_color_space == JCS_YCbCr && m_info.out_color_space == JCS_RGB && !m_decoder->willDownSample()
+#if USE(QCMSLIB)
+                && !m_transform
+#endif
+                )
+                m_info.out_color_space = JCS_YCbCr;
+#endif
+
             // Don't allocate a giant and superfluous memory buffer when the
             // image is a sequential JPEG.
             m_info.buffered_image = jpeg_has_multiple_scans(&m_info);
@@ -634,6 +650,82 @@ bool JPEGImageDecoder::setFailed()
     return ImageDecoder::setFailed();
 }
 
+#if defined(SSE2_YCBCR_TO_BGRA)
+// JFIF YCbCr to RGB coefficients as in libjpeg's jdcolor.c, in 16.16 fixed
+// point and rounded the same way, so that the output is identical to libjpeg's
+// own RGB output. The factors above 1 are split into a whole and a fractional
+// part so that the fractional part fits into the signed 16 bit operands of
+// _mm_madd_epi16:
+//   R = Y + Cr + ((26345 * Cr + ONE_HALF) >> 16)                (1.40200 = 1 + 26345 / 65536)
+//   G = Y - Cr + ((-22554 * Cb + 18734 * Cr + ONE_HALF) >> 16)  (0.71414 = 1 - 18734 / 65536)
+//   B = Y + 2 * Cb + ((-14942 * Cb + ONE_HALF) >> 16)           (1.77200 = 2 - 14942 / 65536)
+static const int crToR = 26345;
+static const int cbToG = -22554;
+static const int crToG = 18734;
+static const int cbToB = -14942;
+static const int oneHalf = 1 << 15;
+
+static inline unsigned clampToByte(int value)
+{
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+// Computes (cb * cbFactor + cr * crFactor + ONE_HALF) >> 16 for 8 pixels, given
+// the chroma interleaved as Cb, Cr pairs of the low and the high 4 pixels.
+static inline __m128i fractionalChroma(__m128i chromaLow, __m128i chromaHigh, __m128i factors)
+{
+    const __m128i rounding = _mm_set1_epi32(oneHalf);
+    __m128i low = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(chromaLow, factors), rounding), 16);
+    __m128i high = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(chromaHigh, factors), rounding), 16);
+    return _mm_packs_epi32(low, high);
+}
+
+// Converts a row of interleaved YCbCr samples to opaque BGRA pixels, i.e. to
+// ImageFrame::PixelData on a little endian machine.
+static void convertYCbCrToBGRA(const JSAMPLE* source, ImageFrame::PixelData* destination, unsigned width)
+{
+    const __m128i offset = _mm_set1_epi16(128);
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+    const __m128i rFactors = _mm_setr_epi16(0, crToR, 0, crToR, 0, crToR, 0, crToR);
+    const __m128i gFactors = _mm_setr_epi16(cbToG, crToG, cbToG, crToG, cbToG, crToG, cbToG, crToG);
+    const __m128i bFactors = _mm_setr_epi16(cbToB, 0, cbToB, 0, cbToB, 0, cbToB, 0);
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8, source += 24, destination += 8) {
+        __m128i luma = _mm_setr_epi16(source[0], source[3], source[6], source[9], source[12], source[15], source[18], source[21]);
+        __m128i cb = _mm_sub_epi16(_mm_setr_epi16(source[1], source[4], source[7], source[10], source[13], source[16], source[19], source[22]), offset);
+        __m128i cr = _mm_sub_epi16(_mm_setr_epi16(source[2], source[5], source[8], source[11], source[14], source[17], source[20], source[23]), offset);
+        __m128i chromaLow = _mm_unpacklo_epi16(cb, cr);
+        __m128i chromaHigh = _mm_unpackhi_epi16(cb, cr);
+
+        __m128i r = _mm_add_epi16(_mm_add_epi16(luma, cr), fractionalChroma(chromaLow, chromaHigh, rFactors));
+        __m128i g = _mm_add_epi16(_mm_sub_epi16(luma, cr), fractionalChroma(chromaLow, chromaHigh, gFactors));
+        __m128i b = _mm_add_epi16(_mm_add_epi16(luma, _mm_add_epi16(cb, cb)), fractionalChroma(chromaLow, chromaHigh, bFactors));
+
+        // Saturate to bytes and interleave to B, G, R, A.
+        r = _mm_packus_epi16(r, r);
+        g = _mm_packus_epi16(g, g);
+        b = _mm_packus_epi16(b, b);
+        __m128i bg = _mm_unpacklo_epi8(b, g);
+        __m128i ra = _mm_unpacklo_epi8(r, alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 4), _mm_unpackhi_epi16(bg, ra));
+    }
+
+    // Same arithmetic as above for the last few pixels. The right shifts of
+    // negative values are arithmetic, as libjpeg's RIGHT_SHIFT assumes.
+    for (; x < width; ++x, source += 3, ++destination) {
+        int luma = source[0];
+        int cb = source[1] - 128;
+        int cr = source[2] - 128;
+        unsigned r = clampToByte(luma + cr + ((cr * crToR + oneHalf) >> 16));
+        unsigned g = clampToByte(luma - cr + ((cb * cbToG + cr * crToG + oneHalf) >> 16));
+        unsigned b = clampToByte(luma + 2 * cb + ((cb * cbToB + oneHalf) >> 16));
+        *destination = 0xFF000000 | r << 16 | g << 8 | b;
+    }
+}
+#endif
+
 template <J_COLOR_SPACE colorSpace>
 void setPixel(ImageFrame& buffer, ImageFrame::PixelData* currentAddress, JSAMPARRAY samples, int column)
 {
@@ -735,6 +827,20 @@ bool JPEGImageDecoder::outputScanlines()
      }
 #endif
 
+#if defined(SSE2_YCBCR_TO_BGRA)
+    if (info->out_color_space == JCS_YCbCr) {
+        ASSERT(!m_scaled);
+        JSAMPARRAY samples = m_reader->samples();
+        while (info->output_scanline < info->output_height) {
+            int y = info->output_scanline;
+            if (jpeg_read_scanlines(info, samples, 1) != 1)
+                return false;
+            convertYCbCrToBGRA(*samples, buffer.getAddr(0, y), info->output_width);
+        }
+        return true;
+    }
+#endif
+
     switch (info->out_color_space) {
     // The code inside outputScanlines<int, bool> will be executed
     // for each pixel, so we want to avoid any extra comparisons there.
@@ -525,7 +525,7 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
     int width = scaledSize().width();
     unsigned char nonTrivialAlphaMask = 0;
 
-#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING) || USE(SCALED_IMAGE_DECODING)
     if (m_scaled) {
         for (int x = 0; x < width; ++x) {
             png_bytep pixel = row + m_scaledColumns[x] * colorChannels;
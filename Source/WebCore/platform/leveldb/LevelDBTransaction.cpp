@@ -131,13 +131,18 @@ bool LevelDBTransaction::safeGet(const LevelDBSlice& key, Vector<char>& value, b
 }
 
 bool LevelDBTransaction::commit()
+{
+    OwnPtr<LevelDBWriteBatch> writeBatch = takeWriteBatch();
+    return !writeBatch || m_db->write(*writeBatch);
+}
+
+PassOwnPtr<LevelDBWriteBatch> LevelDBTransaction::takeWriteBatch()
 {
     ASSERT(!m_finished);
+    m_finished = true;
 
-    if (m_tree.is_empty()) {
-        m_finished = true;
-        return true;
-    }
+    if (m_tree.is_empty())
+        return nullptr;
 
     OwnPtr<LevelDBWriteBatch> writeBatch = LevelDBWriteBatch::create();
 
@@ -153,12 +158,8 @@ bool LevelDBTransaction::commit()
         ++iterator;
     }
 
-    if (!m_db->write(*writeBatch))
-        return false;
-
     clearTree();
-    m_finished = true;
-    return true;
+    return writeBatch.release();
 }
 
 void LevelDBTransaction::rollback()
@@ -59,6 +59,10 @@ public:
     bool commit();
     void rollback();
 
+    // Finishes the transaction and returns all of its changes as a single
+    // batch, for the caller to write. Returns 0 if nothing was changed.
+    PassOwnPtr<LevelDBWriteBatch> takeWriteBatch();
+
     PassOwnPtr<LevelDBIterator> createIterator();
 
 private:
@@ -0,0 +1,557 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "NetworkDiskCacheQt.h"
+
+#include "CacheValidation.h"
+#include "FileSystem.h"
+#include "KURL.h"
+#include "ResourceResponse.h"
+#include <QBuffer>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/SHA1.h>
+
+namespace WebCore {
+
+static const quint32 entryMagic = 0x574b4345; // "WKCE"
+static const quint32 indexMagic = 0x574b4349; // "WKCI"
+static const qint32 formatVersion = 2;
+
+// Same default as QNetworkDiskCache.
+static const qint64 defaultMaximumCacheSize = 50 * 1024 * 1024;
+
+// Entries are written at most this long after they were inserted, and the index is saved along with them.
+static const int indexSaveDelayInMilliseconds = 1000;
+
+static NetworkDiskCacheQt* s_sharedNetworkDiskCacheQt = 0;
+
+static QByteArray encodedURLForCache(const QUrl& url)
+{
+    return url.toEncoded(QUrl::RemoveFragment);
+}
+
+static uint64_t cacheKey(const QUrl& url)
+{
+    QByteArray encodedURL = encodedURLForCache(url);
+    SHA1 sha1;
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(encodedURL.constData()), encodedURL.size());
+    Vector<uint8_t, 20> digest;
+    sha1.computeHash(digest);
+
+    uint64_t key = 0;
+    for (size_t i = 0; i < sizeof(key); ++i)
+        key = (key << 8) | digest[i];
+    return key;
+}
+
+static QByteArray serializeEntryHeader(const QNetworkCacheMetaData& metaData)
+{
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << entryMagic << formatVersion << metaData.url() << metaData;
+    return header;
+}
+
+// Leaves |device| at the start of the body.
+static bool readEntryHeader(QIODevice* device, QNetworkCacheMetaData& metaData)
+{
+    QDataStream stream(device);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic;
+    qint32 version;
+    QUrl url;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != entryMagic || version != formatVersion)
+        return false;
+    stream >> url >> metaData;
+    return stream.status() == QDataStream::Ok && metaData.url() == url;
+}
+
+static QNetworkCacheMetaData metaDataWithExpirationDate(const QNetworkCacheMetaData& metaData)
+{
+    KURL url(metaData.url());
+    if (!url.protocolIsInHTTPFamily())
+        return metaData;
+
+    ResourceResponse response(url, String(), 0, String(), String());
+    foreach (const QNetworkCacheMetaData::RawHeader& header, metaData.rawHeaders())
+        response.setHTTPHeaderField(String(header.first.constData(), header.first.length()), String(header.second.constData(), header.second.length()));
+
+    double responseTimestamp = currentTime();
+    double freshnessLifetime = computeFreshnessLifetimeForHTTPFamily(response, responseTimestamp);
+    double expirationTime = responseTimestamp + freshnessLifetime - computeCurrentAge(response, responseTimestamp);
+
+    QNetworkCacheMetaData result(metaData);
+    result.setExpirationDate(QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(expirationTime * 1000)));
+    return result;
+}
+
+NetworkDiskCacheQt* NetworkDiskCacheQt::shared()
+{
+    return s_sharedNetworkDiskCacheQt;
+}
+
+NetworkDiskCacheQt* NetworkDiskCacheQt::create(const String& cacheDirectory)
+{
+    if (!s_sharedNetworkDiskCacheQt)
+        s_sharedNetworkDiskCacheQt = new NetworkDiskCacheQt(cacheDirectory);
+
+    return s_sharedNetworkDiskCacheQt;
+}
+
+void NetworkDiskCacheQt::destroy()
+{
+    ASSERT(this == s_sharedNetworkDiskCacheQt);
+    delete s_sharedNetworkDiskCacheQt;
+    s_sharedNetworkDiskCacheQt = 0;
+}
+
+NetworkDiskCacheQt::NetworkDiskCacheQt(const String& cacheDirectory, QObject* parent)
+    : QAbstractNetworkCache(parent)
+    , m_cacheDirectory(cacheDirectory)
+    , m_maximumCacheSize(defaultMaximumCacheSize)
+    , m_cacheSize(0)
+    , m_writerThread(0)
+    , m_lastWriteSequence(0)
+    , m_completedWriteSequence(0)
+{
+    makeAllDirectories(pathByAppendingComponent(cacheDirectory, "entries"));
+    loadIndex();
+}
+
+NetworkDiskCacheQt::~NetworkDiskCacheQt()
+{
+    qDeleteAll(m_preparedEntries.keys());
+
+    if (m_indexSaveTimer.isActive())
+        timerEvent(0);
+
+    // Pending entries are written before the writer thread quits.
+    if (m_writerThread) {
+        postTask(Task::Quit);
+        waitForThreadCompletion(m_writerThread);
+    }
+}
+
+QString NetworkDiskCacheQt::entryPath(uint64_t key) const
+{
+    return m_cacheDirectory + QLatin1String("/entries/") + QString::number(key, 16).rightJustified(16, QLatin1Char('0'));
+}
+
+QString NetworkDiskCacheQt::indexPath() const
+{
+    return m_cacheDirectory + QLatin1String("/index");
+}
+
+void NetworkDiskCacheQt::loadIndex()
+{
+    QFile file(indexPath());
+    bool loaded = false;
+    if (file.open(QIODevice::ReadOnly)) {
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        quint32 magic;
+        qint32 version;
+        quint32 count;
+        stream >> magic >> version >> count;
+        if (stream.status() == QDataStream::Ok && magic == indexMagic && version == formatVersion) {
+            for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+                quint64 key;
+                Entry entry;
+                stream >> key >> entry.bodySize >> entry.header;
+                QBuffer header(&entry.header);
+                header.open(QIODevice::ReadOnly);
+                if (!readEntryHeader(&header, entry.metaData) || cacheKey(entry.metaData.url()) != key)
+                    continue;
+                if (m_entries.add(key, entry).isNewEntry) {
+                    m_entriesByLastUse.add(key);
+                    m_cacheSize += entry.size();
+                }
+            }
+            loaded = stream.status() == QDataStream::Ok;
+        }
+    }
+
+    if (!loaded) {
+        m_entries.clear();
+        m_entriesByLastUse.clear();
+        m_cacheSize = 0;
+        postTask(Task::RemoveAllEntries, m_cacheDirectory + QLatin1String("/entries"));
+        return;
+    }
+
+    // Entries written after the index was last saved are not in it.
+    OwnPtr<Task> task = adoptPtr(new Task);
+    task->type = Task::RemoveUnindexedEntries;
+    task->path = m_cacheDirectory + QLatin1String("/entries");
+    for (EntryMap::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        task->fileNames.append(QFileInfo(entryPath(it->key)).fileName());
+    postTask(task.release());
+}
+
+void NetworkDiskCacheQt::scheduleIndexSave()
+{
+    if (!m_indexSaveTimer.isActive())
+        m_indexSaveTimer.start(indexSaveDelayInMilliseconds, this);
+}
+
+void NetworkDiskCacheQt::timerEvent(QTimerEvent*)
+{
+    m_indexSaveTimer.stop();
+
+    unsigned long long completedWriteSequence;
+    {
+        MutexLocker locker(m_mutex);
+        completedWriteSequence = m_completedWriteSequence;
+    }
+
+    // Entries that have been written are read back from disk from now on.
+    bool hasPendingEntries = false;
+    for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->value.pendingData.isNull())
+            continue;
+        if (it->value.writeSequence <= completedWriteSequence)
+            it->value.pendingData = QByteArray();
+        else
+            hasPendingEntries = true;
+    }
+
+    QByteArray index;
+    QDataStream stream(&index, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << indexMagic << formatVersion << static_cast<quint32>(m_entriesByLastUse.size());
+    for (ListHashSet<uint64_t>::const_iterator it = m_entriesByLastUse.begin(); it != m_entriesByLastUse.end(); ++it) {
+        const Entry& entry = m_entries.find(*it)->value;
+        stream << static_cast<quint64>(*it) << entry.bodySize << entry.header;
+    }
+    postTask(Task::SaveIndex, indexPath(), index);
+
+    if (hasPendingEntries)
+        scheduleIndexSave();
+}
+
+void NetworkDiskCacheQt::setMaximumCacheSize(qint64 size)
+{
+    m_maximumCacheSize = size;
+    evictEntriesIfNeeded();
+}
+
+QNetworkCacheMetaData NetworkDiskCacheQt::metaData(const QUrl& url)
+{
+    EntryMap::const_iterator it = m_entries.find(cacheKey(url));
+    if (it == m_entries.end())
+        return QNetworkCacheMetaData();
+
+    // Another URL with the same key.
+    if (encodedURLForCache(it->value.metaData.url()) != encodedURLForCache(url))
+        return QNetworkCacheMetaData();
+
+    return it->value.metaData;
+}
+
+void NetworkDiskCacheQt::updateMetaData(const QNetworkCacheMetaData& metaData)
+{
+    uint64_t key = cacheKey(metaData.url());
+    EntryMap::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+
+    // A response that was revalidated starts a new freshness lifetime.
+    QNetworkCacheMetaData revalidatedMetaData = metaDataWithExpirationDate(metaData);
+    Entry& entry = it->value;
+    if (!entry.pendingData.isNull()) {
+        // The entry has not been written yet, so it is stored again as a whole.
+        QByteArray body = entry.pendingData.mid(entry.header.size());
+        storeEntry(key, revalidatedMetaData, body);
+        return;
+    }
+
+    QByteArray header = serializeEntryHeader(revalidatedMetaData);
+    m_cacheSize += header.size() - entry.header.size();
+    entry.metaData = revalidatedMetaData;
+    entry.header = header;
+    entry.writeSequence = postTask(Task::RewriteEntryHeader, entryPath(key), header);
+    touchEntry(key);
+}
+
+QIODevice* NetworkDiskCacheQt::data(const QUrl& url)
+{
+    uint64_t key = cacheKey(url);
+    EntryMap::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return 0;
+
+    Entry& entry = it->value;
+    if (encodedURLForCache(entry.metaData.url()) != encodedURLForCache(url))
+        return 0;
+
+    OwnPtr<QBuffer> buffer = adoptPtr(new QBuffer);
+    if (!entry.pendingData.isNull())
+        buffer->setData(entry.pendingData.mid(entry.header.size()));
+    else {
+        // The header on disk may still be the one a pending rewrite replaces, so it is read rather than skipped.
+        QFile* file = new QFile(entryPath(key), buffer.get());
+        QNetworkCacheMetaData metaData;
+        if (!file->open(QIODevice::ReadOnly) || !readEntryHeader(file, metaData)) {
+            removeEntry(key);
+            return 0;
+        }
+
+        // The file is a child of the buffer, so the body stays mapped for as long as the buffer lives.
+        qint64 bodyOffset = file->pos();
+        qint64 bodySize = file->size() - bodyOffset;
+        if (bodySize > 0) {
+            if (uchar* body = file->map(bodyOffset, bodySize))
+                buffer->setData(QByteArray::fromRawData(reinterpret_cast<const char*>(body), bodySize));
+            else
+                buffer->setData(file->readAll());
+        }
+    }
+
+    touchEntry(key);
+    buffer->open(QIODevice::ReadOnly);
+    return buffer.leakPtr();
+}
+
+bool NetworkDiskCacheQt::remove(const QUrl& url)
+{
+    // A prepared entry is removed instead of inserted when its response could not be loaded.
+    QByteArray encodedURL = encodedURLForCache(url);
+    QHash<QIODevice*, QNetworkCacheMetaData>::iterator prepared = m_preparedEntries.begin();
+    while (prepared != m_preparedEntries.end()) {
+        if (encodedURLForCache(prepared.value().url()) == encodedURL) {
+            delete prepared.key();
+            prepared = m_preparedEntries.erase(prepared);
+        } else
+            ++prepared;
+    }
+
+    uint64_t key = cacheKey(url);
+    if (!m_entries.contains(key))
+        return false;
+    removeEntry(key);
+    return true;
+}
+
+QIODevice* NetworkDiskCacheQt::prepare(const QNetworkCacheMetaData& metaData)
+{
+    if (!metaData.isValid() || !metaData.url().isValid() || !metaData.saveToDisk())
+        return 0;
+
+    // Don't let a single response push most of the other entries out.
+    foreach (const QNetworkCacheMetaData::RawHeader& header, metaData.rawHeaders()) {
+        if (!qstricmp(header.first.constData(), "content-length") && header.second.toLongLong() > m_maximumCacheSize / 8)
+            return 0;
+    }
+
+    QBuffer* buffer = new QBuffer;
+    buffer->open(QIODevice::ReadWrite);
+    m_preparedEntries.insert(buffer, metaDataWithExpirationDate(metaData));
+    return buffer;
+}
+
+void NetworkDiskCacheQt::insert(QIODevice* device)
+{
+    QHash<QIODevice*, QNetworkCacheMetaData>::iterator prepared = m_preparedEntries.find(device);
+    if (prepared == m_preparedEntries.end())
+        return;
+
+    QNetworkCacheMetaData metaData = prepared.value();
+    m_preparedEntries.erase(prepared);
+
+    QByteArray body = static_cast<QBuffer*>(device)->data();
+    delete device;
+
+    if (body.size() > m_maximumCacheSize / 8)
+        return;
+
+    storeEntry(cacheKey(metaData.url()), metaData, body);
+}
+
+void NetworkDiskCacheQt::clear()
+{
+    qDeleteAll(m_preparedEntries.keys());
+    m_preparedEntries.clear();
+
+    m_entries.clear();
+    m_entriesByLastUse.clear();
+    m_cacheSize = 0;
+    postTask(Task::RemoveAllEntries, m_cacheDirectory + QLatin1String("/entries"));
+    scheduleIndexSave();
+}
+
+void NetworkDiskCacheQt::storeEntry(uint64_t key, const QNetworkCacheMetaData& metaData, const QByteArray& body)
+{
+    EntryMap::AddResult result = m_entries.add(key, Entry());
+    Entry& entry = result.iterator->value;
+    m_cacheSize -= entry.size();
+
+    entry.metaData = metaData;
+    entry.header = serializeEntryHeader(metaData);
+    entry.bodySize = body.size();
+    entry.pendingData = entry.header + body;
+    entry.writeSequence = postTask(Task::StoreEntry, entryPath(key), entry.pendingData);
+    m_cacheSize += entry.size();
+
+    touchEntry(key);
+    evictEntriesIfNeeded();
+}
+
+void NetworkDiskCacheQt::removeEntry(uint64_t key)
+{
+    EntryMap::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+
+    m_cacheSize -= it->value.size();
+    m_entries.remove(it);
+    m_entriesByLastUse.remove(key);
+    postTask(Task::RemoveEntry, entryPath(key));
+    scheduleIndexSave();
+}
+
+void NetworkDiskCacheQt::touchEntry(uint64_t key)
+{
+    // The index keeps the order in which entries were used across restarts.
+    m_entriesByLastUse.appendOrMoveToLast(key);
+    scheduleIndexSave();
+}
+
+void NetworkDiskCacheQt::evictEntriesIfNeeded()
+{
+    // The entry that was used last is kept even if it is over the budget on its own.
+    while (m_cacheSize > m_maximumCacheSize && m_entriesByLastUse.size() > 1)
+        removeEntry(m_entriesByLastUse.first());
+}
+
+unsigned long long NetworkDiskCacheQt::postTask(Task::Type type, const QString& path, const QByteArray& data)
+{
+    OwnPtr<Task> task = adoptPtr(new Task);
+    task->type = type;
+    task->path = path;
+    task->data = data;
+    return postTask(task.release());
+}
+
+unsigned long long NetworkDiskCacheQt::postTask(PassOwnPtr<Task> task)
+{
+    ASSERT(isMainThread());
+    if (!m_writerThread)
+        m_writerThread = createThread(NetworkDiskCacheQt::writerThreadEntryPointCallback, this, "WebCore: NetworkDiskCache");
+
+    MutexLocker locker(m_mutex);
+    unsigned long long sequence = ++m_lastWriteSequence;
+    task->sequence = sequence;
+    m_tasks.append(task);
+    m_taskAvailable.signal();
+    return sequence;
+}
+
+void NetworkDiskCacheQt::writerThreadEntryPointCallback(void* cache)
+{
+    static_cast<NetworkDiskCacheQt*>(cache)->writerThreadEntryPoint();
+}
+
+void NetworkDiskCacheQt::writerThreadEntryPoint()
+{
+    while (true) {
+        OwnPtr<Task> task;
+        {
+            MutexLocker locker(m_mutex);
+            while (m_tasks.isEmpty())
+                m_taskAvailable.wait(m_mutex);
+            task = m_tasks.takeFirst();
+        }
+
+        if (task->type == Task::Quit)
+            return;
+
+        performTask(*task);
+
+        MutexLocker locker(m_mutex);
+        m_completedWriteSequence = task->sequence;
+    }
+}
+
+void NetworkDiskCacheQt::performTask(const Task& task)
+{
+    switch (task.type) {
+    case Task::StoreEntry:
+    case Task::SaveIndex: {
+        QSaveFile file(task.path);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(task.data);
+            file.commit();
+        }
+        break;
+    }
+    case Task::RewriteEntryHeader: {
+        QFile oldFile(task.path);
+        QNetworkCacheMetaData metaData;
+        if (!oldFile.open(QIODevice::ReadOnly) || !readEntryHeader(&oldFile, metaData))
+            break;
+        QByteArray body = oldFile.readAll();
+        oldFile.close();
+
+        QSaveFile file(task.path);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(task.data);
+            file.write(body);
+            file.commit();
+        }
+        break;
+    }
+    case Task::RemoveEntry:
+        QFile::remove(task.path);
+        break;
+    case Task::RemoveAllEntries:
+    case Task::RemoveUnindexedEntries: {
+        QDir directory(task.path);
+        QSet<QString> indexedFileNames = task.fileNames.toSet();
+        foreach (const QString& fileName, directory.entryList(QDir::Files)) {
+            if (!indexedFileNames.contains(fileName))
+                directory.remove(fileName);
+        }
+        break;
+    }
+    case Task::Quit:
+        ASSERT_NOT_REACHED();
+        break;
+    }
+}
+
+}
+
+#include "moc_NetworkDiskCacheQt.cpp"
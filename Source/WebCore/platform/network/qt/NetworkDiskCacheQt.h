@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NetworkDiskCacheQt_h
+#define NetworkDiskCacheQt_h
+
+#include <QAbstractNetworkCache>
+#include <QBasicTimer>
+#include <QHash>
+#include <QStringList>
+#include <wtf/Deque.h>
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/Threading.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+// The disk cache beneath the memory cache. Responses are kept in one file per
+// URL, with the headers in front of the body, and bodies are memory mapped
+// when they are read back. An index of the entries and their headers, in least
+// recently used order, is loaded when the cache is created so that lookups
+// don't touch the disk, and the least recently used entries are evicted once
+// the cache grows beyond its maximum size.
+//
+// Entries are written, rewritten and removed on a background thread. Until an
+// entry has been written, it is served from memory.
+//
+// Freshness is computed with the same rules as the memory cache, see
+// CacheValidation.h, and handed to QNetworkAccessManager as the expiration date
+// of the entry; validation of stale entries is left to QNetworkAccessManager.
+class NetworkDiskCacheQt : public QAbstractNetworkCache {
+    Q_OBJECT
+    Q_PROPERTY(qint64 maximumCacheSize READ maximumCacheSize WRITE setMaximumCacheSize)
+public:
+    static NetworkDiskCacheQt* shared();
+    static NetworkDiskCacheQt* create(const String& cacheDirectory);
+    void destroy();
+
+    explicit NetworkDiskCacheQt(const String& cacheDirectory, QObject* parent = 0);
+    ~NetworkDiskCacheQt();
+
+    QString cacheDirectory() const { return m_cacheDirectory; }
+
+    qint64 maximumCacheSize() const { return m_maximumCacheSize; }
+    void setMaximumCacheSize(qint64);
+
+    virtual QNetworkCacheMetaData metaData(const QUrl&) OVERRIDE;
+    virtual void updateMetaData(const QNetworkCacheMetaData&) OVERRIDE;
+    virtual QIODevice* data(const QUrl&) OVERRIDE;
+    virtual bool remove(const QUrl&) OVERRIDE;
+    virtual qint64 cacheSize() const OVERRIDE { return m_cacheSize; }
+    virtual QIODevice* prepare(const QNetworkCacheMetaData&) OVERRIDE;
+    virtual void insert(QIODevice*) OVERRIDE;
+
+public Q_SLOTS:
+    virtual void clear() OVERRIDE;
+
+private:
+    struct Entry {
+        Entry()
+            : bodySize(0)
+            , writeSequence(0)
+        {
+        }
+
+        qint64 size() const { return header.size() + bodySize; }
+
+        // The header is kept serialized for the index, and parsed for metaData().
+        QNetworkCacheMetaData metaData;
+        QByteArray header;
+        qint64 bodySize;
+
+        // The contents of the entry file until the writer thread has written it.
+        QByteArray pendingData;
+        unsigned long long writeSequence;
+    };
+
+    struct Task {
+        enum Type {
+            StoreEntry,
+            RewriteEntryHeader,
+            RemoveEntry,
+            RemoveAllEntries,
+            RemoveUnindexedEntries,
+            SaveIndex,
+            Quit
+        };
+
+        Type type;
+        QString path;
+        QByteArray data;
+        QStringList fileNames;
+        unsigned long long sequence;
+    };
+
+    typedef HashMap<uint64_t, Entry, IntHash<uint64_t>, WTF::UnsignedWithZeroKeyHashTraits<uint64_t> > EntryMap;
+
+    QString entryPath(uint64_t key) const;
+    QString indexPath() const;
+
+    void loadIndex();
+    void scheduleIndexSave();
+    virtual void timerEvent(QTimerEvent*) OVERRIDE;
+
+    void storeEntry(uint64_t key, const QNetworkCacheMetaData&, const QByteArray& body);
+    void removeEntry(uint64_t key);
+    void touchEntry(uint64_t key);
+    void evictEntriesIfNeeded();
+
+    unsigned long long postTask(Task::Type, const QString& path = QString(), const QByteArray& data = QByteArray());
+    unsigned long long postTask(PassOwnPtr<Task>);
+
+    // Called on the writer thread.
+    static void writerThreadEntryPointCallback(void*);
+    void writerThreadEntryPoint();
+    static void performTask(const Task&);
+
+    QString m_cacheDirectory;
+    qint64 m_maximumCacheSize;
+    qint64 m_cacheSize;
+
+    EntryMap m_entries;
+    ListHashSet<uint64_t> m_entriesByLastUse;
+    QHash<QIODevice*, QNetworkCacheMetaData> m_preparedEntries;
+    QBasicTimer m_indexSaveTimer;
+
+    ThreadIdentifier m_writerThread;
+    unsigned long long m_lastWriteSequence;
+
+    Mutex m_mutex; // Guards the members below.
+    ThreadCondition m_taskAvailable;
+    Deque<OwnPtr<Task> > m_tasks;
+    unsigned long long m_completedWriteSequence;
+};
+
+}
+
+#endif // NetworkDiskCacheQt_h
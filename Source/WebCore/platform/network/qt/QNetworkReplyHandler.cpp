@@ -30,6 +30,7 @@
 #include "ResourceHandleInternal.h"
 #include "ResourceRequest.h"
 #include "ResourceResponse.h"
+#include "SharedBuffer.h"
 #include <QDateTime>
 #include <QFile>
 #include <QFileInfo>
@@ -43,6 +44,12 @@
 
 static const int gMaxRedirections = 10;
 
+// How much a reply may buffer before the network thread stops reading from the socket.
+static const qint64 maximumBufferedDataSize = 4 * 1024 * 1024;
+static const qint64 maximumBufferedDataSizeWhileDeferred = 256 * 1024;
+// The largest buffer handed to the client in a single callback.
+static const qint64 maximumForwardedDataSize = 1024 * 1024;
+
 namespace WebCore {
 
 FormDataIODevice::FormDataIODevice(FormData* data)
@@ -272,6 +279,7 @@ QNetworkReplyWrapper::QNetworkReplyWrapper(QNetworkReplyHandlerCallQueue* queue,
     , m_queue(queue)
     , m_responseContainsData(false)
     , m_sniffMIMETypes(sniffMIMETypes)
+    , m_forwardDataScheduled(false)
 {
     Q_ASSERT(m_reply);
 
@@ -405,13 +413,33 @@ void QNetworkReplyWrapper::didReceiveReadyRead()
 {
     if (m_reply->bytesAvailable())
         m_responseContainsData = true;
+
+    // The reply is filled on Qt's network thread, and each chunk it reads posts its own
+    // readyRead() to the main thread. Everything that arrived by the time the posted call
+    // runs, including what came in while the main thread was busy, goes out in one batch.
+    if (m_forwardDataScheduled)
+        return;
+    m_forwardDataScheduled = true;
+    QMetaObject::invokeMethod(this, "forwardReadyData", Qt::QueuedConnection);
+}
+
+void QNetworkReplyWrapper::forwardReadyData()
+{
+    m_forwardDataScheduled = false;
     m_queue->push(&QNetworkReplyHandler::forwardData);
 }
 
 void QNetworkReplyWrapper::didReceiveFinished()
 {
     // Disconnecting will make sure that nothing will happen after emitting the finished signal.
+    // This also drops a pending forwardReadyData(), so that data is forwarded here instead.
     stopForwarding();
+
+    QueueLocker lock(m_queue);
+    if (m_forwardDataScheduled) {
+        m_forwardDataScheduled = false;
+        m_queue->push(&QNetworkReplyHandler::forwardData);
+    }
     m_queue->push(&QNetworkReplyHandler::finish);
 }
 
@@ -473,6 +501,22 @@ void QNetworkReplyHandler::abort()
     deleteLater();
 }
 
+void QNetworkReplyHandler::setLoadingDeferred(bool deferred)
+{
+    m_queue.setDeferSignals(deferred, m_loadType == SynchronousLoad);
+    updateReadBufferSize();
+}
+
+void QNetworkReplyHandler::updateReadBufferSize()
+{
+    // Only the main thread takes data out of a reply, while Qt's network thread keeps
+    // filling it. Bounding the buffer makes the network thread stop reading from the
+    // socket once the main thread falls behind, and early when loading is deferred.
+    if (m_loadType == SynchronousLoad || !m_replyWrapper || !m_replyWrapper->reply())
+        return;
+    m_replyWrapper->reply()->setReadBufferSize(m_queue.deferSignals() ? maximumBufferedDataSizeWhileDeferred : maximumBufferedDataSize);
+}
+
 QNetworkReply* QNetworkReplyHandler::release()
 {
     if (!m_replyWrapper)
@@ -677,21 +721,23 @@ void QNetworkReplyHandler::forwardData()
         return;
 
     qint64 bytesAvailable = m_replyWrapper->reply()->bytesAvailable();
-    char* buffer = new char[8128]; // smaller than 8192 to fit within 8k including overhead.
     while (bytesAvailable > 0 && !m_queue.deferSignals()) {
-        qint64 readSize = m_replyWrapper->reply()->read(buffer, 8128);
+        // Everything the reply has buffered is read into one buffer of that size, which
+        // the resource data adopts as is when it is the first to arrive.
+        Vector<char> data(std::min(bytesAvailable, maximumForwardedDataSize));
+        qint64 readSize = m_replyWrapper->reply()->read(data.data(), data.size());
         if (readSize <= 0)
             break;
+        data.shrink(readSize);
         bytesAvailable -= readSize;
         // FIXME: https://bugs.webkit.org/show_bug.cgi?id=19793
         // -1 means we do not provide any data about transfer size to inspector so it would use
         // Content-Length headers or content size to show transfer size.
-        client->didReceiveData(m_resourceHandle, buffer, readSize, -1);
+        client->didReceiveBuffer(m_resourceHandle, SharedBuffer::adoptVector(data), -1);
         // Check if the request has been aborted or this reply-handler was otherwise released.
         if (wasAborted() || !m_replyWrapper)
             break;
     }
-    delete[] buffer;
     if (bytesAvailable > 0 && m_replyWrapper)
         m_queue.requeue(&QNetworkReplyHandler::forwardData);
 }
@@ -803,6 +849,8 @@ void QNetworkReplyHandler::start()
         return;
     }
 
+    updateReadBufferSize();
+
     double timeoutInSeconds = d->m_firstRequest.timeoutInterval();
     if (timeoutInSeconds > 0 && timeoutInSeconds < (INT_MAX / 1000))
         m_timeoutTimer.start(timeoutInSeconds * 1000, this);
@@ -93,6 +93,7 @@ private Q_SLOTS:
     void receiveMetaData();
     void didReceiveFinished();
     void didReceiveReadyRead();
+    void forwardReadyData();
     void receiveSniffedMIMEType();
     void setFinished();
     void replyDestroyed();
@@ -113,6 +114,7 @@ private:
     QString m_sniffedMIMEType;
     OwnPtr<QtMIMETypeSniffer> m_sniffer;
     bool m_sniffMIMETypes;
+    bool m_forwardDataScheduled;
 };
 
 class QNetworkReplyHandler : public QObject
@@ -125,7 +127,7 @@ public:
     };
 
     QNetworkReplyHandler(ResourceHandle*, LoadType, bool deferred = false);
-    void setLoadingDeferred(bool deferred) { m_queue.setDeferSignals(deferred, m_loadType == SynchronousLoad); }
+    void setLoadingDeferred(bool);
 
     QNetworkReply* reply() const { return m_replyWrapper ? m_replyWrapper->reply() : 0; }
 
@@ -146,6 +148,7 @@ private:
     void start();
     String httpMethod() const;
     void redirect(ResourceResponse&, const QUrl&);
+    void updateReadBufferSize();
     bool wasAborted() const { return !m_resourceHandle; }
     QNetworkReply* sendNetworkRequest(QNetworkAccessManager*, const ResourceRequest&);
     FormDataIODevice* getIODevice(const ResourceRequest&);
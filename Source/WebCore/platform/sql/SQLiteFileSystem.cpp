@@ -109,6 +109,10 @@ bool SQLiteFileSystem::deleteEmptyDatabaseDirectory(const String& path)
 
 bool SQLiteFileSystem::deleteDatabaseFile(const String& fileName)
 {
+    // Databases in write-ahead logging mode leave the log and its index next to the
+    // database file if they were not closed cleanly.
+    deleteFile(fileName + "-wal");
+    deleteFile(fileName + "-shm");
     return deleteFile(fileName);
 }
 
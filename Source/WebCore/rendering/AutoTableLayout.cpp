@@ -25,6 +25,7 @@
 #include "RenderTable.h"
 #include "RenderTableCell.h"
 #include "RenderTableCol.h"
+#include "RenderTableRow.h"
 #include "RenderTableSection.h"
 
 using namespace std;
@@ -35,6 +36,7 @@ AutoTableLayout::AutoTableLayout(RenderTable* table)
     : TableLayout(table)
     , m_hasPercent(false)
     , m_effectiveLogicalWidthDirty(true)
+    , m_columnDataValid(false)
 {
 }
 
@@ -42,99 +44,127 @@ AutoTableLayout::~AutoTableLayout()
 {
 }
 
-void AutoTableLayout::recalcColumn(unsigned effCol)
+static bool cellHasContent(RenderTableCell* cell)
 {
-    Layout& columnLayout = m_layoutStruct[effCol];
-
-    RenderTableCell* fixedContributor = 0;
-    RenderTableCell* maxContributor = 0;
+    return cell->children()->firstChild() || cell->style()->hasBorder() || cell->style()->hasPadding();
+}
 
-    for (RenderObject* child = m_table->children()->firstChild(); child; child = child->nextSibling()) {
-        if (child->isRenderTableCol()){
-            // RenderTableCols don't have the concept of preferred logical width, but we need to clear their dirty bits
-            // so that if we call setPreferredWidthsDirty(true) on a col or one of its descendants, we'll mark it's
-            // ancestors as dirty.
+static void clearColumnPreferredLogicalWidthsDirtyBits(RenderTable* table)
+{
+    // RenderTableCols don't have the concept of preferred logical width, but we need to clear their dirty bits
+    // so that if we call setPreferredWidthsDirty(true) on a col or one of its descendants, we'll mark it's
+    // ancestors as dirty.
+    for (RenderObject* child = table->children()->firstChild(); child; child = child->nextSibling()) {
+        if (child->isRenderTableCol())
             toRenderTableCol(child)->clearPreferredLogicalWidthsDirtyBits();
-        } else if (child->isTableSection()) {
-            RenderTableSection* section = toRenderTableSection(child);
-            unsigned numRows = section->numRows();
-            for (unsigned i = 0; i < numRows; i++) {
-                RenderTableSection::CellStruct current = section->cellAt(i, effCol);
-                RenderTableCell* cell = current.primaryCell();
-                
-                if (current.inColSpan || !cell)
-                    continue;
-
-                bool cellHasContent = cell->children()->firstChild() || cell->style()->hasBorder() || cell->style()->hasPadding();
-                if (cellHasContent)
-                    columnLayout.emptyCellsOnly = false;
-
-                // A cell originates in this column. Ensure we have
-                // a min/max width of at least 1px for this column now.
-                columnLayout.minLogicalWidth = max<int>(columnLayout.minLogicalWidth, cellHasContent ? 1 : 0);
-                columnLayout.maxLogicalWidth = max<int>(columnLayout.maxLogicalWidth, 1);
-
-                if (cell->colSpan() == 1) {
-                    columnLayout.minLogicalWidth = max<int>(cell->minPreferredLogicalWidth(), columnLayout.minLogicalWidth);
-                    if (cell->maxPreferredLogicalWidth() > columnLayout.maxLogicalWidth) {
-                        columnLayout.maxLogicalWidth = cell->maxPreferredLogicalWidth();
-                        maxContributor = cell;
-                    }
+    }
+}
 
-                    // All browsers implement a size limit on the cell's max width. 
-                    // Our limit is based on KHTML's representation that used 16 bits widths.
-                    // FIXME: Other browsers have a lower limit for the cell's max width. 
-                    const int cCellMaxWidth = 32760;
-                    Length cellLogicalWidth = cell->styleOrColLogicalWidth();
-                    if (cellLogicalWidth.value() > cCellMaxWidth)
-                        cellLogicalWidth.setValue(cCellMaxWidth);
-                    if (cellLogicalWidth.isNegative())
-                        cellLogicalWidth.setValue(0);
-                    switch (cellLogicalWidth.type()) {
-                    case Fixed:
-                        // ignore width=0
-                        if (cellLogicalWidth.isPositive() && !columnLayout.logicalWidth.isPercent()) {
-                            int logicalWidth = cell->adjustBorderBoxLogicalWidthForBoxSizing(cellLogicalWidth.value());
-                            if (columnLayout.logicalWidth.isFixed()) {
-                                // Nav/IE weirdness
-                                if ((logicalWidth > columnLayout.logicalWidth.value()) 
-                                    || ((columnLayout.logicalWidth.value() == logicalWidth) && (maxContributor == cell))) {
-                                    columnLayout.logicalWidth.setValue(Fixed, logicalWidth);
-                                    fixedContributor = cell;
-                                }
-                            } else {
-                                columnLayout.logicalWidth.setValue(Fixed, logicalWidth);
-                                fixedContributor = cell;
-                            }
-                        }
-                        break;
-                    case Percent:
-                        m_hasPercent = true;
-                        if (cellLogicalWidth.isPositive() && (!columnLayout.logicalWidth.isPercent() || cellLogicalWidth.value() > columnLayout.logicalWidth.value()))
-                            columnLayout.logicalWidth = cellLogicalWidth;
-                        break;
-                    case Relative:
-                        // FIXME: Need to understand this case and whether it makes sense to compare values
-                        // which are not necessarily of the same type.
-                        if (cellLogicalWidth.value() > columnLayout.logicalWidth.value())
-                            columnLayout.logicalWidth = cellLogicalWidth;
-                    default:
-                        break;
-                    }
-                } else if (!effCol || section->primaryCellAt(i, effCol - 1) != cell) {
-                    // This spanning cell originates in this column. Insert the cell into spanning cells list.
-                    insertSpanCell(cell);
+void AutoTableLayout::addCellToColumn(ColumnCellData& columnData, RenderTableCell* cell)
+{
+    bool hasContent = cellHasContent(cell);
+    if (hasContent)
+        ++columnData.contentCellCount;
+
+    // A cell originates in this column. Ensure we have
+    // a min/max width of at least 1px for this column now.
+    columnData.minLogicalWidth = max<int>(columnData.minLogicalWidth, hasContent ? 1 : 0);
+    columnData.maxLogicalWidth = max<int>(columnData.maxLogicalWidth, 1);
+
+    if (cell->colSpan() != 1)
+        return;
+
+    columnData.minLogicalWidth = max<int>(cell->minPreferredLogicalWidth(), columnData.minLogicalWidth);
+    if (cell->maxPreferredLogicalWidth() > columnData.maxLogicalWidth) {
+        columnData.maxLogicalWidth = cell->maxPreferredLogicalWidth();
+        columnData.maxContributor = cell;
+    }
+
+    // All browsers implement a size limit on the cell's max width. 
+    // Our limit is based on KHTML's representation that used 16 bits widths.
+    // FIXME: Other browsers have a lower limit for the cell's max width. 
+    const int cCellMaxWidth = 32760;
+    Length cellLogicalWidth = cell->styleOrColLogicalWidth();
+    if (cellLogicalWidth.value() > cCellMaxWidth)
+        cellLogicalWidth.setValue(cCellMaxWidth);
+    if (cellLogicalWidth.isNegative())
+        cellLogicalWidth.setValue(0);
+    switch (cellLogicalWidth.type()) {
+    case Fixed:
+        // ignore width=0
+        if (cellLogicalWidth.isPositive() && !columnData.logicalWidth.isPercent()) {
+            int logicalWidth = cell->adjustBorderBoxLogicalWidthForBoxSizing(cellLogicalWidth.value());
+            if (columnData.logicalWidth.isFixed()) {
+                // Nav/IE weirdness
+                if ((logicalWidth > columnData.logicalWidth.value()) 
+                    || ((columnData.logicalWidth.value() == logicalWidth) && (columnData.maxContributor == cell))) {
+                    columnData.logicalWidth.setValue(Fixed, logicalWidth);
+                    columnData.fixedContributor = cell;
                 }
+            } else {
+                columnData.logicalWidth.setValue(Fixed, logicalWidth);
+                columnData.fixedContributor = cell;
             }
         }
+        break;
+    case Percent:
+        m_hasPercent = true;
+        if (cellLogicalWidth.isPositive() && (!columnData.logicalWidth.isPercent() || cellLogicalWidth.value() > columnData.logicalWidth.value()))
+            columnData.logicalWidth = cellLogicalWidth;
+        break;
+    case Relative:
+        // FIXME: Need to understand this case and whether it makes sense to compare values
+        // which are not necessarily of the same type.
+        if (cellLogicalWidth.value() > columnData.logicalWidth.value())
+            columnData.logicalWidth = cellLogicalWidth;
+    default:
+        break;
     }
+}
+
+void AutoTableLayout::addGridSlotToColumn(unsigned effCol, RenderTableSection* section, unsigned row)
+{
+    RenderTableSection::CellStruct current = section->cellAt(row, effCol);
+    RenderTableCell* cell = current.primaryCell();
+
+    if (current.inColSpan || !cell)
+        return;
+
+    addCellToColumn(m_columnCellData[effCol], cell);
+
+    // This spanning cell originates in this column. Insert the cell into spanning cells list.
+    if (cell->colSpan() != 1 && (!effCol || section->primaryCellAt(row, effCol - 1) != cell))
+        insertSpanCell(cell);
+}
+
+void AutoTableLayout::recalcColumn(unsigned effCol)
+{
+    for (RenderObject* child = m_table->children()->firstChild(); child; child = child->nextSibling()) {
+        if (!child->isTableSection())
+            continue;
+
+        RenderTableSection* section = toRenderTableSection(child);
+        unsigned numRows = section->numRows();
+        for (unsigned i = 0; i < numRows; i++)
+            addGridSlotToColumn(effCol, section, i);
+    }
+}
+
+void AutoTableLayout::computeColumnLayout(unsigned effCol)
+{
+    const ColumnCellData& columnData = m_columnCellData[effCol];
+    Layout& columnLayout = m_layoutStruct[effCol];
+
+    columnLayout = Layout();
+    columnLayout.logicalWidth = columnData.logicalWidth;
+    columnLayout.minLogicalWidth = columnData.minLogicalWidth;
+    columnLayout.maxLogicalWidth = columnData.maxLogicalWidth;
+    columnLayout.emptyCellsOnly = !columnData.contentCellCount;
 
     // Nav/IE weirdness
     if (columnLayout.logicalWidth.isFixed()) {
-        if (m_table->document()->inQuirksMode() && columnLayout.maxLogicalWidth > columnLayout.logicalWidth.value() && fixedContributor != maxContributor) {
+        if (m_table->document()->inQuirksMode() && columnLayout.maxLogicalWidth > columnLayout.logicalWidth.value() && columnData.fixedContributor != columnData.maxContributor)
             columnLayout.logicalWidth = Length();
-            fixedContributor = 0;
-        }
     }
 
     columnLayout.maxLogicalWidth = max(columnLayout.maxLogicalWidth, columnLayout.minLogicalWidth);
@@ -143,11 +173,10 @@ void AutoTableLayout::recalcColumn(unsigned effCol)
 void AutoTableLayout::fullRecalc()
 {
     m_hasPercent = false;
-    m_effectiveLogicalWidthDirty = true;
 
     unsigned nEffCols = m_table->numEffCols();
-    m_layoutStruct.resize(nEffCols);
-    m_layoutStruct.fill(Layout());
+    m_columnCellData.resize(nEffCols);
+    m_columnCellData.fill(ColumnCellData());
     m_spanCells.fill(0);
 
     Length groupLogicalWidth;
@@ -164,9 +193,9 @@ void AutoTableLayout::fullRecalc()
             unsigned effCol = m_table->colToEffCol(currentColumn);
             unsigned span = column->span();
             if (!colLogicalWidth.isAuto() && span == 1 && effCol < nEffCols && m_table->spanOfEffCol(effCol) == 1) {
-                m_layoutStruct[effCol].logicalWidth = colLogicalWidth;
-                if (colLogicalWidth.isFixed() && m_layoutStruct[effCol].maxLogicalWidth < colLogicalWidth.value())
-                    m_layoutStruct[effCol].maxLogicalWidth = colLogicalWidth.value();
+                m_columnCellData[effCol].logicalWidth = colLogicalWidth;
+                if (colLogicalWidth.isFixed() && m_columnCellData[effCol].maxLogicalWidth < colLogicalWidth.value())
+                    m_columnCellData[effCol].maxLogicalWidth = colLogicalWidth.value();
             }
             currentColumn += span;
         }
@@ -178,6 +207,170 @@ void AutoTableLayout::fullRecalc()
 
     for (unsigned i = 0; i < nEffCols; i++)
         recalcColumn(i);
+
+    m_pendingRows.clear();
+    m_pendingCells.clear();
+    m_columnDataValid = true;
+}
+
+bool AutoTableLayout::updateColumnData()
+{
+    unsigned nEffCols = m_table->numEffCols();
+    if (!m_columnDataValid || m_columnCellData.size() != nEffCols)
+        return false;
+
+    // New spanning cells would have to be inserted into m_spanCells in the order fullRecalc() uses.
+    for (ListHashSet<RenderTableRow*>::iterator it = m_pendingRows.begin(); it != m_pendingRows.end(); ++it) {
+        if (!(*it)->section())
+            return false;
+        for (RenderObject* child = (*it)->firstChild(); child; child = child->nextSibling()) {
+            if (child->isTableCell() && toRenderTableCell(child)->colSpan() != 1)
+                return false;
+        }
+    }
+
+    if (m_pendingRows.isEmpty() && m_pendingCells.isEmpty())
+        return true;
+
+    // Changed cells come before the appended rows in the order fullRecalc() visits cells, but not
+    // necessarily in the same order among themselves. fullRecalc() makes the first cell with the
+    // largest max width the column's max contributor, so a changed cell that ties with that width,
+    // or that brings a width of its own, has to go through the full recalc to break ties the same way.
+    for (ListHashSet<RenderTableCell*>::iterator it = m_pendingCells.begin(); it != m_pendingCells.end(); ++it) {
+        RenderTableCell* cell = *it;
+        unsigned effCol = m_table->colToEffCol(cell->col());
+        if (effCol >= nEffCols)
+            return false;
+        ColumnCellData& columnData = m_columnCellData[effCol];
+        if (!cell->styleOrColLogicalWidth().isAuto() || cell->maxPreferredLogicalWidth() == columnData.maxLogicalWidth)
+            return false;
+        addCellToColumn(columnData, cell);
+    }
+
+    for (unsigned effCol = 0; effCol < nEffCols; ++effCol) {
+        for (ListHashSet<RenderTableRow*>::iterator it = m_pendingRows.begin(); it != m_pendingRows.end(); ++it)
+            addGridSlotToColumn(effCol, (*it)->section(), (*it)->rowIndex());
+    }
+
+    m_pendingRows.clear();
+    m_pendingCells.clear();
+    return true;
+}
+
+void AutoTableLayout::recalcColumnData()
+{
+    clearColumnPreferredLogicalWidthsDirtyBits(m_table);
+
+    if (!updateColumnData())
+        fullRecalc();
+
+    m_layoutStruct.resize(m_columnCellData.size());
+    for (unsigned i = 0; i < m_columnCellData.size(); ++i)
+        computeColumnLayout(i);
+    m_effectiveLogicalWidthDirty = true;
+}
+
+void AutoTableLayout::invalidateColumnData()
+{
+    m_columnDataValid = false;
+    m_pendingRows.clear();
+    m_pendingCells.clear();
+}
+
+void AutoTableLayout::rowWasAppended(RenderTableRow* row)
+{
+    if (!m_columnDataValid)
+        return;
+
+    // Appended rows can only be added to the column data if fullRecalc() would visit them after
+    // every row we have already seen.
+    for (RenderObject* sibling = row->section()->nextSibling(); sibling; sibling = sibling->nextSibling()) {
+        if (sibling->isTableSection()) {
+            invalidateColumnData();
+            return;
+        }
+    }
+
+    m_pendingRows.add(row);
+}
+
+void AutoTableLayout::rowWillBeRemoved(RenderTableRow* row)
+{
+    if (m_pendingRows.contains(row)) {
+        m_pendingRows.remove(row);
+        return;
+    }
+
+    // Cells are normally removed one by one before their row, but not when the row itself is
+    // taken out of the tree.
+    for (RenderObject* child = row->firstChild(); child; child = child->nextSibling()) {
+        if (child->isTableCell())
+            cellWillBeRemoved(toRenderTableCell(child));
+    }
+}
+
+void AutoTableLayout::removeCellFromColumn(RenderTableCell* cell)
+{
+    if (!m_columnDataValid)
+        return;
+
+    // The cell's contribution can only be taken out of the column data if the column's widths do not depend on it,
+    // i.e. if removing it cannot shrink anything.
+    if (!cell->everHadLayout() || cell->preferredLogicalWidthsDirty() || cell->colSpan() != 1 || cell->rowSpan() != 1) {
+        invalidateColumnData();
+        return;
+    }
+
+    unsigned effCol = m_table->colToEffCol(cell->col());
+    if (effCol >= m_columnCellData.size()) {
+        invalidateColumnData();
+        return;
+    }
+
+    ColumnCellData& columnData = m_columnCellData[effCol];
+    bool hasContent = cellHasContent(cell);
+    if (!columnData.logicalWidth.isAuto() || !cell->styleOrColLogicalWidth().isAuto()
+        || cell == columnData.maxContributor || cell == columnData.fixedContributor
+        || cell->minPreferredLogicalWidth() >= columnData.minLogicalWidth
+        || cell->maxPreferredLogicalWidth() >= columnData.maxLogicalWidth
+        || (hasContent && columnData.contentCellCount <= 1)) {
+        invalidateColumnData();
+        return;
+    }
+
+    if (hasContent)
+        --columnData.contentCellCount;
+}
+
+void AutoTableLayout::cellWillBeRemoved(RenderTableCell* cell)
+{
+    if (m_pendingRows.contains(cell->row()))
+        return;
+
+    // A changed cell's old contribution has already been taken out.
+    if (m_pendingCells.contains(cell)) {
+        m_pendingCells.remove(cell);
+        return;
+    }
+
+    removeCellFromColumn(cell);
+}
+
+void AutoTableLayout::cellPreferredLogicalWidthsWillChange(RenderTableCell* cell)
+{
+    if (!m_columnDataValid || m_pendingRows.contains(cell->row()) || m_pendingCells.contains(cell))
+        return;
+
+    // A cell that has never been laid out was added to a row we have already seen.
+    if (!cell->everHadLayout()) {
+        invalidateColumnData();
+        return;
+    }
+
+    // Take the old widths out now, while they are still cached, and add the new ones on the next update.
+    removeCellFromColumn(cell);
+    if (m_columnDataValid)
+        m_pendingCells.add(cell);
 }
 
 // FIXME: This needs to be adapted for vertical writing modes.
@@ -212,7 +405,7 @@ static bool shouldScaleColumns(RenderTable* table)
 
 void AutoTableLayout::computeIntrinsicLogicalWidths(LayoutUnit& minWidth, LayoutUnit& maxWidth)
 {
-    fullRecalc();
+    recalcColumnData();
 
     int spanMaxLogicalWidth = calcEffectiveLogicalWidth();
     minWidth = 0;
@@ -487,7 +680,8 @@ void AutoTableLayout::layout()
     // FIXME: It is possible to be called without having properly updated our internal representation.
     // This means that our preferred logical widths were not recomputed as expected.
     if (nEffCols != m_layoutStruct.size()) {
-        fullRecalc();
+        invalidateColumnData();
+        recalcColumnData();
         // FIXME: Table layout shouldn't modify our table structure (but does due to columns and column-groups).
         nEffCols = m_table->numEffCols();
     }
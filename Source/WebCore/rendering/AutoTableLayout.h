@@ -24,12 +24,15 @@
 #include "LayoutUnit.h"
 #include "Length.h"
 #include "TableLayout.h"
+#include <wtf/ListHashSet.h>
 #include <wtf/Vector.h>
 
 namespace WebCore {
 
 class RenderTable;
 class RenderTableCell;
+class RenderTableRow;
+class RenderTableSection;
 
 class AutoTableLayout : public TableLayout {
 public:
@@ -40,9 +43,23 @@ public:
     virtual void applyPreferredLogicalWidthQuirks(LayoutUnit& minWidth, LayoutUnit& maxWidth) const OVERRIDE;
     virtual void layout();
 
+    virtual void rowWasAppended(RenderTableRow*) OVERRIDE;
+    virtual void rowWillBeRemoved(RenderTableRow*) OVERRIDE;
+    virtual void cellWillBeRemoved(RenderTableCell*) OVERRIDE;
+    virtual void cellPreferredLogicalWidthsWillChange(RenderTableCell*) OVERRIDE;
+    virtual void invalidateColumnData() OVERRIDE;
+
 private:
+    struct ColumnCellData;
+
+    void recalcColumnData();
+    bool updateColumnData();
     void fullRecalc();
     void recalcColumn(unsigned effCol);
+    void addGridSlotToColumn(unsigned effCol, RenderTableSection*, unsigned row);
+    void addCellToColumn(ColumnCellData&, RenderTableCell*);
+    void removeCellFromColumn(RenderTableCell*);
+    void computeColumnLayout(unsigned effCol);
 
     int calcEffectiveLogicalWidth();
 
@@ -69,10 +86,39 @@ private:
         bool emptyCellsOnly;
     };
 
+    // What the cells contributed to a column, before the quirks in computeColumnLayout() are applied.
+    // This is kept between calls to computeIntrinsicLogicalWidths() so that appending rows only has
+    // to look at the new cells, and removing a cell only forces a full recalc if it may have been
+    // the one determining the column's widths.
+    struct ColumnCellData {
+        ColumnCellData()
+            : minLogicalWidth(0)
+            , maxLogicalWidth(0)
+            , contentCellCount(0)
+            , fixedContributor(0)
+            , maxContributor(0)
+        {
+        }
+
+        Length logicalWidth;
+        int minLogicalWidth;
+        int maxLogicalWidth;
+        unsigned contentCellCount;
+        RenderTableCell* fixedContributor;
+        RenderTableCell* maxContributor;
+    };
+
     Vector<Layout, 4> m_layoutStruct;
+    Vector<ColumnCellData, 4> m_columnCellData;
     Vector<RenderTableCell*, 4> m_spanCells;
+
+    // Rows appended and cells changed since m_columnCellData was last updated.
+    ListHashSet<RenderTableRow*> m_pendingRows;
+    ListHashSet<RenderTableCell*> m_pendingCells;
+
     bool m_hasPercent : 1;
     mutable bool m_effectiveLogicalWidthDirty : 1;
+    bool m_columnDataValid : 1;
 };
 
 } // namespace WebCore
@@ -36,6 +36,7 @@
 #include "FEDropShadow.h"
 #include "FEGaussianBlur.h"
 #include "FEMerge.h"
+#include "FilterResultCache.h"
 #include "FloatConversion.h"
 #include "RenderLayer.h"
 
@@ -410,6 +411,9 @@ void FilterEffectRenderer::allocateBackingStoreIfNeeded()
 
 void FilterEffectRenderer::clearIntermediateResults()
 {
+    if (RefPtr<FilterEffect> effect = lastEffect())
+        FilterResultCache::shared().remove(effect.get());
+
     m_sourceGraphic->clearResult();
     for (size_t i = 0; i < m_effects.size(); ++i)
         m_effects[i]->clearResult();
@@ -422,6 +426,37 @@ void FilterEffectRenderer::apply()
     effect->transformResultColorSpace(ColorSpaceDeviceRGB);
 }
 
+bool FilterEffectRenderer::cachesResults() const
+{
+#if ENABLE(CSS_SHADERS)
+    if (m_hasCustomShaderFilter)
+        return false;
+#endif
+    return m_hasFilterThatMovesPixels;
+}
+
+bool FilterEffectRenderer::canUseCachedResult(const LayoutRect& filterBoxRect, const LayoutRect& filterSourceRect, const LayoutRect& dirtySourceRect) const
+{
+    if (!cachesResults() || !dirtySourceRect.isEmpty())
+        return false;
+
+    RefPtr<FilterEffect> effect = lastEffect();
+    if (!effect || !effect->hasResult())
+        return false;
+
+    // The result is only valid where the source image covers everything the
+    // painted pixels depend on, and only as long as the layer stays in place.
+    return filterBoxRect == m_resultFilterBoxRect && LayoutRect(m_sourceDrawingRegion).contains(filterSourceRect);
+}
+
+void FilterEffectRenderer::didPaintResult()
+{
+    if (cachesResults())
+        FilterResultCache::shared().didPaintResults(lastEffect().get());
+    else
+        clearIntermediateResults();
+}
+
 LayoutRect FilterEffectRenderer::computeSourceImageRectForDirtyRect(const LayoutRect& filterBoxRect, const LayoutRect& dirtyRect)
 {
 #if ENABLE(CSS_SHADERS)
@@ -459,6 +494,21 @@ bool FilterEffectRendererHelper::prepareFilterEffect(RenderLayer* renderLayer, c
         return false;
     }
     
+    if (filter->canUseCachedResult(filterBoxRect, filterSourceRect, layerRepaintRect)) {
+        m_paintOffset = LayoutPoint(filter->sourceImageRect().location());
+        m_usesCachedResult = true;
+        return true;
+    }
+    filter->clearIntermediateResults();
+
+    // Paint the source of the whole filter box, so that its result can be
+    // reused for any part of the box, e.g. the strips exposed when scrolling.
+    if (filter->cachesResults() && isFilterSizeValid(filterBoxRect) && FilterResultCache::canCacheResultOfSize(pixelSnappedIntRect(filterBoxRect).size())) {
+        filterSourceRect = filterBoxRect;
+        m_paintOffset = filterSourceRect.location();
+    }
+    filter->setResultFilterBoxRect(filterBoxRect);
+
     bool hasUpdatedBackingStore = filter->updateBackingStoreRect(filterSourceRect);
     if (filter->hasFilterThatMovesPixels()) {
         if (hasUpdatedBackingStore)
@@ -476,6 +526,9 @@ GraphicsContext* FilterEffectRendererHelper::filterContext() const
     if (!m_haveFilterEffect)
         return 0;
 
+    if (m_usesCachedResult)
+        return m_disabledContext.get();
+
     FilterEffectRenderer* filter = m_renderLayer->filterRenderer();
     return filter->inputContext();
 }
@@ -484,6 +537,12 @@ bool FilterEffectRendererHelper::beginFilterEffect()
 {
     ASSERT(m_renderLayer);
     
+    if (m_usesCachedResult) {
+        m_disabledContext = adoptPtr(new GraphicsContext(0));
+        m_startedFilterEffect = true;
+        return true;
+    }
+
     FilterEffectRenderer* filter = m_renderLayer->filterRenderer();
     filter->allocateBackingStoreIfNeeded();
     // Paint into the context that represents the SourceGraphic of the filter.
@@ -508,7 +567,8 @@ void FilterEffectRendererHelper::applyFilterEffect(GraphicsContext* destinationC
 {
     ASSERT(m_haveFilterEffect && m_renderLayer->filterRenderer());
     FilterEffectRenderer* filter = m_renderLayer->filterRenderer();
-    filter->inputContext()->restore();
+    if (!m_usesCachedResult)
+        filter->inputContext()->restore();
 
     filter->apply();
     
@@ -518,7 +578,7 @@ void FilterEffectRendererHelper::applyFilterEffect(GraphicsContext* destinationC
     
     destinationContext->drawImageBuffer(filter->output(), m_renderLayer->renderer()->style()->colorSpace(), pixelSnappedIntRect(destRect), CompositeSourceOver);
     
-    filter->clearIntermediateResults();
+    filter->didPaintResult();
 }
 
 } // namespace WebCore
@@ -39,6 +39,7 @@
 #include "SVGFilterBuilder.h"
 #include "SourceGraphic.h"
 
+#include <wtf/OwnPtr.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefCounted.h>
 #include <wtf/RefPtr.h>
@@ -59,6 +60,7 @@ public:
         : m_renderLayer(0)
         , m_haveFilterEffect(haveFilterEffect)
         , m_startedFilterEffect(false)
+        , m_usesCachedResult(false)
     {
     }
     
@@ -78,6 +80,11 @@ private:
     LayoutRect m_repaintRect;
     bool m_haveFilterEffect;
     bool m_startedFilterEffect;
+
+    // The result of the previous paint is drawn again. The layer contents are
+    // still walked, but into a context with painting disabled.
+    bool m_usesCachedResult;
+    OwnPtr<GraphicsContext> m_disabledContext;
 };
 
 class FilterEffectRenderer : public Filter
@@ -110,6 +117,14 @@ public:
     void allocateBackingStoreIfNeeded();
     void clearIntermediateResults();
     void apply();
+
+    // Filters that move pixels keep their results from one paint to the next
+    // when no custom shader is involved: their layer tracks every repaint of
+    // its contents, which is what tells whether the source has changed.
+    bool cachesResults() const;
+    bool canUseCachedResult(const LayoutRect& filterBoxRect, const LayoutRect& filterSourceRect, const LayoutRect& dirtySourceRect) const;
+    void setResultFilterBoxRect(const LayoutRect& filterBoxRect) { m_resultFilterBoxRect = filterBoxRect; }
+    void didPaintResult();
     
     IntRect outputRect() const { return lastEffect()->hasResult() ? lastEffect()->requestedRegionOfInputImageData(IntRect(m_filterRegion)) : IntRect(); }
 
@@ -145,6 +160,10 @@ private:
     
     IntRectExtent m_outsets;
 
+    // The filter box, in the coordinates of the painting root, that the
+    // current source image was painted for.
+    LayoutRect m_resultFilterBoxRect;
+
     bool m_graphicsBufferAttached;
     bool m_hasFilterThatMovesPixels;
 #if ENABLE(CSS_SHADERS)
@@ -174,7 +174,7 @@ RenderBlock::MarginInfo::MarginInfo(RenderBlock* block, LayoutUnit beforeBorderP
     m_canCollapseWithChildren = !block->isRenderView() && !block->isRoot() && !block->isOutOfFlowPositioned()
         && !block->isFloating() && !block->isTableCell() && !block->hasOverflowClip() && !block->isInlineBlockOrInlineTable()
         && !block->isRenderFlowThread() && !block->isWritingModeRoot() && !block->parent()->isFlexibleBox()
-        && blockStyle->hasAutoColumnCount() && blockStyle->hasAutoColumnWidth() && !blockStyle->columnSpan();
+        && !blockStyle->containsLayout() && blockStyle->hasAutoColumnCount() && blockStyle->hasAutoColumnWidth() && !blockStyle->columnSpan();
 
     m_canCollapseMarginBeforeWithChildren = m_canCollapseWithChildren && !beforeBorderPadding && blockStyle->marginBeforeCollapse() != MSEPARATE;
 
@@ -1351,7 +1351,7 @@ bool RenderBlock::isSelfCollapsingBlock() const
         // If the block has inline children, see if we generated any line boxes.  If we have any
         // line boxes, then we can't be self-collapsing, since we have content.
         if (childrenInline())
-            return !firstLineBox();
+            return !firstLineBox() && !hasSimpleLineLayout();
         
         // Whether or not we collapse is dependent on whether all our normal flow children
         // are also self-collapsing.
@@ -1889,7 +1889,7 @@ void RenderBlock::addVisualOverflowFromTheme()
 bool RenderBlock::expandsToEncloseOverhangingFloats() const
 {
     return isInlineBlockOrInlineTable() || isFloatingOrOutOfFlowPositioned() || hasOverflowClip() || (parent() && parent()->isFlexibleBoxIncludingDeprecated())
-           || hasColumns() || isTableCell() || isTableCaption() || isFieldset() || isWritingModeRoot() || isRoot();
+           || hasColumns() || isTableCell() || isTableCaption() || isFieldset() || isWritingModeRoot() || isRoot() || style()->containsLayout();
 }
 
 void RenderBlock::adjustPositionedBlock(RenderBox* child, const MarginInfo& marginInfo)
@@ -3173,9 +3173,12 @@ void RenderBlock::paintContents(PaintInfo& paintInfo, const LayoutPoint& paintOf
     if (document()->didLayoutWithPendingStylesheets() && !isRenderView())
         return;
 
-    if (childrenInline())
-        m_lineBoxes.paint(this, paintInfo, paintOffset);
-    else {
+    if (childrenInline()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+            SimpleLineLayout::paintFlow(*this, *simpleLineLayout, paintInfo, paintOffset);
+        else
+            m_lineBoxes.paint(this, paintInfo, paintOffset);
+    } else {
         PaintPhase newPhase = (paintInfo.phase == PaintPhaseChildOutlines) ? PaintPhaseOutline : paintInfo.phase;
         newPhase = (newPhase == PaintPhaseChildBlockBackgrounds) ? PaintPhaseChildBlockBackground : newPhase;
 
@@ -4798,7 +4801,7 @@ void RenderBlock::clearFloats()
 LayoutUnit RenderBlock::addOverhangingFloats(RenderBlock* child, bool makeChildPaintOtherFloats)
 {
     // Prevent floats from being added to the canvas by the root element, e.g., <html>.
-    if (child->hasOverflowClip() || !child->containsFloats() || child->isRoot() || child->hasColumns() || child->isWritingModeRoot())
+    if (child->hasOverflowClip() || !child->containsFloats() || child->isRoot() || child->hasColumns() || child->isWritingModeRoot() || child->style()->containsLayout())
         return 0;
 
     LayoutUnit childLogicalTop = child->logicalTop();
@@ -5249,6 +5252,8 @@ void RenderBlock::adjustForColumnRect(LayoutSize& offset, const LayoutPoint& loc
 bool RenderBlock::hitTestContents(const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, HitTestAction hitTestAction)
 {
     if (childrenInline() && !isTable()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+            return hitTestAction == HitTestForeground && SimpleLineLayout::hitTestFlow(*this, *simpleLineLayout, request, result, locationInContainer, accumulatedOffset);
         // We have to hit-test our line boxes.
         if (m_lineBoxes.hitTest(this, request, result, locationInContainer, accumulatedOffset, hitTestAction))
             return true;
@@ -5329,6 +5334,8 @@ VisiblePosition RenderBlock::positionForPointWithInlineChildren(const LayoutPoin
 {
     ASSERT(childrenInline());
 
+    ensureLineBoxes();
+
     if (!firstRootBox())
         return createVisiblePosition(0, DOWNSTREAM);
 
@@ -6583,6 +6590,8 @@ int RenderBlock::firstLineBoxBaseline() const
         return -1;
 
     if (childrenInline()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+            return SimpleLineLayout::computeFirstBaseline(*this, *simpleLineLayout);
         if (firstLineBox())
             return firstLineBox()->logicalTop() + style(true)->fontMetrics().ascent(firstRootBox()->baselineType());
         else
@@ -6612,6 +6621,8 @@ int RenderBlock::lastLineBoxBaseline(LineDirectionMode lineDirection) const
         return -1;
 
     if (childrenInline()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout())
+            return SimpleLineLayout::computeLastBaseline(*this, *simpleLineLayout);
         if (!firstLineBox() && hasLineIfEmpty()) {
             const FontMetrics& fontMetrics = firstLineStyle()->fontMetrics();
             return fontMetrics.ascent()
@@ -6922,6 +6933,7 @@ static int getHeightForLineCount(RenderBlock* block, int l, bool includeBottom,
 {
     if (block->style()->visibility() == VISIBLE) {
         if (block->childrenInline()) {
+            block->ensureLineBoxes();
             for (RootInlineBox* box = block->firstRootBox(); box; box = box->nextRootBox()) {
                 if (++count == l)
                     return box->lineBottom() + (includeBottom ? (block->borderBottom() + block->paddingBottom()) : LayoutUnit());
@@ -6953,6 +6965,7 @@ RootInlineBox* RenderBlock::lineAtIndex(int i) const
         return 0;
 
     if (childrenInline()) {
+        const_cast<RenderBlock*>(this)->ensureLineBoxes();
         for (RootInlineBox* box = firstRootBox(); box; box = box->nextRootBox())
             if (!i--)
                 return box;
@@ -6973,7 +6986,8 @@ int RenderBlock::lineCount(const RootInlineBox* stopRootInlineBox, bool* found)
     int count = 0;
 
     if (style()->visibility() == VISIBLE) {
-        if (childrenInline())
+        if (childrenInline()) {
+            const_cast<RenderBlock*>(this)->ensureLineBoxes();
             for (RootInlineBox* box = firstRootBox(); box; box = box->nextRootBox()) {
                 count++;
                 if (box == stopRootInlineBox) {
@@ -6982,7 +6996,7 @@ int RenderBlock::lineCount(const RootInlineBox* stopRootInlineBox, bool* found)
                     break;
                 }
             }
-        else
+        } else
             for (RenderObject* obj = firstChild(); obj; obj = obj->nextSibling())
                 if (shouldCheckLines(obj)) {
                     bool recursiveFound = false;
@@ -7008,7 +7022,12 @@ void RenderBlock::adjustForBorderFit(LayoutUnit x, LayoutUnit& left, LayoutUnit&
     // We don't deal with relative positioning.  Our assumption is that you shrink to fit the lines without accounting
     // for either overflow or translations via relative positioning.
     if (style()->visibility() == VISIBLE) {
-        if (childrenInline()) {
+        if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout()) {
+            // This runs during painting, so use the runs rather than creating line boxes.
+            LayoutRect linesRect = SimpleLineLayout::computeOverflow(*this, *simpleLineLayout);
+            left = min(left, x + linesRect.x());
+            right = max(right, x + linesRect.maxX());
+        } else if (childrenInline()) {
             for (RootInlineBox* box = firstRootBox(); box; box = box->nextRootBox()) {
                 if (box->firstChild())
                     left = min(left, x + static_cast<LayoutUnit>(box->firstChild()->x()));
@@ -2107,8 +2107,70 @@ void RenderBlock::repaintDirtyFloats(Vector<FloatWithRect>& floats)
     }
 }
 
+bool RenderBlock::layoutSimpleLines(LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom)
+{
+    if (m_rareData && m_rareData->m_forcesLineBoxes)
+        return false;
+    if (!SimpleLineLayout::canUseFor(*this))
+        return false;
+    OwnPtr<SimpleLineLayout::Layout> simpleLineLayout = SimpleLineLayout::create(*this);
+    if (!simpleLineLayout)
+        return false;
+
+    lineBoxes()->deleteLineBoxes(renderArena());
+
+    RenderText* textRenderer = toRenderText(firstChild());
+    textRenderer->dirtyLineBoxes(true);
+    textRenderer->setHasSimpleLineLayout(true);
+    textRenderer->setNeedsLayout(false);
+
+    LayoutUnit linesHeight = SimpleLineLayout::computeFlowHeight(*this, *simpleLineLayout);
+    setLogicalHeight(borderAndPaddingBefore() + linesHeight + borderAndPaddingAfter() + scrollbarLogicalHeight());
+
+    LayoutRect overflowRect = SimpleLineLayout::computeOverflow(*this, *simpleLineLayout);
+    repaintLogicalTop = min(borderAndPaddingBefore(), overflowRect.y());
+    repaintLogicalBottom = max(borderAndPaddingBefore() + linesHeight, overflowRect.maxY());
+
+    if (!m_rareData)
+        m_rareData = adoptPtr(new RenderBlockRareData(this));
+    m_rareData->m_simpleLineLayout = simpleLineLayout.release();
+    return true;
+}
+
+void RenderBlock::clearSimpleLineLayout()
+{
+    if (!hasSimpleLineLayout())
+        return;
+    m_rareData->m_simpleLineLayout.clear();
+    if (firstChild() && firstChild()->isText())
+        toRenderText(firstChild())->setHasSimpleLineLayout(false);
+}
+
+void RenderBlock::ensureLineBoxes()
+{
+    if (!hasSimpleLineLayout())
+        return;
+    // Once something has needed the line boxes it is likely to need them again, so stay on the normal path.
+    m_rareData->m_forcesLineBoxes = true;
+
+    LayoutUnit oldLogicalHeight = logicalHeight();
+    LayoutUnit repaintLogicalTop = 0;
+    LayoutUnit repaintLogicalBottom = 0;
+    bool needsLayoutState = !view()->layoutState();
+    if (needsLayoutState)
+        view()->pushLayoutState(this);
+    layoutInlineChildren(true, repaintLogicalTop, repaintLogicalBottom);
+    if (needsLayoutState)
+        view()->popLayoutState(this);
+    setLogicalHeight(oldLogicalHeight);
+}
+
 void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom)
 {
+    clearSimpleLineLayout();
+    if (layoutSimpleLines(repaintLogicalTop, repaintLogicalBottom))
+        return;
+
     setLogicalHeight(borderAndPaddingBefore());
     
     // Lay out our hypothetical grid line as though it occurs at the top of the block.
@@ -3545,6 +3607,14 @@ InlineIterator RenderBlock::LineBreaker::nextSegmentBreak(InlineBidiResolver& re
 void RenderBlock::addOverflowFromInlineChildren()
 {
     LayoutUnit endPadding = hasOverflowClip() ? paddingEnd() : LayoutUnit();
+    if (const SimpleLineLayout::Layout* simpleLineLayout = this->simpleLineLayout()) {
+        LayoutRect overflowRect = SimpleLineLayout::computeOverflow(*this, *simpleLineLayout);
+        if (!hasOverflowClip())
+            addVisualOverflow(overflowRect);
+        overflowRect.setWidth(overflowRect.width() + endPadding);
+        addLayoutOverflow(overflowRect);
+        return;
+    }
     // FIXME: Need to find another way to do this, since scrollbars could show when we don't want them to.
     if (hasOverflowClip() && !endPadding && node() && node()->isRootEditableElement() && style()->isLeftToRightDirection())
         endPadding = 1;
@@ -357,9 +357,10 @@ void RenderBox::updateFromStyle()
     setFloating(!isOutOfFlowPositioned() && styleToUse->isFloating());
 
     // We also handle <body> and <html>, whose overflow applies to the viewport.
-    if (styleToUse->overflowX() != OVISIBLE && !isRootObject && isRenderBlock()) {
+    // Paint containment clips the contents like overflow: hidden does.
+    if ((styleToUse->overflowX() != OVISIBLE || styleToUse->containsPaint()) && !isRootObject && isRenderBlock()) {
         bool boxHasOverflowClip = true;
-        if (isBody()) {
+        if (isBody() && !styleToUse->containsPaint()) {
             // Overflow on the body can propagate to the viewport under the following conditions.
             // (1) The root element is <html>.
             // (2) We are the primary <body> (can be checked by looking at document.body).
@@ -4108,7 +4109,7 @@ bool RenderBox::shrinkToAvoidFloats() const
 
 bool RenderBox::avoidsFloats() const
 {
-    return isReplaced() || hasOverflowClip() || isHR() || isLegend() || isWritingModeRoot() || isFlexItemIncludingDeprecated();
+    return isReplaced() || hasOverflowClip() || isHR() || isLegend() || isWritingModeRoot() || isFlexItemIncludingDeprecated() || style()->containsLayout();
 }
 
 void RenderBox::addVisualEffectOverflow()
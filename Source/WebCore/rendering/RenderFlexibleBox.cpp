@@ -127,6 +127,7 @@ RenderFlexibleBox::RenderFlexibleBox(Element* element)
     : RenderBlock(element)
     , m_orderIterator(this)
     , m_numberOfInFlowChildrenOnFirstLine(-1)
+    , m_childLayoutCount(0)
 {
     setChildrenInline(false); // All of our children must be block-level.
 }
@@ -147,6 +148,13 @@ const char* RenderFlexibleBox::renderName() const
     return "RenderFlexibleBox";
 }
 
+void RenderFlexibleBox::removeChild(RenderObject* oldChild)
+{
+    if (oldChild->isBox())
+        m_measuredChildExtents.remove(toRenderBox(oldChild));
+    RenderBlock::removeChild(oldChild);
+}
+
 static LayoutUnit marginLogicalWidthForChild(RenderBox* child, RenderStyle* parentStyle)
 {
     // A margin has three types: fixed, percentage, and auto (variable).
@@ -346,6 +354,7 @@ void RenderFlexibleBox::layoutBlock(bool relayoutChildren, LayoutUnit)
         relayoutChildren = true;
 
     m_numberOfInFlowChildrenOnFirstLine = -1;
+    m_childLayoutCount = 0;
 
     RenderBlock::startDelayUpdateScrollInfo();
 
@@ -743,20 +752,32 @@ LayoutUnit RenderFlexibleBox::mainAxisScrollbarExtentForChild(RenderBox* child)
 
 LayoutUnit RenderFlexibleBox::preferredMainAxisContentExtentForChild(RenderBox* child, bool hasInfiniteLineLength)
 {
+    Length flexBasis = flexBasisForChild(child);
+    bool usesIntrinsicExtent = flexBasis.isAuto() || (flexBasis.isFixed() && !flexBasis.value() && hasInfiniteLineLength);
+    bool needsLayoutToMeasure = usesIntrinsicExtent && hasOrthogonalFlow(child);
+
+    if (needsLayoutToMeasure && !child->needsLayout()) {
+        MeasuredChildExtentMap::const_iterator it = m_measuredChildExtents.find(child);
+        if (it != m_measuredChildExtents.end() && it->value.availableLogicalWidth == contentLogicalWidth() && it->value.laidOutExtent == mainAxisExtentForChild(child))
+            return it->value.contentExtent;
+    }
+
     bool hasOverrideSize = child->hasOverrideWidth() || child->hasOverrideHeight();
     if (hasOverrideSize)
         child->clearOverrideSize();
 
-    Length flexBasis = flexBasisForChild(child);
-    if (flexBasis.isAuto() || (flexBasis.isFixed() && !flexBasis.value() && hasInfiniteLineLength)) {
-        if (hasOrthogonalFlow(child)) {
+    if (usesIntrinsicExtent) {
+        if (needsLayoutToMeasure) {
             if (hasOverrideSize)
                 child->setChildNeedsLayout(true, MarkOnlyThis);
-            child->layoutIfNeeded();
+            layoutChildIfNeeded(child);
         }
-        LayoutUnit mainAxisExtent = hasOrthogonalFlow(child) ? child->logicalHeight() : child->maxPreferredLogicalWidth();
+        LayoutUnit mainAxisExtent = needsLayoutToMeasure ? child->logicalHeight() : child->maxPreferredLogicalWidth();
         ASSERT(mainAxisExtent - mainAxisBorderAndPaddingExtentForChild(child) >= 0);
-        return mainAxisExtent - mainAxisBorderAndPaddingExtentForChild(child);
+        LayoutUnit contentExtent = mainAxisExtent - mainAxisBorderAndPaddingExtentForChild(child);
+        if (needsLayoutToMeasure)
+            m_measuredChildExtents.set(child, MeasuredChildExtent(contentLogicalWidth(), contentExtent, mainAxisExtentForChild(child)));
+        return contentExtent;
     }
     return std::max(LayoutUnit(0), computeMainAxisExtentForChild(child, MainOrPreferredSize, flexBasis));
 }
@@ -1178,7 +1199,7 @@ void RenderFlexibleBox::layoutAndPlaceChildren(LayoutUnit& crossAxisOffset, cons
             resetAutoMarginsAndLogicalTopInCrossAxis(child);
         }
         updateBlockChildDirtyBitsBeforeLayout(relayoutChildren, child);
-        child->layoutIfNeeded();
+        layoutChildIfNeeded(child);
 
         updateAutoMarginsInMainAxis(child, autoMarginOffset);
 
@@ -1407,7 +1428,7 @@ void RenderFlexibleBox::applyStretchAlignmentToChild(RenderBox* child, LayoutUni
                 child->setOverrideLogicalContentHeight(desiredLogicalHeight - child->borderAndPaddingLogicalHeight());
                 child->setLogicalHeight(0);
                 child->setChildNeedsLayout(true, MarkOnlyThis);
-                child->layout();
+                layoutChildIfNeeded(child);
             }
         }
     } else if (isColumnFlow() && child->style()->logicalWidth().isAuto()) {
@@ -1419,12 +1440,26 @@ void RenderFlexibleBox::applyStretchAlignmentToChild(RenderBox* child, LayoutUni
             if (childWidth != child->logicalWidth()) {
                 child->setOverrideLogicalContentWidth(childWidth - child->borderAndPaddingLogicalWidth());
                 child->setChildNeedsLayout(true, MarkOnlyThis);
-                child->layout();
+                layoutChildIfNeeded(child);
             }
         }
     }
 }
 
+void RenderFlexibleBox::layoutChildIfNeeded(RenderBox* child)
+{
+    if (!child->needsLayout())
+        return;
+
+    ++m_childLayoutCount;
+    child->layout();
+
+    // Keep a measurement usable across our own layouts of the child.
+    MeasuredChildExtentMap::iterator it = m_measuredChildExtents.find(child);
+    if (it != m_measuredChildExtents.end())
+        it->value.laidOutExtent = mainAxisExtentForChild(child);
+}
+
 void RenderFlexibleBox::flipForRightToLeftColumn()
 {
     if (style()->isLeftToRightDirection() || !isColumnFlow())
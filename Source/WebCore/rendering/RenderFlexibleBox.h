@@ -32,6 +32,7 @@
 #define RenderFlexibleBox_h
 
 #include "RenderBlock.h"
+#include <wtf/HashMap.h>
 
 namespace WebCore {
 
@@ -45,10 +46,14 @@ public:
     virtual const char* renderName() const OVERRIDE;
 
     virtual bool isFlexibleBox() const OVERRIDE { return true; }
+    virtual void removeChild(RenderObject*) OVERRIDE;
     virtual bool avoidsFloats() const OVERRIDE { return true; }
     virtual bool canCollapseAnonymousBlockChild() const OVERRIDE { return false; }
     virtual void layoutBlock(bool relayoutChildren, LayoutUnit pageLogicalHeight = 0) OVERRIDE;
 
+    // The number of times the last layout of this flexbox laid out its children.
+    unsigned childLayoutCount() const { return m_childLayoutCount; }
+
     virtual int baselinePosition(FontBaseline, bool firstLine, LineDirectionMode, LinePositionMode = PositionOnContainingLine) const OVERRIDE;
     virtual int firstLineBoxBaseline() const OVERRIDE;
     virtual int inlineBlockBaseline(LineDirectionMode) const OVERRIDE;
@@ -173,9 +178,31 @@ private:
     void applyStretchAlignmentToChild(RenderBox*, LayoutUnit lineCrossAxisExtent);
     void flipForRightToLeftColumn();
     void flipForWrapReverse(const Vector<LineContext>&, LayoutUnit crossAxisStartEdge);
+    void layoutChildIfNeeded(RenderBox*);
+
+    // Children whose intrinsic main axis extent can only be found by laying them out (see
+    // preferredMainAxisContentExtentForChild) are measured once and the result is reused as long
+    // as the child does not need layout, still has the extent we last gave it and is measured
+    // against the same available width.
+    struct MeasuredChildExtent {
+        MeasuredChildExtent() { }
+        MeasuredChildExtent(LayoutUnit availableLogicalWidth, LayoutUnit contentExtent, LayoutUnit laidOutExtent)
+            : availableLogicalWidth(availableLogicalWidth)
+            , contentExtent(contentExtent)
+            , laidOutExtent(laidOutExtent)
+        {
+        }
+
+        LayoutUnit availableLogicalWidth;
+        LayoutUnit contentExtent;
+        LayoutUnit laidOutExtent;
+    };
+    typedef HashMap<const RenderBox*, MeasuredChildExtent> MeasuredChildExtentMap;
 
     mutable OrderIterator m_orderIterator;
     int m_numberOfInFlowChildrenOnFirstLine;
+    MeasuredChildExtentMap m_measuredChildExtents;
+    unsigned m_childLayoutCount;
 };
 
 inline RenderFlexibleBox* toRenderFlexibleBox(RenderObject* object)
@@ -476,6 +476,16 @@ void RenderLayer::updateLayerPositions(RenderGeometryMap* geometryMap, UpdateLay
     } else
         clearRepaintRects();
 
+#if ENABLE(CSS_FILTERS)
+    // Full repaints skip the repaints of the individual renderers, which are
+    // what tracks the dirty source rect of a filter, so a result kept from the
+    // last paint may be stale.
+    if (!(flags & CheckForRepaint) || (flags & NeedsFullRepaintInBacking) || (m_repaintStatus & NeedsFullRepaint)) {
+        if (FilterEffectRenderer* filter = filterRenderer())
+            filter->clearIntermediateResults();
+    }
+#endif
+
     m_repaintStatus = NeedsNormalRepaint;
 
     // Go ahead and update the reflection's position and size.
@@ -39,8 +39,10 @@
 #include "HTMLCanvasElement.h"
 #include "HTMLIFrameElement.h"
 #include "HTMLNames.h"
+#include "HistogramSupport.h"
 #include "HitTestResult.h"
 #include "InspectorInstrumentation.h"
+#include "IntPointHash.h"
 #include "Logging.h"
 #include "NodeList.h"
 #include "Page.h"
@@ -142,33 +144,108 @@ public:
     RenderGeometryMap& geometryMap() { return m_geometryMap; }
 
 private:
-    struct RectList {
-        Vector<IntRect> rects;
-        IntRect boundingRect;
-        
+    // Rects are also filed into a coarse grid of buckets, so that testing a layer only looks at the
+    // rects near it instead of every rect added so far. Rects spanning many buckets are kept in a
+    // separate list that is always scanned.
+    class RectList {
+    public:
         void append(const IntRect& rect)
         {
-            rects.append(rect);
-            boundingRect.unite(rect);
+            if (rect.isEmpty())
+                return;
+
+            unsigned index = m_rects.size();
+            m_rects.append(rect);
+            m_boundingRect.unite(rect);
+
+            IntRect buckets = bucketRange(rect);
+            if (bucketCount(buckets) > maximumBucketsPerRect) {
+                m_largeRectIndices.append(index);
+                return;
+            }
+            for (int y = buckets.y(); y < buckets.maxY(); ++y) {
+                for (int x = buckets.x(); x < buckets.maxX(); ++x)
+                    m_buckets.add(IntPoint(x, y), Vector<unsigned>()).iterator->value.append(index);
+            }
         }
 
-        void append(const RectList& rectList)
+        void append(RectList& rectList)
         {
-            rects.appendVector(rectList.rects);
-            boundingRect.unite(rectList.boundingRect);
+            if (m_rects.isEmpty()) {
+                swap(rectList);
+                return;
+            }
+            for (size_t i = 0; i < rectList.m_rects.size(); ++i)
+                append(rectList.m_rects[i]);
         }
-        
+
         bool intersects(const IntRect& rect) const
         {
-            if (!rects.size() || !boundingRect.intersects(rect))
+            if (m_rects.isEmpty() || !m_boundingRect.intersects(rect))
                 return false;
 
-            for (unsigned i = 0; i < rects.size(); i++) {
-                if (rects[i].intersects(rect))
+            for (size_t i = 0; i < m_largeRectIndices.size(); ++i) {
+                if (m_rects[m_largeRectIndices[i]].intersects(rect))
                     return true;
             }
+
+            IntRect buckets = bucketRange(intersection(rect, m_boundingRect));
+            if (bucketCount(buckets) >= m_rects.size()) {
+                for (size_t i = 0; i < m_rects.size(); ++i) {
+                    if (m_rects[i].intersects(rect))
+                        return true;
+                }
+                return false;
+            }
+
+            for (int y = buckets.y(); y < buckets.maxY(); ++y) {
+                for (int x = buckets.x(); x < buckets.maxX(); ++x) {
+                    BucketMap::const_iterator it = m_buckets.find(IntPoint(x, y));
+                    if (it == m_buckets.end())
+                        continue;
+                    const Vector<unsigned>& indices = it->value;
+                    for (size_t i = 0; i < indices.size(); ++i) {
+                        if (m_rects[indices[i]].intersects(rect))
+                            return true;
+                    }
+                }
+            }
             return false;
         }
+
+        void swap(RectList& other)
+        {
+            m_rects.swap(other.m_rects);
+            m_largeRectIndices.swap(other.m_largeRectIndices);
+            m_buckets.swap(other.m_buckets);
+            std::swap(m_boundingRect, other.m_boundingRect);
+        }
+
+    private:
+        static const int bucketSizeShift = 8;
+        static const uint64_t maximumBucketsPerRect = 16;
+
+        static IntRect bucketRange(const IntRect& rect)
+        {
+            // Arithmetic shifts round towards negative infinity, so negative coordinates bucket correctly.
+            int minX = rect.x() >> bucketSizeShift;
+            int minY = rect.y() >> bucketSizeShift;
+            int maxX = (rect.maxX() - 1) >> bucketSizeShift;
+            int maxY = (rect.maxY() - 1) >> bucketSizeShift;
+            return IntRect(minX, minY, maxX - minX + 1, maxY - minY + 1);
+        }
+
+        static uint64_t bucketCount(const IntRect& buckets)
+        {
+            return static_cast<uint64_t>(buckets.width()) * buckets.height();
+        }
+
+        typedef HashMap<IntPoint, Vector<unsigned> > BucketMap;
+
+        Vector<IntRect> m_rects;
+        Vector<unsigned> m_largeRectIndices;
+        BucketMap m_buckets;
+        IntRect m_boundingRect;
     };
 
     Vector<RectList> m_overlapStack;
@@ -245,6 +322,7 @@ RenderLayerCompositor::RenderLayerCompositor(RenderView* renderView)
     , m_secondaryCompositedLayerCount(0)
     , m_obligatoryBackingStoreBytes(0)
     , m_secondaryBackingStoreBytes(0)
+    , m_compositingRequirementsTime(0)
 #endif
 {
 }
@@ -579,7 +657,13 @@ void RenderLayerCompositor::updateCompositingLayers(CompositingUpdateType update
         bool layersChanged = false;
         bool saw3DTransform = false;
         OverlapMap overlapTestRequestMap;
+        double requirementsStartTime = monotonicallyIncreasingTime();
         computeCompositingRequirements(0, updateRoot, &overlapTestRequestMap, compState, layersChanged, saw3DTransform);
+        double requirementsTime = monotonicallyIncreasingTime() - requirementsStartTime;
+        HistogramSupport::histogramCustomCounts("Compositing.ComputeRequirementsTimeMs", static_cast<int>(requirementsTime * 1000), 0, 1000, 50);
+#if !LOG_DISABLED
+        m_compositingRequirementsTime = requirementsTime;
+#endif
         needHierarchyUpdate |= layersChanged;
     }
 
@@ -619,11 +703,12 @@ void RenderLayerCompositor::updateCompositingLayers(CompositingUpdateType update
 #if !LOG_DISABLED
     if (compositingLogEnabled() && isFullUpdate && (needHierarchyUpdate || needGeometryUpdate)) {
         double endTime = currentTime();
-        LOG(Compositing, "Total layers   primary   secondary   obligatory backing (KB)   secondary backing(KB)   total backing (KB)  update time (ms)\n");
+        LOG(Compositing, "Total layers   primary   secondary   obligatory backing (KB)   secondary backing(KB)   total backing (KB)  update time (ms)  requirements time (ms)\n");
 
-        LOG(Compositing, "%8d %11d %9d %20.2f %22.2f %22.2f %18.2f\n",
+        LOG(Compositing, "%8d %11d %9d %20.2f %22.2f %22.2f %18.2f %23.2f\n",
             m_obligateCompositedLayerCount + m_secondaryCompositedLayerCount, m_obligateCompositedLayerCount,
-            m_secondaryCompositedLayerCount, m_obligatoryBackingStoreBytes / 1024, m_secondaryBackingStoreBytes / 1024, (m_obligatoryBackingStoreBytes + m_secondaryBackingStoreBytes) / 1024, 1000.0 * (endTime - startTime));
+            m_secondaryCompositedLayerCount, m_obligatoryBackingStoreBytes / 1024, m_secondaryBackingStoreBytes / 1024, (m_obligatoryBackingStoreBytes + m_secondaryBackingStoreBytes) / 1024, 1000.0 * (endTime - startTime),
+            1000.0 * m_compositingRequirementsTime);
     }
 #endif
     ASSERT(updateRoot || !m_compositingLayersNeedRebuild);
@@ -469,6 +469,7 @@ private:
     int m_secondaryCompositedLayerCount; // count of layers that have to be composited because of stacking or overlap.
     double m_obligatoryBackingStoreBytes;
     double m_secondaryBackingStoreBytes;
+    double m_compositingRequirementsTime; // seconds spent in the last computeCompositingRequirements() pass.
 #endif
 };
 
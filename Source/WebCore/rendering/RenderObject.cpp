@@ -667,6 +667,11 @@ static inline bool objectIsRelayoutBoundary(const RenderObject* object)
         return true;
 #endif
 
+    // The author promises that nothing inside a box with layout containment affects the layout
+    // outside of it. FrameView::layout() still relayouts the ancestors if the box changes size or overflow.
+    if (object->style()->containsLayout() && object->isRenderBlock() && !object->isTablePart() && !object->isRoot())
+        return true;
+
     if (!object->hasOverflowClip())
         return false;
 
@@ -751,6 +756,9 @@ void RenderObject::checkBlockPositionedObjectsNeedLayout()
 void RenderObject::setPreferredLogicalWidthsDirty(bool shouldBeDirty, MarkingBehavior markParents)
 {
     bool alreadyDirty = preferredLogicalWidthsDirty();
+    // Check the display type first so that most renderers skip the virtual isTableCell() call.
+    if (shouldBeDirty && !alreadyDirty && style() && style()->display() == TABLE_CELL && isTableCell())
+        toRenderTableCell(this)->preferredLogicalWidthsWillBecomeDirty();
     m_bitfields.setPreferredLogicalWidthsDirty(shouldBeDirty);
     if (shouldBeDirty && !alreadyDirty && markParents == MarkContainingBlockChain && (isText() || !style()->hasOutOfFlowPosition()))
         invalidateContainerPreferredLogicalWidths();
@@ -764,10 +772,13 @@ void RenderObject::invalidateContainerPreferredLogicalWidths()
     while (o && !o->preferredLogicalWidthsDirty()) {
         // Don't invalidate the outermost object of an unrooted subtree. That object will be 
         // invalidated when the subtree is added to the document.
-        RenderObject* container = o->isTableCell() ? o->containingBlock() : o->container();
+        bool isTableCell = o->isTableCell();
+        RenderObject* container = isTableCell ? o->containingBlock() : o->container();
         if (!container && !o->isRenderView())
             break;
 
+        if (isTableCell)
+            toRenderTableCell(o)->preferredLogicalWidthsWillBecomeDirty();
         o->m_bitfields.setPreferredLogicalWidthsDirty(true);
         if (o->style()->hasOutOfFlowPosition())
             // A positioned object has no effect on the min/max width of its containing block ever.
@@ -2988,6 +2999,18 @@ bool RenderObject::willRenderImage(CachedImage*)
     return !document()->inPageCache() && !document()->view()->isOffscreen();
 }
 
+ResourceLoadPriority RenderObject::loadPriorityForImage(CachedImage* image)
+{
+    if (!willRenderImage(image))
+        return ResourceLoadPriorityLow;
+
+    // Images in the viewport go ahead of the ones further down the page, but not of style sheets.
+    FrameView* frameView = document()->view();
+    if (!frameView || frameView->needsLayout())
+        return ResourceLoadPriorityUnresolved;
+    return frameView->visibleContentRect().intersects(pixelSnappedIntRect(clippedOverflowRectForRepaint(0))) ? ResourceLoadPriorityMedium : ResourceLoadPriorityLow;
+}
+
 int RenderObject::maximalOutlineSize(PaintPhase p) const
 {
     if (p != PaintPhaseOutline && p != PaintPhaseSelfOutline && p != PaintPhaseChildOutlines)
@@ -944,6 +944,7 @@ public:
     virtual void imageChanged(CachedImage*, const IntRect* = 0);
     virtual void imageChanged(WrappedImagePtr, const IntRect* = 0) { }
     virtual bool willRenderImage(CachedImage*);
+    virtual ResourceLoadPriority loadPriorityForImage(CachedImage*);
 
     void selectionStartEnd(int& spos, int& epos) const;
     
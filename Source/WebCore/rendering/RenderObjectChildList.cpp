@@ -31,6 +31,7 @@
 #include "RenderCounter.h"
 #include "RenderObject.h"
 #include "RenderStyle.h"
+#include "RenderText.h"
 #include "RenderView.h"
 
 namespace WebCore {
@@ -75,6 +76,8 @@ RenderObject* RenderObjectChildList::removeChildNode(RenderObject* owner, Render
     // If we have a line box wrapper, delete it.
     if (oldChild->isBox())
         toRenderBox(oldChild)->deleteLineBoxWrapper();
+    else if (oldChild->isText())
+        toRenderText(oldChild)->setHasSimpleLineLayout(false);
 
     // If oldChild is the start or end of the selection, then clear the selection to
     // avoid problems of invalid pointers.
@@ -156,8 +156,11 @@ void RenderTable::addChild(RenderObject* child, RenderObject* beforeChild)
     else
         wrapInAnonymousSection = true;
 
-    if (child->isTableSection())
+    if (child->isTableSection()) {
         setNeedsSectionRecalc();
+        if (child->firstChild())
+            invalidateTableLayoutColumnData();
+    }
 
     if (!wrapInAnonymousSection) {
         if (beforeChild && beforeChild->parent() != this)
@@ -218,6 +221,37 @@ void RenderTable::invalidateCachedColumns()
 {
     m_columnRenderersValid = false;
     m_columnRenderers.resize(0);
+    invalidateTableLayoutColumnData();
+}
+
+void RenderTable::rowWasAppended(RenderTableRow* row)
+{
+    if (m_tableLayout && !documentBeingDestroyed())
+        m_tableLayout->rowWasAppended(row);
+}
+
+void RenderTable::rowWillBeRemoved(RenderTableRow* row)
+{
+    if (m_tableLayout && !documentBeingDestroyed())
+        m_tableLayout->rowWillBeRemoved(row);
+}
+
+void RenderTable::cellWillBeRemoved(RenderTableCell* cell)
+{
+    if (m_tableLayout && !documentBeingDestroyed())
+        m_tableLayout->cellWillBeRemoved(cell);
+}
+
+void RenderTable::cellPreferredLogicalWidthsWillChange(RenderTableCell* cell)
+{
+    if (m_tableLayout && !documentBeingDestroyed())
+        m_tableLayout->cellPreferredLogicalWidthsWillChange(cell);
+}
+
+void RenderTable::invalidateTableLayoutColumnData()
+{
+    if (m_tableLayout)
+        m_tableLayout->invalidateColumnData();
 }
 
 void RenderTable::addColumn(const RenderTableCol*)
@@ -35,6 +35,7 @@ namespace WebCore {
 class RenderTableCol;
 class RenderTableCaption;
 class RenderTableCell;
+class RenderTableRow;
 class RenderTableSection;
 class TableLayout;
 
@@ -262,6 +263,13 @@ public:
     void addColumn(const RenderTableCol*);
     void removeColumn(const RenderTableCol*);
 
+    // Let the table layout keep its column data up to date instead of rebuilding it from every cell.
+    void rowWasAppended(RenderTableRow*);
+    void rowWillBeRemoved(RenderTableRow*);
+    void cellWillBeRemoved(RenderTableCell*);
+    void cellPreferredLogicalWidthsWillChange(RenderTableCell*);
+    void invalidateTableLayoutColumnData();
+
 protected:
     virtual void styleDidChange(StyleDifference, const RenderStyle* oldStyle);
     virtual void simplifiedNormalFlowLayout();
@@ -72,6 +72,8 @@ void RenderTableCell::willBeRemovedFromTree()
 {
     RenderBlock::willBeRemovedFromTree();
 
+    if (RenderTable* table = section()->table())
+        table->cellWillBeRemoved(this);
     section()->setNeedsCellRecalc();
     section()->removeCachedCollapsedBorders(this);
 }
@@ -415,9 +417,22 @@ void RenderTableCell::styleDidChange(StyleDifference diff, const RenderStyle* ol
         RenderTable* table = this->table();
         if (table && !table->selfNeedsLayout() && !table->normalChildNeedsLayout()&& oldStyle && oldStyle->border() != style()->border())
             table->invalidateCollapsedBorders();
+
+        // Whether the cell counts as empty for its column depends on its border and padding.
+        if (table && oldStyle && (oldStyle->hasBorder() != style()->hasBorder() || oldStyle->hasPadding() != style()->hasPadding()))
+            table->invalidateTableLayoutColumnData();
     }
 }
 
+void RenderTableCell::preferredLogicalWidthsWillBecomeDirty()
+{
+    // The cell may be in a row or section that is not in a table yet.
+    if (!parent() || !parent()->parent())
+        return;
+    if (RenderTable* table = section()->table())
+        table->cellPreferredLogicalWidthsWillChange(this);
+}
+
 // The following rules apply for resolving conflicts and figuring out which border
 // to use.
 // (1) Borders with the 'border-style' of 'hidden' take precedence over all other conflicting 
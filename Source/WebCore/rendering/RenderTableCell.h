@@ -206,6 +206,9 @@ public:
         return style()->borderEnd();
     }
 
+    // Called by RenderObject right before our preferred logical widths are marked dirty.
+    void preferredLogicalWidthsWillBecomeDirty();
+
 #ifndef NDEBUG
     bool isFirstOrLastCellInRow() const
     {
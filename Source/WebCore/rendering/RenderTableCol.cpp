@@ -53,6 +53,8 @@ void RenderTableCol::styleDidChange(StyleDifference diff, const RenderStyle* old
         RenderTable* table = this->table();
         if (table && !table->selfNeedsLayout() && !table->normalChildNeedsLayout() && oldStyle && oldStyle->border() != style()->border())
             table->invalidateCollapsedBorders();
+        if (table && oldStyle && oldStyle->logicalWidth() != style()->logicalWidth())
+            table->invalidateTableLayoutColumnData();
     }
 }
 
@@ -65,8 +67,11 @@ void RenderTableCol::updateFromElement()
         m_span = tc->span();
     } else
         m_span = !(style() && style()->display() == TABLE_COLUMN_GROUP);
-    if (m_span != oldSpan && style() && parent())
+    if (m_span != oldSpan && style() && parent()) {
         setNeedsLayoutAndPrefWidthsRecalc();
+        if (RenderTable* table = this->table())
+            table->invalidateTableLayoutColumnData();
+    }
 }
 
 void RenderTableCol::insertedIntoTree()
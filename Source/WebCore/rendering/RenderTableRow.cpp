@@ -50,6 +50,9 @@ void RenderTableRow::willBeRemovedFromTree()
 {
     RenderBox::willBeRemovedFromTree();
 
+    if (RenderTable* table = this->table())
+        table->rowWillBeRemoved(this);
+
     section()->setNeedsCellRecalc();
 }
 
@@ -118,6 +118,11 @@ void RenderTableSection::willBeRemovedFromTree()
 {
     RenderBox::willBeRemovedFromTree();
 
+    if (firstChild()) {
+        if (RenderTable* table = this->table())
+            table->invalidateTableLayoutColumnData();
+    }
+
     // Preventively invalidate our cells as we may be re-inserted into
     // a new table which would require us to rebuild our structure.
     setNeedsCellRecalc();
@@ -181,6 +186,13 @@ void RenderTableSection::addChild(RenderObject* child, RenderObject* beforeChild
 
     ASSERT(!beforeChild || beforeChild->isTableRow());
     RenderBox::addChild(child, beforeChild);
+
+    if (RenderTable* table = this->table()) {
+        if (beforeChild)
+            table->invalidateTableLayoutColumnData();
+        else
+            table->rowWasAppended(row);
+    }
 }
 
 void RenderTableSection::ensureRows(unsigned numRows)
@@ -141,6 +141,7 @@ RenderText::RenderText(Node* node, PassRefPtr<StringImpl> str)
     , m_containsReversedText(false)
     , m_knownToHaveNoOverflowAndNoFallbackFonts(false)
     , m_needsTranscoding(false)
+    , m_hasSimpleLineLayout(false)
     , m_minWidth(-1)
     , m_maxWidth(-1)
     , m_beginMinWidth(0)
@@ -223,7 +224,7 @@ void RenderText::styleDidChange(StyleDifference diff, const RenderStyle* oldStyl
 void RenderText::removeAndDestroyTextBoxes()
 {
     if (!documentBeingDestroyed()) {
-        if (firstTextBox()) {
+        if (m_firstTextBox) {
             if (isBR()) {
                 RootInlineBox* next = firstTextBox()->root()->nextRootBox();
                 if (next)
@@ -299,10 +300,10 @@ void RenderText::removeTextBox(InlineTextBox* box)
 
 void RenderText::deleteTextBoxes()
 {
-    if (firstTextBox()) {
+    if (m_firstTextBox) {
         RenderArena* arena = renderArena();
         InlineTextBox* next;
-        for (InlineTextBox* curr = firstTextBox(); curr; curr = next) {
+        for (InlineTextBox* curr = m_firstTextBox; curr; curr = next) {
             next = curr->nextTextBox();
             curr->destroy(arena);
         }
@@ -318,6 +319,12 @@ PassRefPtr<StringImpl> RenderText::originalText() const
 
 void RenderText::absoluteRects(Vector<IntRect>& rects, const LayoutPoint& accumulatedOffset) const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        Vector<FloatRect> textRects = SimpleLineLayout::collectTextRects(*this, *layout);
+        for (size_t i = 0; i < textRects.size(); ++i)
+            rects.append(enclosingIntRect(FloatRect(accumulatedOffset + textRects[i].location(), textRects[i].size())));
+        return;
+    }
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
         rects.append(enclosingIntRect(FloatRect(accumulatedOffset + box->topLeft(), box->size())));
 }
@@ -354,6 +361,8 @@ void RenderText::absoluteRectsForRange(Vector<IntRect>& rects, unsigned start, u
     ASSERT(start <= INT_MAX);
     start = min(start, static_cast<unsigned>(INT_MAX));
     end = min(end, static_cast<unsigned>(INT_MAX));
+
+    ensureLineBoxes();
     
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         // Note: box->end() returns the index of the last character, not the index past it
@@ -405,6 +414,13 @@ static IntRect ellipsisRectForBox(InlineTextBox* box, unsigned startPos, unsigne
     
 void RenderText::absoluteQuads(Vector<FloatQuad>& quads, bool* wasFixed, ClippingOption option) const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        // The simple path never truncates, so there is no ellipsis to clip to.
+        Vector<FloatRect> textRects = SimpleLineLayout::collectTextRects(*this, *layout);
+        for (size_t i = 0; i < textRects.size(); ++i)
+            quads.append(localToAbsoluteQuad(textRects[i], 0, wasFixed));
+        return;
+    }
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         FloatRect boundaries = box->calculateBoundaries();
 
@@ -437,6 +453,8 @@ void RenderText::absoluteQuadsForRange(Vector<FloatQuad>& quads, unsigned start,
     ASSERT(start <= INT_MAX);
     start = min(start, static_cast<unsigned>(INT_MAX));
     end = min(end, static_cast<unsigned>(INT_MAX));
+
+    ensureLineBoxes();
     
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         // Note: box->end() returns the index of the last character, not the index past it
@@ -468,7 +486,7 @@ InlineTextBox* RenderText::findNextInlineTextBox(int offset, int& pos) const
     // Find the text run that includes the character at offset
     // and return pos, which is the position of the char in the run.
 
-    if (!m_firstTextBox)
+    if (!firstTextBox())
         return 0;
 
     InlineTextBox* s = m_firstTextBox;
@@ -612,6 +630,8 @@ static VisiblePosition createVisiblePositionAfterAdjustingOffsetForBiDi(const In
 
 VisiblePosition RenderText::positionForPoint(const LayoutPoint& point)
 {
+    ensureLineBoxes();
+
     if (!firstTextBox() || textLength() == 0)
         return createVisiblePosition(0, DOWNSTREAM);
 
@@ -1216,16 +1236,30 @@ FloatPoint RenderText::firstRunOrigin() const
 
 float RenderText::firstRunX() const
 {
-    return m_firstTextBox ? m_firstTextBox->x() : 0;
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        Vector<FloatRect> textRects = SimpleLineLayout::collectTextRects(*this, *layout);
+        return textRects.isEmpty() ? 0 : textRects.first().x();
+    }
+    InlineTextBox* box = firstTextBox();
+    return box ? box->x() : 0;
 }
 
 float RenderText::firstRunY() const
 {
-    return m_firstTextBox ? m_firstTextBox->y() : 0;
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        Vector<FloatRect> textRects = SimpleLineLayout::collectTextRects(*this, *layout);
+        return textRects.isEmpty() ? 0 : textRects.first().y();
+    }
+    InlineTextBox* box = firstTextBox();
+    return box ? box->y() : 0;
 }
     
 void RenderText::setSelectionState(SelectionState state)
 {
+    // Selection painting and gap filling walk root line boxes.
+    if (state != SelectionNone)
+        ensureLineBoxes();
+
     RenderObject::setSelectionState(state);
 
     if (canUpdateSelectionOnRootLineBoxes()) {
@@ -1279,7 +1313,7 @@ void RenderText::setTextWithOffset(PassRefPtr<StringImpl> text, unsigned offset,
     bool dirtiedLines = false;
 
     // Dirty all text boxes that include characters in between offset and offset+len.
-    for (InlineTextBox* curr = firstTextBox(); curr; curr = curr->nextTextBox()) {
+    for (InlineTextBox* curr = m_firstTextBox; curr; curr = curr->nextTextBox()) {
         // FIXME: This shouldn't rely on the end of a dirty line box. See https://bugs.webkit.org/show_bug.cgi?id=97264
         // Text run is entirely before the affected range.
         if (curr->end() < offset)
@@ -1486,12 +1520,29 @@ void RenderText::dirtyLineBoxes(bool fullLayout)
     if (fullLayout)
         deleteTextBoxes();
     else if (!m_linesDirty) {
-        for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
+        for (InlineTextBox* box = m_firstTextBox; box; box = box->nextTextBox())
             box->dirtyLineBoxes();
     }
     m_linesDirty = false;
 }
 
+const SimpleLineLayout::Layout* RenderText::simpleLineLayout() const
+{
+    if (!m_hasSimpleLineLayout)
+        return 0;
+    ASSERT(parent() && parent()->isRenderBlock());
+    return toRenderBlock(parent())->simpleLineLayout();
+}
+
+void RenderText::ensureLineBoxes()
+{
+    if (!m_hasSimpleLineLayout)
+        return;
+    RenderObject* parent = this->parent();
+    ASSERT(parent && parent->isRenderBlock());
+    toRenderBlock(parent)->ensureLineBoxes();
+}
+
 InlineTextBox* RenderText::createTextBox()
 {
     return new (renderArena()) InlineTextBox(this);
@@ -1582,6 +1633,15 @@ float RenderText::width(unsigned from, unsigned len, const Font& f, float xPos,
 
 IntRect RenderText::linesBoundingBox() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout()) {
+        // All runs are horizontal and left to right, so the union is the same box the line boxes would give.
+        Vector<FloatRect> textRects = SimpleLineLayout::collectTextRects(*this, *layout);
+        FloatRect boundingBox;
+        for (size_t i = 0; i < textRects.size(); ++i)
+            boundingBox.unite(textRects[i]);
+        return enclosingIntRect(boundingBox);
+    }
+
     IntRect result;
     
     ASSERT(!firstTextBox() == !lastTextBox());  // Either both are null or both exist.
@@ -1610,6 +1670,10 @@ IntRect RenderText::linesBoundingBox() const
 
 LayoutRect RenderText::linesVisualOverflowBoundingBox() const
 {
+    // Text on the simple path has no shadows or strokes that would overflow the runs.
+    if (simpleLineLayout())
+        return linesBoundingBox();
+
     if (!firstTextBox())
         return LayoutRect();
 
@@ -1675,6 +1739,8 @@ LayoutRect RenderText::selectionRectForRepaint(const RenderLayerModelObject* rep
     if (startPos == endPos)
         return IntRect();
 
+    ensureLineBoxes();
+
     LayoutRect rect;
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox()) {
         rect.unite(box->localSelectionRect(startPos, endPos));
@@ -1695,6 +1761,8 @@ LayoutRect RenderText::selectionRectForRepaint(const RenderLayerModelObject* rep
 
 int RenderText::caretMinOffset() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return layout->runs.isEmpty() ? 0 : layout->runs.first().start;
     InlineTextBox* box = firstTextBox();
     if (!box)
         return 0;
@@ -1706,6 +1774,8 @@ int RenderText::caretMinOffset() const
 
 int RenderText::caretMaxOffset() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return layout->runs.isEmpty() ? textLength() : layout->runs.last().end;
     InlineTextBox* box = lastTextBox();
     if (!lastTextBox())
         return textLength();
@@ -1718,6 +1788,8 @@ int RenderText::caretMaxOffset() const
 
 unsigned RenderText::renderedTextLength() const
 {
+    if (const SimpleLineLayout::Layout* layout = simpleLineLayout())
+        return SimpleLineLayout::computeTextRenderedLength(*layout);
     int l = 0;
     for (InlineTextBox* box = firstTextBox(); box; box = box->nextTextBox())
         l += box->len();
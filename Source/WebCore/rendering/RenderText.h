@@ -31,6 +31,10 @@ namespace WebCore {
 
 class InlineTextBox;
 
+namespace SimpleLineLayout {
+struct Layout;
+}
+
 class RenderText : public RenderObject {
 public:
     RenderText(Node*, PassRefPtr<StringImpl>);
@@ -113,6 +117,13 @@ public:
     InlineTextBox* firstTextBox() const { return m_firstTextBox; }
     InlineTextBox* lastTextBox() const { return m_lastTextBox; }
 
+    // Set by the containing block while this text is laid out by SimpleLineLayout instead of
+    // having InlineTextBoxes. Code that walks the text boxes has to call ensureLineBoxes() first.
+    bool hasSimpleLineLayout() const { return m_hasSimpleLineLayout; }
+    void setHasSimpleLineLayout(bool hasSimpleLineLayout) { m_hasSimpleLineLayout = hasSimpleLineLayout; }
+    const SimpleLineLayout::Layout* simpleLineLayout() const;
+    void ensureLineBoxes();
+
     virtual int caretMinOffset() const;
     virtual int caretMaxOffset() const;
     virtual unsigned renderedTextLength() const;
@@ -186,6 +197,7 @@ private:
     bool m_canUseSimpleFontCodePath : 1;
     mutable bool m_knownToHaveNoOverflowAndNoFallbackFonts : 1;
     bool m_needsTranscoding : 1;
+    bool m_hasSimpleLineLayout : 1;
     
     float m_minWidth;
     float m_maxWidth;
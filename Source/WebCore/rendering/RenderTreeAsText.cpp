@@ -564,6 +564,10 @@ void write(TextStream& ts, const RenderObject& o, int indent, RenderAsTextBehavi
     }
 #endif
 
+    // The dump lists text boxes, which text on the simple line layout path does not have yet.
+    if (o.isText())
+        const_cast<RenderText*>(toRenderText(&o))->ensureLineBoxes();
+
     writeIndent(ts, indent);
 
     RenderTreeAsText::writeRenderObject(ts, o, behavior);
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SimpleLineLayout.h"
+
+#include "AXObjectCache.h"
+#include "Document.h"
+#include "DocumentStyleSheetCollection.h"
+#include "Font.h"
+#include "GraphicsContext.h"
+#include "HitTestLocation.h"
+#include "HitTestRequest.h"
+#include "HitTestResult.h"
+#include "LayoutState.h"
+#include "PaintInfo.h"
+#include "RenderBlock.h"
+#include "RenderStyle.h"
+#include "RenderText.h"
+#include "RenderView.h"
+#include "Settings.h"
+#include "TextBreakIterator.h"
+#include "break_lines.h"
+#include <wtf/unicode/CharacterNames.h>
+#include <wtf/unicode/Unicode.h>
+
+namespace WebCore {
+namespace SimpleLineLayout {
+
+static inline bool isWhitespace(UChar character)
+{
+    return character == ' ' || character == '\t' || character == '\n';
+}
+
+template <typename CharacterType>
+static bool canUseForText(const CharacterType* characters, unsigned length, const Font& font)
+{
+    for (unsigned i = 0; i < length; ++i) {
+        UChar character = characters[i];
+        if (character == softHyphen)
+            return false;
+        if (character >= 0x0590 && WTF::Unicode::direction(character) != WTF::Unicode::LeftToRight && !isWhitespace(character))
+            return false;
+        if (!font.primaryFontHasGlyphForCharacter(character) && !isWhitespace(character))
+            return false;
+    }
+    return true;
+}
+
+bool canUseFor(const RenderBlock& flow)
+{
+    if (!flow.document()->settings() || !flow.document()->settings()->simpleLineLayoutEnabled())
+        return false;
+    if (!flow.firstChild() || flow.firstChild() != flow.lastChild() || !flow.firstChild()->isText())
+        return false;
+    if (!flow.isHorizontalWritingMode())
+        return false;
+    if (flow.flowThreadContainingBlock() || flow.hasColumns())
+        return false;
+    if (flow.isRubyBase() || flow.isRubyText() || flow.isTextControl())
+        return false;
+    if (flow.containsFloats())
+        return false;
+#if ENABLE(CSS_SHAPES)
+    if (flow.layoutShapeInsideInfo())
+        return false;
+#endif
+    if (LayoutState* layoutState = flow.view()->layoutState()) {
+        if (layoutState->isPaginated() || layoutState->lineGrid())
+            return false;
+    }
+    if (flow.document()->printing() || AXObjectCache::accessibilityEnabled())
+        return false;
+    DocumentStyleSheetCollection* styleSheetCollection = flow.document()->styleSheetCollection();
+    if (styleSheetCollection->usesFirstLineRules() || styleSheetCollection->usesFirstLetterRules())
+        return false;
+    // line-clamp needs to count root line boxes.
+    if (flow.parent() && !flow.parent()->style()->lineClamp().isNone())
+        return false;
+
+    RenderStyle* style = flow.style();
+    if (style->textDecorationsInEffect() != TDNONE)
+        return false;
+    if (style->textAlign() != TASTART && style->textAlign() != LEFT && style->textAlign() != WEBKIT_LEFT)
+        return false;
+    if (!style->isLeftToRightDirection() || style->rtlOrdering() != LogicalOrder)
+        return false;
+    if (style->whiteSpace() != NORMAL && style->whiteSpace() != NOWRAP)
+        return false;
+    if (!style->textIndent().isZero())
+        return false;
+    if (style->breakWords() || style->wordBreak() == BreakAllWordBreak || style->hyphens() == HyphensAuto)
+        return false;
+    if (style->lineBoxContain() != RenderStyle::initialLineBoxContain())
+        return false;
+    if (style->lineSnap() != LineSnapNone || style->lineAlign() != LineAlignNone || !style->lineGrid().isNull())
+        return false;
+    if (style->textOverflow() || style->textSecurity() != TSNONE || style->hasTextCombine())
+        return false;
+    if (style->textShadow() || style->textStrokeWidth() > 0 || style->textEmphasisMark() != TextEmphasisMarkNone)
+        return false;
+    if (style->userModify() != READ_ONLY || style->visibility() != VISIBLE)
+        return false;
+    if (style->font().typesettingFeatures() || style->fontDescription().textRenderingMode() == GeometricPrecision)
+        return false;
+    if (style->hasPseudoStyle(FIRST_LINE) || style->hasPseudoStyle(FIRST_LETTER) || style->hasPseudoStyle(SELECTION))
+        return false;
+
+    RenderText* textRenderer = toRenderText(flow.firstChild());
+    if (textRenderer->isBR() || textRenderer->isCounter() || textRenderer->isQuote() || textRenderer->isTextFragment()
+        || textRenderer->isCombineText() || textRenderer->isSVGInlineText() || textRenderer->isWordBreak())
+        return false;
+    if (textRenderer->style() != style)
+        return false;
+    if (textRenderer->selectionState() != RenderObject::SelectionNone)
+        return false;
+    if (!textRenderer->canUseSimpleFontCodePath() || textRenderer->isAllCollapsibleWhitespace())
+        return false;
+
+    StringImpl* text = textRenderer->text();
+    if (text->is8Bit())
+        return canUseForText(text->characters8(), text->length(), style->font());
+    return canUseForText(text->characters16(), text->length(), style->font());
+}
+
+static float textWidth(const RenderBlock& flow, const RenderText& textRenderer, unsigned from, unsigned length, float xPosition)
+{
+    RenderStyle* style = flow.style();
+    TextRun run = RenderBlock::constructTextRun(const_cast<RenderBlock*>(&flow), style->font(), &textRenderer, from, length, style);
+    run.setCharactersLength(textRenderer.textLength() - from);
+    run.setXPos(xPosition);
+    return style->font().width(run);
+}
+
+PassOwnPtr<Layout> create(RenderBlock& flow)
+{
+    RenderText& textRenderer = *toRenderText(flow.firstChild());
+    RenderStyle* style = flow.style();
+    String text = textRenderer.text();
+    unsigned length = text.length();
+
+    float lineWidth = flow.availableLogicalWidth();
+    bool autoWrap = style->autoWrap();
+    bool breakNBSP = autoWrap && style->nbspMode() == SPACE;
+    float spaceWidth = style->font().width(RenderBlock::constructTextRun(&flow, style->font(), String(&space, 1), style));
+
+    LazyLineBreakIterator lineBreakIterator(text, style->locale());
+    int nextBreakable = -1;
+
+    OwnPtr<Layout> layout = adoptPtr(new Layout);
+
+    unsigned position = 0;
+    while (position < length) {
+        // Leading whitespace on a line collapses away.
+        while (position < length && isWhitespace(text[position]))
+            ++position;
+        if (position == length)
+            break;
+
+        unsigned runStart = position;
+        float runLeft = 0;
+        unsigned contentEnd = position;
+        float contentRight = 0;
+        float lineRight = 0;
+        bool lineHasContent = false;
+
+        while (position < length) {
+            unsigned fragmentEnd = position + 1;
+            while (fragmentEnd < length && !isWhitespace(text[fragmentEnd]) && !isBreakable(lineBreakIterator, fragmentEnd, nextBreakable, breakNBSP))
+                ++fragmentEnd;
+
+            float fragmentWidth = textWidth(flow, textRenderer, position, fragmentEnd - position, lineRight);
+            if (autoWrap && lineHasContent && lineRight + fragmentWidth > lineWidth)
+                break;
+            if (contentEnd == runStart) {
+                runStart = position;
+                runLeft = lineRight;
+            }
+
+            lineRight += fragmentWidth;
+            contentEnd = fragmentEnd;
+            contentRight = lineRight;
+            lineHasContent = true;
+            position = fragmentEnd;
+
+            if (position == length || !isWhitespace(text[position]))
+                continue;
+
+            unsigned whitespaceEnd = position + 1;
+            while (whitespaceEnd < length && isWhitespace(text[whitespaceEnd]))
+                ++whitespaceEnd;
+            // A single space can stay inside the run. Anything else collapses to one space, so the run
+            // is split around it to avoid painting the original characters.
+            if (whitespaceEnd - position > 1 || text[position] != ' ') {
+                layout->runs.append(Run(runStart, contentEnd, runLeft, contentRight, layout->lineCount));
+                runStart = whitespaceEnd;
+                contentEnd = whitespaceEnd;
+            }
+            lineRight += spaceWidth;
+            position = whitespaceEnd;
+        }
+
+        if (contentEnd > runStart)
+            layout->runs.append(Run(runStart, contentEnd, runLeft, contentRight, layout->lineCount));
+        ++layout->lineCount;
+    }
+
+    if (!layout->lineCount)
+        return nullptr;
+
+    return layout.release();
+}
+
+static LayoutUnit lineHeight(const RenderBlock& flow)
+{
+    return flow.lineHeight(false, HorizontalLine, PositionOfInteriorLineBoxes);
+}
+
+static LayoutUnit baselinePosition(const RenderBlock& flow)
+{
+    return flow.baselinePosition(AlphabeticBaseline, false, HorizontalLine, PositionOfInteriorLineBoxes);
+}
+
+static LayoutUnit lineTop(const RenderBlock& flow, unsigned lineIndex)
+{
+    return flow.borderAndPaddingBefore() + lineHeight(flow) * lineIndex;
+}
+
+static FloatRect runTextRect(const RenderBlock& flow, const Run& run)
+{
+    const FontMetrics& fontMetrics = flow.style()->fontMetrics();
+    float top = lineTop(flow, run.lineIndex) + baselinePosition(flow) - fontMetrics.ascent();
+    return FloatRect(flow.logicalLeftOffsetForContent() + run.left, top, run.right - run.left, fontMetrics.height());
+}
+
+LayoutUnit computeFlowHeight(const RenderBlock& flow, const Layout& layout)
+{
+    return lineHeight(flow) * layout.lineCount;
+}
+
+LayoutRect computeOverflow(const RenderBlock& flow, const Layout& layout)
+{
+    FloatRect overflowRect;
+    for (size_t i = 0; i < layout.runs.size(); ++i)
+        overflowRect.unite(runTextRect(flow, layout.runs[i]));
+    return enclosingLayoutRect(overflowRect);
+}
+
+LayoutUnit computeFirstBaseline(const RenderBlock& flow, const Layout&)
+{
+    return lineTop(flow, 0) + baselinePosition(flow);
+}
+
+LayoutUnit computeLastBaseline(const RenderBlock& flow, const Layout& layout)
+{
+    ASSERT(layout.lineCount);
+    return lineTop(flow, layout.lineCount - 1) + baselinePosition(flow);
+}
+
+void paintFlow(const RenderBlock& flow, const Layout& layout, PaintInfo& paintInfo, const LayoutPoint& paintOffset)
+{
+    // -webkit-background-clip: text paints the text in black into a mask with PaintPhaseTextClip.
+    if (paintInfo.phase != PaintPhaseForeground && paintInfo.phase != PaintPhaseTextClip)
+        return;
+    RenderStyle* style = flow.style();
+    if (style->visibility() != VISIBLE)
+        return;
+
+    RenderText& textRenderer = *toRenderText(flow.firstChild());
+    const Font& font = style->font();
+    GraphicsContext* context = paintInfo.context;
+
+    GraphicsContextStateSaver stateSaver(*context);
+    Color textFillColor = paintInfo.forceBlackText() ? Color::black : style->visitedDependentColor(CSSPropertyWebkitTextFillColor);
+    context->setFillColor(textFillColor, style->colorSpace());
+    context->setTextDrawingMode(TextModeFill);
+
+    LayoutUnit baseline = baselinePosition(flow);
+    LayoutUnit left = flow.logicalLeftOffsetForContent();
+    LayoutRect paintRect = paintInfo.rect;
+    paintRect.moveBy(-paintOffset);
+
+    for (size_t i = 0; i < layout.runs.size(); ++i) {
+        const Run& run = layout.runs[i];
+        FloatRect textRect = runTextRect(flow, run);
+        if (textRect.maxY() < paintRect.y())
+            continue;
+        if (textRect.y() > paintRect.maxY())
+            break;
+        TextRun textRun = RenderBlock::constructTextRun(const_cast<RenderBlock*>(&flow), font, &textRenderer, run.start, run.end - run.start, style);
+        textRun.setXPos(run.left);
+        FloatPoint textOrigin(paintOffset.x() + left + run.left, paintOffset.y() + lineTop(flow, run.lineIndex) + baseline);
+        context->drawText(font, textRun, textOrigin);
+    }
+}
+
+bool hitTestFlow(const RenderBlock& flow, const Layout& layout, const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset)
+{
+    RenderStyle* style = flow.style();
+    if (style->visibility() != VISIBLE || style->pointerEvents() == PE_NONE)
+        return false;
+
+    RenderText& textRenderer = *toRenderText(flow.firstChild());
+    for (size_t i = 0; i < layout.runs.size(); ++i) {
+        FloatRect rect = runTextRect(flow, layout.runs[i]);
+        rect.moveBy(accumulatedOffset);
+        if (!locationInContainer.intersects(rect))
+            continue;
+        textRenderer.updateHitTestResult(result, locationInContainer.point() - toLayoutSize(accumulatedOffset));
+        if (!result.addNodeToRectBasedTestResult(textRenderer.node(), request, locationInContainer, rect))
+            return true;
+    }
+    return false;
+}
+
+Vector<FloatRect> collectTextRects(const RenderText& textRenderer, const Layout& layout)
+{
+    ASSERT(textRenderer.parent() && textRenderer.parent()->isRenderBlock());
+    const RenderBlock& flow = *toRenderBlock(textRenderer.parent());
+
+    Vector<FloatRect> rects;
+    rects.reserveInitialCapacity(layout.runs.size());
+    for (size_t i = 0; i < layout.runs.size(); ++i)
+        rects.uncheckedAppend(runTextRect(flow, layout.runs[i]));
+    return rects;
+}
+
+unsigned computeTextRenderedLength(const Layout& layout)
+{
+    unsigned length = 0;
+    for (size_t i = 0; i < layout.runs.size(); ++i)
+        length += layout.runs[i].end - layout.runs[i].start;
+    return length;
+}
+
+} // namespace SimpleLineLayout
+} // namespace WebCore
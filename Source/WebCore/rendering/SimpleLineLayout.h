@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SimpleLineLayout_h
+#define SimpleLineLayout_h
+
+#include "LayoutRect.h"
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class HitTestLocation;
+class HitTestRequest;
+class HitTestResult;
+class RenderBlock;
+class RenderText;
+struct PaintInfo;
+
+// SimpleLineLayout lays out a block whose only child is a plain RenderText without building
+// RootInlineBoxes and InlineTextBoxes. Lines are stored as a flat list of text runs. If something
+// needs the line box tree (selection, editing, caret positioning, render tree dumps) the block
+// switches over to the normal line layout with RenderBlock::ensureLineBoxes().
+namespace SimpleLineLayout {
+
+struct Run {
+    Run(unsigned start, unsigned end, float left, float right, unsigned lineIndex)
+        : start(start)
+        , end(end)
+        , left(left)
+        , right(right)
+        , lineIndex(lineIndex)
+    {
+    }
+
+    unsigned start;
+    unsigned end;
+    float left;
+    float right;
+    unsigned lineIndex;
+};
+
+struct Layout {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    Layout()
+        : lineCount(0)
+    {
+    }
+
+    Vector<Run> runs;
+    unsigned lineCount;
+};
+
+bool canUseFor(const RenderBlock&);
+
+// Returns 0 if the text turns out to need something the simple path does not handle,
+// e.g. fallback fonts that would affect the line height.
+PassOwnPtr<Layout> create(RenderBlock&);
+
+LayoutUnit computeFlowHeight(const RenderBlock&, const Layout&);
+LayoutRect computeOverflow(const RenderBlock&, const Layout&);
+LayoutUnit computeFirstBaseline(const RenderBlock&, const Layout&);
+LayoutUnit computeLastBaseline(const RenderBlock&, const Layout&);
+
+void paintFlow(const RenderBlock&, const Layout&, PaintInfo&, const LayoutPoint& paintOffset);
+bool hitTestFlow(const RenderBlock&, const Layout&, const HitTestRequest&, HitTestResult&, const HitTestLocation&, const LayoutPoint& accumulatedOffset);
+
+// The runs in the coordinates their InlineTextBoxes would have, so that const RenderText
+// geometry queries can be answered without creating line boxes.
+Vector<FloatRect> collectTextRects(const RenderText&, const Layout&);
+unsigned computeTextRenderedLength(const Layout&);
+
+} // namespace SimpleLineLayout
+
+} // namespace WebCore
+
+#endif // SimpleLineLayout_h
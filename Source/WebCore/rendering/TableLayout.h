@@ -27,6 +27,8 @@
 namespace WebCore {
 
 class RenderTable;
+class RenderTableCell;
+class RenderTableRow;
 
 class TableLayout {
     WTF_MAKE_NONCOPYABLE(TableLayout); WTF_MAKE_FAST_ALLOCATED;
@@ -42,6 +44,14 @@ public:
     virtual void applyPreferredLogicalWidthQuirks(LayoutUnit& minWidth, LayoutUnit& maxWidth) const = 0;
     virtual void layout() = 0;
 
+    // Render tree changes that a layout may use to update its column data incrementally
+    // rather than rebuilding it from every cell in computeIntrinsicLogicalWidths().
+    virtual void rowWasAppended(RenderTableRow*) { }
+    virtual void rowWillBeRemoved(RenderTableRow*) { }
+    virtual void cellWillBeRemoved(RenderTableCell*) { }
+    virtual void cellPreferredLogicalWidthsWillChange(RenderTableCell*) { }
+    virtual void invalidateColumnData() { }
+
 protected:
     // FIXME: Once we enable SATURATED_LAYOUT_ARITHMETHIC, this should just be LayoutUnit::nearlyMax().
     // Until then though, using nearlyMax causes overflow in some tests, so we just pick a large number.
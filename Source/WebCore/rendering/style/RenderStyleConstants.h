@@ -194,6 +194,17 @@ enum EUserModify {
     READ_ONLY, READ_WRITE, READ_WRITE_PLAINTEXT_ONLY
 };
 
+// -webkit-contain
+// Layout containment makes the box a relayout boundary; paint containment clips its
+// contents and makes it a stacking context.
+
+enum Containment {
+    ContainNone = 0,
+    ContainLayout = 1 << 0,
+    ContainPaint = 1 << 1,
+    ContainStrict = ContainLayout | ContainPaint
+};
+
 // CSS3 User Drag Values
 
 enum EUserDrag {
@@ -67,6 +67,7 @@ StyleRareNonInheritedData::StyleRareNonInheritedData()
     , m_alignSelf(RenderStyle::initialAlignSelf())
     , m_justifyContent(RenderStyle::initialJustifyContent())
     , userDrag(RenderStyle::initialUserDrag())
+    , m_contain(RenderStyle::initialContain())
     , textOverflow(RenderStyle::initialTextOverflow())
     , marginBeforeCollapse(MCOLLAPSE)
     , marginAfterCollapse(MCOLLAPSE)
@@ -150,6 +151,7 @@ StyleRareNonInheritedData::StyleRareNonInheritedData(const StyleRareNonInherited
     , m_alignSelf(o.m_alignSelf)
     , m_justifyContent(o.m_justifyContent)
     , userDrag(o.userDrag)
+    , m_contain(o.m_contain)
     , textOverflow(o.textOverflow)
     , marginBeforeCollapse(o.marginBeforeCollapse)
     , marginAfterCollapse(o.marginAfterCollapse)
@@ -239,6 +241,7 @@ bool StyleRareNonInheritedData::operator==(const StyleRareNonInheritedData& o) c
         && m_alignSelf == o.m_alignSelf
         && m_justifyContent == o.m_justifyContent
         && userDrag == o.userDrag
+        && m_contain == o.m_contain
         && textOverflow == o.textOverflow
         && marginBeforeCollapse == o.marginBeforeCollapse
         && marginAfterCollapse == o.marginAfterCollapse
@@ -26,11 +26,16 @@
 #if ENABLE(SVG)
 #include "RenderSVGContainer.h"
 
+#include "DocumentMarkerController.h"
+#include "Frame.h"
+#include "FrameSelection.h"
 #include "GraphicsContext.h"
+#include "ImageBuffer.h"
 #include "LayoutRepainter.h"
 #include "RenderSVGResource.h"
 #include "RenderSVGResourceFilter.h"
 #include "RenderView.h"
+#include "SVGContainerBitmapCache.h"
 #include "SVGRenderingContext.h"
 #include "SVGResources.h"
 #include "SVGResourcesCache.h"
@@ -39,15 +44,28 @@
 
 namespace WebCore {
 
+// Below this, drawing the bitmap is not much cheaper than painting the children.
+static const unsigned minimumDescendantCountForBitmap = 4;
+
+// Set while a container paints its children into its bitmap, so that nested
+// containers do not keep bitmaps of their own for the same content.
+static bool paintingChildrenIntoBitmap = false;
+
 RenderSVGContainer::RenderSVGContainer(SVGStyledElement* node)
     : RenderSVGModelObject(node)
     , m_objectBoundingBoxValid(false)
     , m_needsBoundariesUpdate(true)
+    , m_paintedChildrenSinceInvalidation(false)
+    , m_hasForeignObjectDescendant(false)
+    , m_isInBitmapCache(false)
+    , m_descendantCount(0)
 {
 }
 
 RenderSVGContainer::~RenderSVGContainer()
 {
+    if (m_isInBitmapCache)
+        SVGContainerBitmapCache::shared().remove(this);
 }
 
 void RenderSVGContainer::layout()
@@ -60,6 +78,8 @@ void RenderSVGContainer::layout()
 
     LayoutRepainter repainter(*this, SVGRenderSupport::checkForSVGRepaintDuringLayout(this) || selfWillPaint());
 
+    clearChildrenBitmap();
+
     // Allow RenderSVGViewportContainer to update its viewport.
     calcViewport();
 
@@ -70,6 +90,7 @@ void RenderSVGContainer::layout()
     determineIfLayoutSizeChanged();
 
     SVGRenderSupport::layoutChildren(this, selfNeedsLayout() || SVGRenderSupport::filtersForceContainerLayout(this));
+    updateDescendantCount();
 
     // Invalidate all resources of this client if our layout changed.
     if (everHadLayout() && needsLayout())
@@ -139,8 +160,8 @@ void RenderSVGContainer::paint(PaintInfo& paintInfo, const LayoutPoint&)
 
         if (continueRendering) {
             childPaintInfo.updateSubtreePaintRootForChildren(this);
-            for (RenderObject* child = firstChild(); child; child = child->nextSibling())
-                child->paint(childPaintInfo, IntPoint());
+            if (!paintChildrenFromBitmap(childPaintInfo))
+                paintChildren(childPaintInfo);
         }
     }
     
@@ -155,6 +176,124 @@ void RenderSVGContainer::paint(PaintInfo& paintInfo, const LayoutPoint&)
     }
 }
 
+void RenderSVGContainer::paintChildren(PaintInfo& paintInfo)
+{
+    for (RenderObject* child = firstChild(); child; child = child->nextSibling())
+        child->paint(paintInfo, IntPoint());
+}
+
+bool RenderSVGContainer::canPaintChildrenFromBitmap(const PaintInfo& paintInfo) const
+{
+    if (paintInfo.phase != PaintPhaseForeground || paintInfo.paintBehavior != PaintBehaviorNormal || paintInfo.subtreePaintRoot)
+        return false;
+
+    if (paintingChildrenIntoBitmap || document()->printing())
+        return false;
+
+    // Selections and markers, such as find-in-page highlights, repaint the text
+    // they cover without invalidating the containers around it.
+    if (frame()->selection()->isRange() || document()->markers()->possiblyHasMarkers(DocumentMarker::AllMarkers()))
+        return false;
+
+    // Walks with painting disabled must neither count as a paint of the
+    // children nor record them.
+    if (paintInfo.context->paintingDisabled())
+        return false;
+
+    // Foreign objects paint HTML content, which may have layers, widgets or a caret of its own.
+    return !m_hasForeignObjectDescendant && m_descendantCount >= minimumDescendantCountForBitmap;
+}
+
+bool RenderSVGContainer::paintChildrenFromBitmap(PaintInfo& paintInfo)
+{
+    if (!canPaintChildrenFromBitmap(paintInfo))
+        return false;
+
+    // A rotated or skewed bitmap would have to be resampled, which neither looks nor performs well.
+    AffineTransform ctm = paintInfo.context->getCTM(GraphicsContext::DefinitelyIncludeDeviceScale);
+    if (ctm.b() || ctm.c())
+        return false;
+
+    // Only the fractional part of the translation is part of the bitmap, so that
+    // scrolling by whole pixels keeps using it.
+    double translationX = floor(ctm.e());
+    double translationY = floor(ctm.f());
+    AffineTransform bitmapTransform(ctm.a(), 0, 0, ctm.d(), ctm.e() - translationX, ctm.f() - translationY);
+
+    if (m_childrenBitmap && bitmapTransform != m_childrenBitmapTransform)
+        clearChildrenBitmap();
+
+    if (!m_childrenBitmap) {
+        // Like display lists, the bitmap is only created the second time the children
+        // are painted the same way without having changed in between. This keeps
+        // animated content and content that is being zoomed from ever using it.
+        if (!m_paintedChildrenSinceInvalidation || bitmapTransform != m_childrenBitmapTransform) {
+            m_paintedChildrenSinceInvalidation = true;
+            m_childrenBitmapTransform = bitmapTransform;
+            return false;
+        }
+
+        IntRect bitmapRect = enclosingIntRect(bitmapTransform.mapRect(repaintRectInLocalCoordinates()));
+        if (!SVGContainerBitmapCache::canCacheBitmapOfSize(bitmapRect.size()))
+            return false;
+
+        OwnPtr<ImageBuffer> bitmap = ImageBuffer::createCompatibleBuffer(bitmapRect.size(), 1, ColorSpaceDeviceRGB, paintInfo.context, true);
+        if (!bitmap)
+            return false;
+
+        GraphicsContext* bitmapContext = bitmap->context();
+        bitmapContext->translate(-bitmapRect.x(), -bitmapRect.y());
+        bitmapContext->concatCTM(bitmapTransform);
+
+        // The bitmap holds all of the children, not just the part that is being repainted.
+        PaintInfo bitmapPaintInfo(paintInfo);
+        bitmapPaintInfo.context = bitmapContext;
+        bitmapPaintInfo.rect = PaintInfo::infiniteRect();
+
+        paintingChildrenIntoBitmap = true;
+        paintChildren(bitmapPaintInfo);
+        paintingChildrenIntoBitmap = false;
+
+        m_childrenBitmap = bitmap.release();
+        m_childrenBitmapOrigin = bitmapRect.location();
+    }
+
+    GraphicsContextStateSaver stateSaver(*paintInfo.context);
+    paintInfo.context->concatCTM(m_childrenBitmapTransform.inverse());
+    paintInfo.context->drawImageBuffer(m_childrenBitmap.get(), ColorSpaceDeviceRGB, m_childrenBitmapOrigin);
+
+    // Children that repainted themselves while being painted into the bitmap,
+    // like images that just got decoded, have already invalidated it.
+    if (m_paintedChildrenSinceInvalidation)
+        SVGContainerBitmapCache::shared().didPaintBitmap(this, m_childrenBitmap->internalSize());
+    else
+        m_childrenBitmap.clear();
+    return true;
+}
+
+void RenderSVGContainer::updateDescendantCount()
+{
+    m_descendantCount = 0;
+    m_hasForeignObjectDescendant = false;
+    for (RenderObject* child = firstChild(); child; child = child->nextSibling()) {
+        ++m_descendantCount;
+        if (child->isSVGContainer()) {
+            RenderSVGContainer* container = toRenderSVGContainer(child);
+            m_descendantCount += container->m_descendantCount;
+            m_hasForeignObjectDescendant |= container->m_hasForeignObjectDescendant;
+        } else if (child->isSVGForeignObject())
+            m_hasForeignObjectDescendant = true;
+    }
+}
+
+void RenderSVGContainer::clearChildrenBitmap()
+{
+    m_paintedChildrenSinceInvalidation = false;
+    m_childrenBitmap.clear();
+    if (m_isInBitmapCache)
+        SVGContainerBitmapCache::shared().remove(this);
+}
+
 // addFocusRingRects is called from paintOutline and needs to be in the same coordinates as the paintOuline call
 void RenderSVGContainer::addFocusRingRects(Vector<IntRect>& rects, const LayoutPoint&, const RenderLayerModelObject*)
 {
@@ -25,10 +25,13 @@
 
 #if ENABLE(SVG)
 
+#include "AffineTransform.h"
 #include "RenderSVGModelObject.h"
+#include <wtf/OwnPtr.h>
 
 namespace WebCore {
 
+class ImageBuffer;
 class SVGElement;
 
 class RenderSVGContainer : public RenderSVGModelObject {
@@ -48,6 +51,10 @@ public:
     virtual bool didTransformToRootUpdate() { return false; }
     bool isObjectBoundingBoxValid() const { return m_objectBoundingBoxValid; }
 
+    // Called when a descendant changed without being laid out again, so that
+    // the children are no longer drawn from the bitmap they were painted into.
+    void clearChildrenBitmap();
+
 protected:
     virtual RenderObjectChildList* virtualChildren() { return children(); }
     virtual const RenderObjectChildList* virtualChildren() const { return children(); }
@@ -81,12 +88,33 @@ protected:
     void updateCachedBoundaries();
 
 private:
+    friend class SVGContainerBitmapCache;
+
+    void paintChildren(PaintInfo&);
+
+    // Children that have not changed since they were last painted at the same
+    // device scale are drawn from a bitmap. Returns false if the children have
+    // to be painted instead.
+    bool paintChildrenFromBitmap(PaintInfo&);
+    bool canPaintChildrenFromBitmap(const PaintInfo&) const;
+    void updateDescendantCount();
+
     RenderObjectChildList m_children;
     FloatRect m_objectBoundingBox;
     bool m_objectBoundingBoxValid;
     FloatRect m_strokeBoundingBox;
     FloatRect m_repaintBoundingBox;
     bool m_needsBoundariesUpdate : 1;
+    bool m_paintedChildrenSinceInvalidation : 1;
+    bool m_hasForeignObjectDescendant : 1;
+    bool m_isInBitmapCache : 1;
+    unsigned m_descendantCount;
+
+    // The transform from local to bitmap coordinates, which is the CTM the
+    // children were painted with minus the integral part of its translation.
+    AffineTransform m_childrenBitmapTransform;
+    IntPoint m_childrenBitmapOrigin;
+    OwnPtr<ImageBuffer> m_childrenBitmap;
 };
   
 inline RenderSVGContainer* toRenderSVGContainer(RenderObject* object)
@@ -27,6 +27,7 @@
 
 #include "Frame.h"
 #include "FrameView.h"
+#include "RenderSVGContainer.h"
 #include "RenderSVGResourceClipper.h"
 #include "RenderSVGResourceContainer.h"
 #include "RenderSVGResourceFilter.h"
@@ -199,6 +200,14 @@ void RenderSVGResource::markForLayoutAndParentResourceInvalidation(RenderObject*
     if (needsLayout)
         object->setNeedsLayout(true);
 
+    // Every change to the content of a container that does not lay it out
+    // again, from style changes to images that loaded and resources that
+    // changed, comes through here.
+    for (RenderObject* ancestor = object; ancestor; ancestor = ancestor->parent()) {
+        if (ancestor->isSVGContainer())
+            toRenderSVGContainer(ancestor)->clearChildrenBitmap();
+    }
+
     removeFromCacheAndInvalidateDependencies(object, needsLayout);
 
     // Invalidate resources in ancestor chain, if needed.
@@ -28,6 +28,7 @@
 
 #include "AffineTransform.h"
 #include "FilterEffect.h"
+#include "FilterResultCache.h"
 #include "FloatPoint.h"
 #include "FloatRect.h"
 #include "GraphicsContext.h"
@@ -322,6 +323,10 @@ void RenderSVGResourceFilter::postApplyResource(RenderObject* object, GraphicsCo
             context->scale(filterData->filter->filterResolution());
 
             context->concatCTM(filterData->shearFreeAbsoluteTransform);
+
+            // The result is kept until the client is invalidated, unless other
+            // filters need the memory first.
+            FilterResultCache::shared().didPaintResults(lastEffect);
         }
     }
     filterData->sourceGraphicBuffer.clear();
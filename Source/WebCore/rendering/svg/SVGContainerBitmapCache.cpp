@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(SVG)
+#include "SVGContainerBitmapCache.h"
+
+#include "RenderSVGContainer.h"
+#include <wtf/MainThread.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// Enough for a full screen of SVG at a device scale of two, plus a few icons.
+static const size_t maximumSizeInBytes = 16 * 1024 * 1024;
+
+static inline size_t bitmapSizeInBytes(const IntSize& size)
+{
+    return static_cast<size_t>(size.width()) * size.height() * 4;
+}
+
+SVGContainerBitmapCache& SVGContainerBitmapCache::shared()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(SVGContainerBitmapCache, cache, ());
+    return cache;
+}
+
+SVGContainerBitmapCache::SVGContainerBitmapCache()
+    : m_budget(maximumSizeInBytes, evictBitmap)
+{
+}
+
+bool SVGContainerBitmapCache::canCacheBitmapOfSize(const IntSize& size)
+{
+    return !size.isEmpty() && bitmapSizeInBytes(size) <= maximumSizeInBytes / 4;
+}
+
+void SVGContainerBitmapCache::didPaintBitmap(RenderSVGContainer* container, const IntSize& size)
+{
+    container->m_isInBitmapCache = true;
+    m_budget.didUse(container, bitmapSizeInBytes(size));
+}
+
+void SVGContainerBitmapCache::remove(RenderSVGContainer* container)
+{
+    m_budget.remove(container);
+    container->m_isInBitmapCache = false;
+}
+
+void SVGContainerBitmapCache::releaseAllBitmaps()
+{
+    m_budget.evictAll();
+}
+
+void SVGContainerBitmapCache::evictBitmap(RenderSVGContainer* container)
+{
+    container->m_isInBitmapCache = false;
+    container->clearChildrenBitmap();
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(SVG)
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SVGContainerBitmapCache_h
+#define SVGContainerBitmapCache_h
+
+#if ENABLE(SVG)
+#include "IntSize.h"
+#include "PaintCacheBudget.h"
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+
+class RenderSVGContainer;
+
+// SVG containers whose children have not changed between paints draw them from
+// a bitmap at the current device scale, see RenderSVGContainer::paint(). This
+// accounts for the memory of those bitmaps, and drops the least recently
+// painted ones when they add up to more than the budget.
+class SVGContainerBitmapCache {
+    WTF_MAKE_NONCOPYABLE(SVGContainerBitmapCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static SVGContainerBitmapCache& shared();
+
+    // Whether bitmaps of this size, in device pixels, are worth keeping at all.
+    static bool canCacheBitmapOfSize(const IntSize&);
+
+    // Called whenever |container| has painted its children from its bitmap,
+    // which becomes the most recently used one.
+    void didPaintBitmap(RenderSVGContainer*, const IntSize&);
+
+    // Stops accounting for the bitmap of |container|; the bitmap is left alone.
+    void remove(RenderSVGContainer*);
+
+    // Drops every bitmap, when the system is low on memory.
+    void releaseAllBitmaps();
+
+    size_t sizeInBytes() const { return m_budget.sizeInBytes(); }
+
+private:
+    SVGContainerBitmapCache();
+
+    static void evictBitmap(RenderSVGContainer*);
+
+    PaintCacheBudget<RenderSVGContainer> m_budget;
+};
+
+} // namespace WebCore
+
+#endif // ENABLE(SVG)
+
+#endif // SVGContainerBitmapCache_h
@@ -133,6 +133,12 @@ String StorageAreaImpl::key(unsigned index)
 String StorageAreaImpl::item(const String& key)
 {
     ASSERT(!m_isShutdown);
+
+    // Reads don't wait for an origin's whole storage to be imported; nothing else can
+    // change the items until it has been.
+    String value;
+    if (m_storageAreaSync && m_storageAreaSync->lookUpItemDuringImport(key, value))
+        return value;
     blockUntilImportComplete();
 
     return m_storageMap->getItem(key);
@@ -200,6 +206,10 @@ void StorageAreaImpl::clear(Frame* sourceFrame)
 bool StorageAreaImpl::contains(const String& key)
 {
     ASSERT(!m_isShutdown);
+
+    String value;
+    if (m_storageAreaSync && m_storageAreaSync->lookUpItemDuringImport(key, value))
+        return !value.isNull();
     blockUntilImportComplete();
 
     return m_storageMap->contains(key);
@@ -29,6 +29,7 @@
 #include "EventNames.h"
 #include "FileSystem.h"
 #include "HTMLElement.h"
+#include "Logging.h"
 #include "SQLiteFileSystem.h"
 #include "SQLiteStatement.h"
 #include "SQLiteTransaction.h"
@@ -37,6 +38,7 @@
 #include "StorageSyncManager.h"
 #include "StorageTracker.h"
 #include "SuddenTermination.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/Functional.h>
 #include <wtf/MainThread.h>
 #include <wtf/text/CString.h>
@@ -51,12 +53,25 @@ static const double StorageSyncInterval = 1.0;
 // much harder to starve the rest of LocalStorage and the OS's IO subsystem in general.
 static const int MaxiumItemsToSync = 100;
 
+static Mutex& statisticsMutex()
+{
+    DEFINE_STATIC_LOCAL(Mutex, mutex, ());
+    return mutex;
+}
+
+static StorageAreaSync::Statistics& mutableStatistics()
+{
+    static StorageAreaSync::Statistics statistics = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    return statistics;
+}
+
 inline StorageAreaSync::StorageAreaSync(PassRefPtr<StorageSyncManager> storageSyncManager, PassRefPtr<StorageAreaImpl> storageArea, const String& databaseIdentifier)
     : m_syncTimer(this, &StorageAreaSync::syncTimerFired)
     , m_itemsCleared(false)
     , m_finalSyncScheduled(false)
     , m_storageArea(storageArea)
     , m_syncManager(storageSyncManager)
+    , m_lookupDatabaseOpenFailed(false)
     , m_databaseIdentifier(databaseIdentifier.isolatedCopy())
     , m_clearItemsWhileSyncing(false)
     , m_syncScheduled(false)
@@ -69,6 +84,9 @@ inline StorageAreaSync::StorageAreaSync(PassRefPtr<StorageSyncManager> storageSy
     ASSERT(m_storageArea);
     ASSERT(m_syncManager);
 
+    // Make sure the statistics are set up before the storage thread gets to them.
+    statisticsMutex();
+
     // FIXME: If it can't import, then the default WebKit behavior should be that of private browsing,
     // not silently ignoring it. https://bugs.webkit.org/show_bug.cgi?id=25894
     m_syncManager->dispatch(bind(&StorageAreaSync::performImport, this));
@@ -255,6 +273,13 @@ void StorageAreaSync::openDatabase(OpenDatabaseParamType openingStrategy)
         return;
     }
 
+    // With write-ahead logging, a commit appends to the log instead of going through a
+    // rollback journal, and the lookups of the main thread don't block the import.
+    SQLiteStatement journalMode(m_database, "PRAGMA journal_mode=WAL");
+    if (journalMode.prepare() != SQLResultOk || journalMode.step() != SQLResultRow || !equalIgnoringCase(journalMode.getColumnText(0), "wal"))
+        LOG_ERROR("Failed to switch the local storage database to write-ahead logging");
+    journalMode.finalize();
+
     migrateItemTableIfNeeded();
 
     if (!m_database.executeCommand("CREATE TABLE IF NOT EXISTS ItemTable (key TEXT UNIQUE ON CONFLICT REPLACE, value BLOB NOT NULL ON CONFLICT FAIL)")) {
@@ -315,6 +340,8 @@ void StorageAreaSync::performImport()
     ASSERT(!isMainThread());
     ASSERT(!m_database.isOpen());
 
+    double startTime = monotonicallyIncreasingTime();
+
     openDatabase(SkipIfNonExistent);
     if (!m_database.isOpen()) {
         markImported();
@@ -328,6 +355,9 @@ void StorageAreaSync::performImport()
         return;
     }
 
+    // Nothing writes to the database until the import has completed.
+    markReadyForLookups(m_syncManager->fullDatabaseFilename(m_databaseIdentifier));
+
     HashMap<String, String> itemMap;
 
     int result = query.step();
@@ -344,6 +374,17 @@ void StorageAreaSync::performImport()
 
     m_storageArea->importItems(itemMap);
 
+    double importTime = monotonicallyIncreasingTime() - startTime;
+    LOG(StorageAPI, "Imported %d local storage items for %s in %.1f ms", itemMap.size(), m_databaseIdentifier.utf8().data(), importTime * 1000);
+    {
+        MutexLocker locker(statisticsMutex());
+        Statistics& statistics = mutableStatistics();
+        ++statistics.importCount;
+        statistics.importedItemCount += itemMap.size();
+        statistics.importTime += importTime;
+        statistics.maximumImportTime = std::max(statistics.maximumImportTime, importTime);
+    }
+
     markImported();
 }
 
@@ -354,6 +395,61 @@ void StorageAreaSync::markImported()
     m_importCondition.signal();
 }
 
+void StorageAreaSync::markReadyForLookups(const String& databaseFilename)
+{
+    MutexLocker locker(m_importLock);
+    m_databaseFilenameForLookups = databaseFilename.isolatedCopy();
+    m_importCondition.signal();
+}
+
+bool StorageAreaSync::lookUpItemDuringImport(const String& key, String& value)
+{
+    ASSERT(isMainThread());
+
+    // m_storageArea is cleared once the import is known to have completed.
+    if (!m_storageArea || m_lookupDatabaseOpenFailed)
+        return false;
+
+    if (!m_lookupDatabase.isOpen()) {
+        String databaseFilename;
+        {
+            // Opening and migrating the database is quick compared to reading all of it.
+            MutexLocker locker(m_importLock);
+            while (!m_importComplete && m_databaseFilenameForLookups.isNull())
+                m_importCondition.wait(m_importLock);
+            if (m_importComplete)
+                return false;
+            databaseFilename = m_databaseFilenameForLookups;
+        }
+
+        if (databaseFilename.isEmpty() || !m_lookupDatabase.open(databaseFilename)) {
+            m_lookupDatabaseOpenFailed = true;
+            return false;
+        }
+    } else {
+        MutexLocker locker(m_importLock);
+        if (m_importComplete)
+            return false;
+    }
+
+    SQLiteStatement query(m_lookupDatabase, "SELECT value FROM ItemTable WHERE key=?");
+    if (query.prepare() != SQLResultOk)
+        return false;
+    query.bindText(1, key);
+
+    int result = query.step();
+    if (result == SQLResultRow)
+        value = query.getColumnBlobAsString(0);
+    else if (result == SQLResultDone)
+        value = String();
+    else
+        return false;
+
+    MutexLocker locker(statisticsMutex());
+    ++mutableStatistics().lookupDuringImportCount;
+    return true;
+}
+
 // FIXME: In the future, we should allow use of StorageAreas while it's importing (when safe to do so).
 // Blocking everything until the import is complete is by far the simplest and safest thing to do, but
 // there is certainly room for safe optimization: Key/length will never be able to make use of such an
@@ -369,10 +465,13 @@ void StorageAreaSync::blockUntilImportComplete()
     if (!m_storageArea)
         return;
 
-    MutexLocker locker(m_importLock);
-    while (!m_importComplete)
-        m_importCondition.wait(m_importLock);
+    {
+        MutexLocker locker(m_importLock);
+        while (!m_importComplete)
+            m_importCondition.wait(m_importLock);
+    }
     m_storageArea = 0;
+    m_lookupDatabase.close();
 }
 
 void StorageAreaSync::sync(bool clearItems, const HashMap<String, String>& items)
@@ -432,6 +531,8 @@ void StorageAreaSync::sync(bool clearItems, const HashMap<String, String>& items
 
     HashMap<String, String>::const_iterator end = items.end();
 
+    double startTime = monotonicallyIncreasingTime();
+
     SQLiteTransaction transaction(m_database);
     transaction.begin();
     for (HashMap<String, String>::const_iterator it = items.begin(); it != end; ++it) {
@@ -453,6 +554,16 @@ void StorageAreaSync::sync(bool clearItems, const HashMap<String, String>& items
         query.reset();
     }
     transaction.commit();
+
+    double flushTime = monotonicallyIncreasingTime() - startTime;
+    LOG(StorageAPI, "Flushed %d local storage items for %s in %.1f ms", items.size(), m_databaseIdentifier.utf8().data(), flushTime * 1000);
+
+    MutexLocker locker(statisticsMutex());
+    Statistics& statistics = mutableStatistics();
+    ++statistics.flushCount;
+    statistics.flushedItemCount += items.size();
+    statistics.flushTime += flushTime;
+    statistics.maximumFlushTime = std::max(statistics.maximumFlushTime, flushTime);
 }
 
 void StorageAreaSync::performSync()
@@ -523,4 +634,16 @@ void StorageAreaSync::scheduleSync()
     syncTimerFired(&m_syncTimer);
 }
 
+StorageAreaSync::Statistics StorageAreaSync::statistics()
+{
+    MutexLocker locker(statisticsMutex());
+    return mutableStatistics();
+}
+
+void StorageAreaSync::resetStatistics()
+{
+    MutexLocker locker(statisticsMutex());
+    mutableStatistics() = Statistics();
+}
+
 } // namespace WebCore
@@ -45,12 +45,33 @@ public:
     void scheduleFinalSync();
     void blockUntilImportComplete();
 
+    // While the import is still running, reads a single item straight from the database
+    // rather than waiting for all of them. Returns false once the import has completed,
+    // or if the database can't be read from the main thread; the storage map has to be
+    // used then.
+    bool lookUpItemDuringImport(const String& key, String& value);
+
     void scheduleItemForSync(const String& key, const String& value);
     void scheduleClear();
     void scheduleCloseDatabase();
 
     void scheduleSync();
 
+    struct Statistics {
+        unsigned importCount;
+        unsigned importedItemCount;
+        double importTime;
+        double maximumImportTime;
+        unsigned lookupDuringImportCount;
+        unsigned flushCount;
+        unsigned flushedItemCount;
+        double flushTime;
+        double maximumFlushTime;
+    };
+    // Imports and flushes happen on the storage thread, so this returns a copy.
+    static Statistics statistics();
+    static void resetStatistics();
+
 private:
     StorageAreaSync(PassRefPtr<StorageSyncManager>, PassRefPtr<StorageAreaImpl>, const String& databaseIdentifier);
 
@@ -68,6 +89,10 @@ private:
     // The database handle will only ever be opened and used on the background thread.
     SQLiteDatabase m_database;
 
+    // Only used on the main thread, and only while the import is in progress.
+    SQLiteDatabase m_lookupDatabase;
+    bool m_lookupDatabaseOpenFailed;
+
     // The following members are subject to thread synchronization issues.
 public:
     // Called from the background thread
@@ -99,7 +124,10 @@ private:
     mutable Mutex m_importLock;
     mutable ThreadCondition m_importCondition;
     mutable bool m_importComplete;
+    // Set once the database is open and up to date, and lookups can go to it.
+    String m_databaseFilenameForLookups;
     void markImported();
+    void markReadyForLookups(const String& databaseFilename);
     void migrateItemTableIfNeeded();
 };
 
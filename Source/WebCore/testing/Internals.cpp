@@ -79,11 +79,13 @@
 #include "PseudoElement.h"
 #include "Range.h"
 #include "RenderEmbeddedObject.h"
+#include "RenderFlexibleBox.h"
 #include "RenderMenuList.h"
 #include "RenderObject.h"
 #include "RenderTheme.h"
 #include "RenderTreeAsText.h"
 #include "RenderView.h"
+#include "ResourceLoadScheduler.h"
 #include "RuntimeEnabledFeatures.h"
 #include "SchemeRegistry.h"
 #include "ScrollingCoordinator.h"
@@ -1744,6 +1746,75 @@ String Internals::counterValue(Element* element)
     return counterValueForElement(element);
 }
 
+unsigned Internals::flexItemLayoutCount(Element* element, ExceptionCode& ec)
+{
+    if (!element) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    element->document()->updateLayoutIgnorePendingStylesheets();
+    RenderObject* renderer = element->renderer();
+    if (!renderer || !renderer->isFlexibleBox()) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return toRenderFlexibleBox(renderer)->childLayoutCount();
+}
+
+Node* Internals::pendingLayoutRoot(Document* document, ExceptionCode& ec)
+{
+    if (!document || !document->view()) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    // Only a subtree layout has a root; a full layout of the view reports none.
+    RenderObject* root = document->view()->layoutRoot();
+    return root ? root->node() : 0;
+}
+
+static bool resourceLoadPriorityFromString(const String& name, ResourceLoadPriority& priority)
+{
+    static const char* const names[] = { "VeryLow", "Low", "Medium", "High", "VeryHigh" };
+    COMPILE_ASSERT(WTF_ARRAY_LENGTH(names) == ResourceLoadPriorityHighest + 1, ResourceLoadPriorityNamesMatchEnum);
+    for (int i = ResourceLoadPriorityLowest; i <= ResourceLoadPriorityHighest; ++i) {
+        if (name == names[i]) {
+            priority = static_cast<ResourceLoadPriority>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Internals::resetResourceLoadStatistics()
+{
+    ResourceLoadScheduler::resetStatistics();
+}
+
+unsigned Internals::resourceLoadStartedCount(const String& priorityName, ExceptionCode& ec)
+{
+    ResourceLoadPriority priority;
+    if (!resourceLoadPriorityFromString(priorityName, priority)) {
+        ec = SYNTAX_ERR;
+        return 0;
+    }
+
+    return ResourceLoadScheduler::statistics().startedRequestCount[priority];
+}
+
+double Internals::resourceLoadMaximumQueueTime(const String& priorityName, ExceptionCode& ec)
+{
+    ResourceLoadPriority priority;
+    if (!resourceLoadPriorityFromString(priorityName, priority)) {
+        ec = SYNTAX_ERR;
+        return 0;
+    }
+
+    return ResourceLoadScheduler::statistics().maximumQueueTime[priority];
+}
+
 int Internals::pageNumber(Element* element, float pageWidth, float pageHeight)
 {
     if (!element)
@@ -249,6 +249,12 @@ public:
 #endif
 
     String counterValue(Element*);
+    unsigned flexItemLayoutCount(Element*, ExceptionCode&);
+    Node* pendingLayoutRoot(Document*, ExceptionCode&);
+
+    void resetResourceLoadStatistics();
+    unsigned resourceLoadStartedCount(const String& priority, ExceptionCode&);
+    double resourceLoadMaximumQueueTime(const String& priority, ExceptionCode&);
 
     int pageNumber(Element*, float pageWidth = 800, float pageHeight = 600);
     Vector<String> shortcutIconURLs(Document*) const;
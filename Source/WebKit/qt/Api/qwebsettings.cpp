@@ -26,6 +26,7 @@
 #include "CrossOriginPreflightResultCache.h"
 #include "DatabaseManager.h"
 #include "FileSystem.h"
+#include "FilterResultCache.h"
 #include "FontCache.h"
 #include "GCController.h"
 #include "GroupSettings.h"
@@ -38,11 +39,15 @@
 #include "IntSize.h"
 #include "KURL.h"
 #include "MemoryCache.h"
+#if !USE(SOUP)
+#include "NetworkDiskCacheQt.h"
+#endif
 #include "NetworkStateNotifier.h"
 #include "Page.h"
 #include "PageCache.h"
 #include "PluginDatabase.h"
 #include "RuntimeEnabledFeatures.h"
+#include "SVGContainerBitmapCache.h"
 #include "Settings.h"
 #include "StorageThread.h"
 #include "WorkerThread.h"
@@ -887,6 +892,16 @@ void QWebSettings::clearMemoryCaches()
     // Empty the Cross-Origin Preflight cache
     WebCore::CrossOriginPreflightResultCache::shared().empty();
 
+#if ENABLE(FILTERS)
+    // Drop the results filters keep between paints.
+    WebCore::FilterResultCache::shared().releaseAllResults();
+#endif
+
+#if ENABLE(SVG)
+    // Drop the bitmaps SVG containers draw unchanged children from.
+    WebCore::SVGContainerBitmapCache::shared().releaseAllBitmaps();
+#endif
+
     // Drop JIT compiled code from ExecutableAllocator.
     WebCore::gcController().discardAllCompiledCode();
     // Garbage Collect to release the references of CachedResource from dead objects.
@@ -1273,6 +1288,13 @@ void QWebSettings::enablePersistentStorage(const QString& path)
     QWebSettings::globalSettings()->setAttribute(QWebSettings::OfflineStorageDatabaseEnabled, true);
     QWebSettings::globalSettings()->setAttribute(QWebSettings::OfflineWebApplicationCacheEnabled, true);
 
+#if !USE(SOUP)
+    // Keep responses on disk beneath the memory cache, for the network access managers QWebPage creates.
+    QString diskCachePath = path.isEmpty() ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) : storagePath;
+    if (!diskCachePath.isEmpty())
+        WebCore::NetworkDiskCacheQt::create(WebCore::pathByAppendingComponent(diskCachePath, "NetworkCache"));
+#endif
+
 #if ENABLE(NETSCAPE_PLUGIN_METADATA_CACHE)
     // All applications can share the common QtWebkit cache file(s).
     // Path is not configurable and uses QDesktopServices::CacheLocation by default.
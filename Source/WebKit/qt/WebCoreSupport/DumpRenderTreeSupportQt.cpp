@@ -25,6 +25,7 @@
 
 #include "APICast.h"
 #include "ApplicationCacheStorage.h"
+#include "BitmapImage.h"
 #include "ChromeClientQt.h"
 #include "ContainerNode.h"
 #include "ContextMenu.h"
@@ -211,6 +212,10 @@ void DumpRenderTreeSupportQt::overwritePluginDirectories()
 void DumpRenderTreeSupportQt::setDumpRenderTreeModeEnabled(bool b)
 {
     QWebPageAdapter::drtRun = b;
+#if USE(ASYNC_IMAGE_DECODING)
+    // Test results must not depend on when the decoding threads finish.
+    BitmapImage::setAsyncDecodingEnabled(!b);
+#endif
 #if ENABLE(NETSCAPE_PLUGIN_API) && defined(XP_UNIX)
     // PluginViewQt (X11) needs a few workarounds when running under DRT
     PluginView::setIsRunningUnderDRT(b);
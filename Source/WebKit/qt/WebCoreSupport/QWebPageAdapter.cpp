@@ -118,6 +118,7 @@
 
 #if !USE(SOUP)
 #include "CookieJarQt.h"
+#include "NetworkDiskCacheQt.h"
 #endif
 
 // from text/qfont.cpp
@@ -389,6 +390,12 @@ QNetworkAccessManager* QWebPageAdapter::networkAccessManager()
           networkManager->setCookieJar(cookieJar);
           cookieJar->setParent(0);
       }
+
+        // Likewise the shared disk cache, see QWebSettings::enablePersistentStorage().
+        if (NetworkDiskCacheQt* diskCache = NetworkDiskCacheQt::shared()) {
+            networkManager->setCache(diskCache);
+            diskCache->setParent(0);
+        }
 #endif
      }
     return networkManager;
@@ -0,0 +1,496 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <math.h>
+#include <qbuffer.h>
+#include <qpainter.h>
+#include <qwebframe.h>
+#include <qwebpage.h>
+
+#include "util.h"
+
+// Paints pages whose content goes through one SVG filter primitive, which is
+// applied again on every paint. Filters run in sRGB so that the pixels can be
+// checked without going through the linearRGB conversion.
+//
+// The *Noise tests filter random pixels and compare every pixel of the result
+// with what the scalar code in WebCore computes, which the vector kernels have
+// to match exactly.
+class tst_Filters : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void init();
+    void cleanup();
+
+private Q_SLOTS:
+    void colorMatrix();
+    void compositeArithmetic();
+    void gaussianBlur();
+    void morphology();
+    void colorMatrixNoise();
+    void compositeArithmeticNoise();
+    void gaussianBlurNoise();
+    void morphologyNoise();
+    void paint_data();
+    void paint();
+    void cssFilterInvalidation();
+    void cssFilterFullRepaint();
+    void paintCSSFilter_data();
+    void paintCSSFilter();
+
+private:
+    void load(const QString& primitives, const QString& source = QString());
+    void loadCSSFilter(const QString& filter);
+    QImage render(const QColor& background = Qt::white);
+    QImage filterNoise(const QString& primitives);
+
+    QWebPage* m_page;
+};
+
+void tst_Filters::init()
+{
+    m_page = new QWebPage;
+    m_page->setViewportSize(QSize(400, 400));
+}
+
+void tst_Filters::cleanup()
+{
+    delete m_page;
+}
+
+// Filters a 200x200 flood of rgb(200, 100, 50) at (100, 100) by default.
+void tst_Filters::load(const QString& primitives, const QString& source)
+{
+    m_page->mainFrame()->setHtml(QString::fromLatin1(
+        "<body style='margin: 0'>"
+        "<svg xmlns='http://www.w3.org/2000/svg' width='400' height='400'>"
+        "<filter id='filter' filterUnits='userSpaceOnUse' x='100' y='100' width='200' height='200' color-interpolation-filters='sRGB'>"
+        "%1"
+        "</filter>"
+        "%2"
+        "</svg></body>").arg(primitives, source.isEmpty() ? QLatin1String("<rect x='100' y='100' width='200' height='200' fill='rgb(200, 100, 50)' filter='url(#filter)'/>") : source));
+    ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+}
+
+// A blurred box whose contents do not change between paints.
+void tst_Filters::loadCSSFilter(const QString& filter)
+{
+    m_page->mainFrame()->setHtml(QString::fromLatin1(
+        "<body style='margin: 0'>"
+        "<div id='box' style='position: absolute; left: 100px; top: 100px; width: 200px; height: 200px; background-color: rgb(200, 100, 50); -webkit-filter: %1'>"
+        "<p>Some text</p>"
+        "</div></body>").arg(filter));
+    ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+}
+
+QImage tst_Filters::render(const QColor& background)
+{
+    QImage image(m_page->viewportSize(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(background);
+    QPainter painter(&image);
+    m_page->mainFrame()->render(&painter);
+    painter.end();
+    return image;
+}
+
+void tst_Filters::colorMatrix()
+{
+    // 0.213 * 200 + 0.715 * 100 + 0.072 * 50 = 117.7
+    load(QLatin1String("<feColorMatrix type='saturate' values='0'/>"));
+    QCOMPARE(render().pixel(200, 200), qRgb(118, 118, 118));
+
+    load(QLatin1String("<feColorMatrix type='matrix' values='0 1 0 0 0  0 0 1 0 0  1 0 0 0 0  0 0 0 1 0'/>"));
+    QCOMPARE(render().pixel(200, 200), qRgb(100, 50, 200));
+}
+
+void tst_Filters::compositeArithmetic()
+{
+    // 0.5 * rgb(200, 100, 50) + 0.5 * rgb(100, 50, 250)
+    load(QLatin1String(
+        "<feFlood flood-color='rgb(100, 50, 250)' result='flood'/>"
+        "<feComposite in='SourceGraphic' in2='flood' operator='arithmetic' k2='0.5' k3='0.5'/>"));
+    QCOMPARE(render().pixel(200, 200), qRgb(150, 75, 150));
+}
+
+void tst_Filters::gaussianBlur()
+{
+    // Far enough from the edges, a flat color stays the same.
+    load(QLatin1String("<feGaussianBlur stdDeviation='4'/>"));
+    QImage image = render();
+    QCOMPARE(image.pixel(200, 200), qRgb(200, 100, 50));
+    QVERIFY(qRed(image.pixel(101, 200)) > 200);
+}
+
+void tst_Filters::morphology()
+{
+    load(QLatin1String("<feMorphology operator='erode' radius='10'/>"),
+        QLatin1String("<rect x='150' y='150' width='100' height='100' fill='rgb(200, 100, 50)' filter='url(#filter)'/>"));
+    QImage image = render();
+    QCOMPARE(image.pixel(155, 200), qRgb(255, 255, 255));
+    QCOMPARE(image.pixel(200, 200), qRgb(200, 100, 50));
+
+    load(QLatin1String("<feMorphology operator='dilate' radius='10'/>"),
+        QLatin1String("<rect x='150' y='150' width='100' height='100' fill='rgb(200, 100, 50)' filter='url(#filter)'/>"));
+    image = render();
+    QCOMPARE(image.pixel(145, 200), qRgb(200, 100, 50));
+    QCOMPARE(image.pixel(130, 200), qRgb(255, 255, 255));
+}
+
+static const QRect noiseRect(100, 100, 100, 100);
+
+// Opaque random pixels, so that the kernels see every channel value rather
+// than one flat color.
+static QImage noiseImage()
+{
+    QImage image(noiseRect.size(), QImage::Format_ARGB32_Premultiplied);
+    qsrand(1);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = qRgb(qrand() & 0xff, qrand() & 0xff, qrand() & 0xff);
+    }
+    return image;
+}
+
+// The premultiplied RGBA channels of |image|, in the order the filters see them.
+static QVector<int> channels(const QImage& image)
+{
+    QVector<int> channels;
+    channels.reserve(image.width() * image.height() * 4);
+    for (int y = 0; y < image.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            channels << qRed(line[x]) << qGreen(line[x]) << qBlue(line[x]) << qAlpha(line[x]);
+    }
+    return channels;
+}
+
+static QImage imageFromChannels(const QVector<int>& channels, const QSize& size)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < size.height(); ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < size.width(); ++x) {
+            const int* pixel = channels.constData() + (y * size.width() + x) * 4;
+            line[x] = qRgba(pixel[0], pixel[1], pixel[2], pixel[3]);
+        }
+    }
+    return image;
+}
+
+// Like Uint8ClampedArray::set().
+static int clampAndRound(float value)
+{
+    if (!(value > 0))
+        return 0;
+    if (value > 255)
+        return 255;
+    return lrint(value);
+}
+
+// The scalar feColorMatrix type='matrix'.
+static QVector<int> colorMatrix(const QVector<int>& source, const float* values)
+{
+    QVector<int> result(source.size());
+    for (int i = 0; i < source.size(); i += 4) {
+        float red = source[i];
+        float green = source[i + 1];
+        float blue = source[i + 2];
+        float alpha = source[i + 3];
+        for (int row = 0; row < 4; ++row) {
+            const float* v = values + row * 5;
+            result[i + row] = clampAndRound(v[0] * red + v[1] * green + v[2] * blue + v[3] * alpha + v[4] * 255);
+        }
+    }
+    return result;
+}
+
+// The scalar feComposite operator='arithmetic', with clamping.
+static QVector<int> compositeArithmetic(const QVector<int>& in, const QVector<int>& in2, float k1, float k2, float k3, float k4)
+{
+    float scaledK1 = k1 / 255.0f;
+    float scaledK4 = k4 * 255.0f;
+    QVector<int> result(in.size());
+    for (int i = 0; i < in.size(); ++i) {
+        float i1 = in[i];
+        float i2 = in2[i];
+        float value = k2 * i1 + k3 * i2;
+        value += scaledK1 * i1 * i2;
+        value += scaledK4;
+        result[i] = value <= 0 ? 0 : (value >= 255 ? 255 : static_cast<int>(value));
+    }
+    return result;
+}
+
+// One box blur pass of the scalar feGaussianBlur.
+static void boxBlur(const QVector<int>& source, QVector<int>& destination, unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int effectHeight)
+{
+    for (int y = 0; y < effectHeight; ++y) {
+        int line = y * strideLine;
+        for (int channel = 0; channel < 4; ++channel) {
+            int sum = 0;
+            for (int i = 0; i < qMin(dxRight, effectWidth); ++i)
+                sum += source[line + i * stride + channel];
+            for (int x = 0; x < effectWidth; ++x) {
+                int offset = line + x * stride + channel;
+                destination[offset] = sum / dx;
+                if (x >= dxLeft)
+                    sum -= source[offset - dxLeft * stride];
+                if (x + dxRight < effectWidth)
+                    sum += source[offset + dxRight * stride];
+            }
+        }
+    }
+}
+
+// The scalar feGaussianBlur: three box blurs in each direction, whose kernels
+// are placed like FEGaussianBlur::kernelPosition() does.
+static QVector<int> gaussianBlur(const QVector<int>& source, const QSize& size, float stdDeviation)
+{
+    unsigned kernelSize = qMax(2u, static_cast<unsigned>(floorf(stdDeviation * (3 / 4.f * sqrtf(2 * static_cast<float>(M_PI))) + 0.5f)));
+    QVector<int> result = source;
+    QVector<int> temporary(source.size());
+    int left = 0;
+    int right = 0;
+    for (int pass = 0; pass < 3; ++pass) {
+        bool even = !(kernelSize % 2);
+        if (!pass) {
+            left = even ? kernelSize / 2 - 1 : kernelSize / 2;
+            right = kernelSize - left;
+        } else if (pass == 1 && even) {
+            ++left;
+            --right;
+        } else if (pass == 2 && even) {
+            ++right;
+            ++kernelSize;
+        }
+        boxBlur(result, temporary, kernelSize, left, right, 4, 4 * size.width(), size.width(), size.height());
+        boxBlur(temporary, result, kernelSize, left, right, 4 * size.width(), 4, size.height(), size.width());
+    }
+    return result;
+}
+
+// Follows the scalar FEMorphology::platformApplyGeneric() step by step.
+static QVector<int> morphology(const QVector<int>& source, const QSize& size, int radius, bool erode)
+{
+    const int width = size.width();
+    const int height = size.height();
+    QVector<int> result(source.size());
+    QVector<int> extrema;
+    for (int y = 0; y < height; ++y) {
+        int startY = qMax(0, y - radius);
+        int endY = qMin(height - 1, y + radius);
+        for (int channel = 0; channel < 4; ++channel) {
+            extrema.clear();
+            for (int x = 0; x <= radius; ++x) {
+                int columnExtrema = source[(startY * width + x) * 4 + channel];
+                for (int i = startY + 1; i < endY; ++i) {
+                    int pixel = source[(i * width + x) * 4 + channel];
+                    columnExtrema = erode ? qMin(columnExtrema, pixel) : qMax(columnExtrema, pixel);
+                }
+                extrema << columnExtrema;
+            }
+            for (int x = 0; x < width; ++x) {
+                int endX = qMin(x + radius, width - 1);
+                int columnExtrema = source[(startY * width + endX) * 4 + channel];
+                for (int i = startY + 1; i <= endY; ++i) {
+                    int pixel = source[(i * width + endX) * 4 + channel];
+                    columnExtrema = erode ? qMin(columnExtrema, pixel) : qMax(columnExtrema, pixel);
+                }
+                if (x - radius >= 0)
+                    extrema.remove(0);
+                if (x + radius <= width)
+                    extrema << columnExtrema;
+                int entireExtrema = extrema[0];
+                for (int i = 1; i < extrema.size(); ++i)
+                    entireExtrema = erode ? qMin(entireExtrema, extrema[i]) : qMax(entireExtrema, extrema[i]);
+                result[(y * width + x) * 4 + channel] = entireExtrema;
+            }
+        }
+    }
+    return result;
+}
+
+// Filters noiseImage() at noiseRect, which the filter region matches, and
+// returns that part of the page painted over transparent pixels. The region
+// is small enough for every primitive to run on a single thread.
+QImage tst_Filters::filterNoise(const QString& primitives)
+{
+    QPalette palette = m_page->palette();
+    palette.setBrush(QPalette::Base, Qt::transparent);
+    m_page->setPalette(palette);
+
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    noiseImage().save(&buffer, "PNG");
+
+    m_page->mainFrame()->setHtml(QString::fromLatin1(
+        "<body style='margin: 0'>"
+        "<svg xmlns='http://www.w3.org/2000/svg' xmlns:xlink='http://www.w3.org/1999/xlink' width='400' height='400'>"
+        "<filter id='filter' filterUnits='userSpaceOnUse' x='100' y='100' width='100' height='100' color-interpolation-filters='sRGB'>"
+        "%1"
+        "</filter>"
+        "<image x='100' y='100' width='100' height='100' xlink:href='data:image/png;base64,%2' %3/>"
+        "</svg></body>").arg(primitives, QString::fromLatin1(png.toBase64()),
+            primitives.isEmpty() ? QString() : QString::fromLatin1("filter='url(#filter)'")));
+    ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+    return render(Qt::transparent).copy(noiseRect);
+}
+
+void tst_Filters::colorMatrixNoise()
+{
+    QImage source = filterNoise(QString());
+    QCOMPARE(source, noiseImage());
+
+    // Values that parse to the same floats, with results both in and out of range.
+    const float values[20] = {
+        0.5f, 0.75f, -0.25f, 0, 0.125f,
+        -0.5f, 1.25f, 0.375f, 0, -0.0625f,
+        0.25f, 0.25f, 0.5f, 0, 0,
+        0, 0, 0, 1, 0
+    };
+    QImage filtered = filterNoise(QLatin1String(
+        "<feColorMatrix type='matrix' values='"
+        "0.5 0.75 -0.25 0 0.125  -0.5 1.25 0.375 0 -0.0625  0.25 0.25 0.5 0 0  0 0 0 1 0'/>"));
+    QCOMPARE(filtered, imageFromChannels(colorMatrix(channels(source), values), source.size()));
+}
+
+void tst_Filters::compositeArithmeticNoise()
+{
+    QImage source = filterNoise(QString());
+    QCOMPARE(source, noiseImage());
+
+    // The second input has the channels of the first one rotated.
+    const float rotation[20] = {
+        0, 1, 0, 0, 0,
+        0, 0, 1, 0, 0,
+        1, 0, 0, 0, 0,
+        0, 0, 0, 1, 0
+    };
+    QVector<int> in = channels(source);
+    QVector<int> in2 = colorMatrix(in, rotation);
+    QImage filtered = filterNoise(QLatin1String(
+        "<feColorMatrix type='matrix' values='0 1 0 0 0  0 0 1 0 0  1 0 0 0 0  0 0 0 1 0' result='rotated'/>"
+        "<feComposite in='SourceGraphic' in2='rotated' operator='arithmetic' k1='0.5' k2='0.75' k3='-0.25' k4='0.125'/>"));
+    QCOMPARE(filtered, imageFromChannels(compositeArithmetic(in, in2, 0.5f, 0.75f, -0.25f, 0.125f), source.size()));
+}
+
+void tst_Filters::gaussianBlurNoise()
+{
+    QImage source = filterNoise(QString());
+    QCOMPARE(source, noiseImage());
+
+    // Odd and even kernel sizes are placed differently.
+    QImage filtered = filterNoise(QLatin1String("<feGaussianBlur stdDeviation='2'/>"));
+    QCOMPARE(filtered, imageFromChannels(gaussianBlur(channels(source), source.size(), 2), source.size()));
+
+    filtered = filterNoise(QLatin1String("<feGaussianBlur stdDeviation='2.5'/>"));
+    QCOMPARE(filtered, imageFromChannels(gaussianBlur(channels(source), source.size(), 2.5f), source.size()));
+}
+
+void tst_Filters::morphologyNoise()
+{
+    QImage source = filterNoise(QString());
+    QCOMPARE(source, noiseImage());
+
+    QImage filtered = filterNoise(QLatin1String("<feMorphology operator='erode' radius='3'/>"));
+    QCOMPARE(filtered, imageFromChannels(morphology(channels(source), source.size(), 3, true), source.size()));
+
+    filtered = filterNoise(QLatin1String("<feMorphology operator='dilate' radius='5'/>"));
+    QCOMPARE(filtered, imageFromChannels(morphology(channels(source), source.size(), 5, false), source.size()));
+}
+
+void tst_Filters::paint_data()
+{
+    QTest::addColumn<QString>("primitives");
+    QTest::newRow("feGaussianBlur") << QString::fromLatin1("<feGaussianBlur stdDeviation='8'/>");
+    QTest::newRow("feColorMatrix") << QString::fromLatin1("<feColorMatrix type='hueRotate' values='90'/>");
+    QTest::newRow("feComposite") << QString::fromLatin1(
+        "<feFlood flood-color='rgb(100, 50, 250)' flood-opacity='0.5' result='flood'/>"
+        "<feComposite in='SourceGraphic' in2='flood' operator='arithmetic' k1='0.2' k2='0.5' k3='0.5' k4='0.1'/>");
+    QTest::newRow("feMorphology") << QString::fromLatin1("<feMorphology operator='dilate' radius='6'/>");
+}
+
+void tst_Filters::paint()
+{
+    QFETCH(QString, primitives);
+    load(primitives,
+        QLatin1String("<g filter='url(#filter)'>"
+            "<rect x='100' y='100' width='200' height='200' fill='rgb(200, 100, 50)'/>"
+            "<circle cx='200' cy='200' r='80' fill='rgba(0, 128, 255, 0.6)'/>"
+            "</g>"));
+
+    QBENCHMARK {
+        render();
+    }
+}
+
+void tst_Filters::cssFilterInvalidation()
+{
+    // The result kept from the first paint must not outlive a change of the contents.
+    loadCSSFilter(QLatin1String("blur(4px)"));
+    QImage first = render();
+    QCOMPARE(render(), first);
+    QCOMPARE(first.pixel(200, 250), qRgb(200, 100, 50));
+
+    m_page->mainFrame()->evaluateJavaScript(QLatin1String("document.getElementById('box').style.backgroundColor = 'rgb(50, 100, 200)'; void(0);"));
+    QCOMPARE(render().pixel(200, 250), qRgb(50, 100, 200));
+}
+
+void tst_Filters::cssFilterFullRepaint()
+{
+    m_page->mainFrame()->setHtml(QString::fromLatin1(
+        "<body style='margin: 0'>"
+        "<div style='position: absolute; left: 100px; top: 100px; width: 200px; height: 200px; background-color: rgb(200, 100, 50); -webkit-filter: blur(4px)'>"
+        "<div id='inner' style='width: 50px; height: 200px; background-color: rgb(50, 100, 200)'></div>"
+        "</div></body>"));
+    ::waitForSignal(m_page, SIGNAL(loadFinished(bool)), 0);
+    QCOMPARE(render().pixel(200, 200), qRgb(200, 100, 50));
+
+    // Resizing the view makes the next layout repaint everything at once
+    // instead of repainting the renderers that moved, like the inner box.
+    m_page->mainFrame()->evaluateJavaScript(QLatin1String("document.getElementById('inner').style.width = '150px'; void(0);"));
+    m_page->setViewportSize(QSize(400, 401));
+    QCOMPARE(render().pixel(200, 200), qRgb(50, 100, 200));
+}
+
+void tst_Filters::paintCSSFilter_data()
+{
+    QTest::addColumn<QString>("filter");
+    QTest::newRow("blur") << QString::fromLatin1("blur(8px)");
+    QTest::newRow("drop-shadow") << QString::fromLatin1("drop-shadow(8px 8px 8px black)");
+}
+
+void tst_Filters::paintCSSFilter()
+{
+    QFETCH(QString, filter);
+    loadCSSFilter(filter);
+
+    QBENCHMARK {
+        render();
+    }
+}
+
+QTEST_MAIN(tst_Filters)
+#include "tst_filters.moc"
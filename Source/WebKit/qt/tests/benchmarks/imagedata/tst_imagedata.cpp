@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <qwebframe.h>
+#include <qwebpage.h>
+
+#include "util.h"
+
+// Reads back and writes the whole of a canvas, as image editors do every frame.
+class tst_ImageData : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void init();
+    void cleanup();
+
+private Q_SLOTS:
+    void getImageData_data();
+    void getImageData();
+    void putImageData_data();
+    void putImageData();
+
+private:
+    void setUpCanvas(const QSize&);
+
+    QWebPage* m_page;
+};
+
+void tst_ImageData::init()
+{
+    m_page = new QWebPage;
+}
+
+void tst_ImageData::cleanup()
+{
+    delete m_page;
+}
+
+void tst_ImageData::setUpCanvas(const QSize& size)
+{
+    // A translucent gradient, so that every pixel needs to be converted.
+    m_page->mainFrame()->setHtml(QString::fromLatin1(
+        "<canvas id='canvas' width='%1' height='%2'></canvas>"
+        "<script>"
+        "var canvas = document.getElementById('canvas');"
+        "var context = canvas.getContext('2d');"
+        "var gradient = context.createLinearGradient(0, 0, canvas.width, canvas.height);"
+        "gradient.addColorStop(0, 'rgba(255, 0, 0, 0.2)');"
+        "gradient.addColorStop(1, 'rgba(0, 0, 255, 0.9)');"
+        "context.fillStyle = gradient;"
+        "context.fillRect(0, 0, canvas.width, canvas.height);"
+        "var imageData = context.getImageData(0, 0, canvas.width, canvas.height);"
+        "</script>").arg(size.width()).arg(size.height()));
+}
+
+static void addCanvasSizes()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::newRow("300x150") << QSize(300, 150);
+    QTest::newRow("640x480") << QSize(640, 480);
+    QTest::newRow("1024x768") << QSize(1024, 768);
+    QTest::newRow("1920x1080") << QSize(1920, 1080);
+}
+
+void tst_ImageData::getImageData_data()
+{
+    addCanvasSizes();
+}
+
+void tst_ImageData::getImageData()
+{
+    QFETCH(QSize, size);
+    setUpCanvas(size);
+
+    QWebFrame* frame = m_page->mainFrame();
+    QBENCHMARK {
+        frame->evaluateJavaScript(QLatin1String("context.getImageData(0, 0, canvas.width, canvas.height); void(0);"));
+    }
+}
+
+void tst_ImageData::putImageData_data()
+{
+    addCanvasSizes();
+}
+
+void tst_ImageData::putImageData()
+{
+    QFETCH(QSize, size);
+    setUpCanvas(size);
+
+    QWebFrame* frame = m_page->mainFrame();
+    QBENCHMARK {
+        frame->evaluateJavaScript(QLatin1String("context.putImageData(imageData, 0, 0); void(0);"));
+    }
+}
+
+QTEST_MAIN(tst_ImageData)
+#include "tst_imagedata.moc"
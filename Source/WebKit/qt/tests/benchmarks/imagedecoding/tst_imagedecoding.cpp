@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <qimagewriter.h>
+#include <qwebframe.h>
+#include <qwebpage.h>
+#include <qwebsettings.h>
+
+#include "util.h"
+
+// Decodes every image of a corpus through WebCore. The corpus is read from the
+// directory named by QTWEBKIT_IMAGE_CORPUS, or generated if it is not set.
+class tst_ImageDecoding : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+private Q_SLOTS:
+    void decode_data();
+    void decode();
+
+private:
+    void generateCorpus();
+
+    QDir m_corpusDir;
+    bool m_generatedCorpus;
+    QWebPage* m_page;
+};
+
+void tst_ImageDecoding::initTestCase()
+{
+    m_generatedCorpus = qgetenv("QTWEBKIT_IMAGE_CORPUS").isEmpty();
+    if (m_generatedCorpus)
+        generateCorpus();
+    else
+        m_corpusDir = QDir(QString::fromLocal8Bit(qgetenv("QTWEBKIT_IMAGE_CORPUS")));
+}
+
+void tst_ImageDecoding::cleanupTestCase()
+{
+    if (!m_generatedCorpus)
+        return;
+
+    foreach (const QString& fileName, m_corpusDir.entryList(QDir::Files))
+        m_corpusDir.remove(fileName);
+    QDir::temp().rmdir(m_corpusDir.dirName());
+}
+
+void tst_ImageDecoding::init()
+{
+    m_page = new QWebPage;
+}
+
+void tst_ImageDecoding::cleanup()
+{
+    delete m_page;
+}
+
+void tst_ImageDecoding::generateCorpus()
+{
+    QDir::temp().mkdir(QLatin1String("tst_imagedecoding"));
+    m_corpusDir = QDir(QDir::temp().filePath(QLatin1String("tst_imagedecoding")));
+
+    const QSize sizes[] = { QSize(256, 256), QSize(1024, 768), QSize(2560, 1920) };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        // A noisy gradient, so that the encoders cannot collapse the image.
+        QImage image(sizes[i], QImage::Format_ARGB32);
+        qsrand(i);
+        for (int y = 0; y < image.height(); ++y) {
+            QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x)
+                line[x] = qRgba((x * 255 / image.width()) ^ (qrand() & 0x1f), (y * 255 / image.height()) ^ (qrand() & 0x1f), qrand() & 0xff, 0xff);
+        }
+
+        QString baseName = QString::fromLatin1("%1x%2").arg(sizes[i].width()).arg(sizes[i].height());
+        QImageWriter(m_corpusDir.filePath(baseName + QLatin1String(".png")), "png").write(image);
+
+        QImageWriter baselineJpeg(m_corpusDir.filePath(baseName + QLatin1String(".jpg")), "jpeg");
+        baselineJpeg.setQuality(85);
+        baselineJpeg.write(image);
+
+        QImageWriter progressiveJpeg(m_corpusDir.filePath(baseName + QLatin1String("-progressive.jpg")), "jpeg");
+        progressiveJpeg.setQuality(85);
+        progressiveJpeg.setProgressiveScanWrite(true);
+        progressiveJpeg.write(image);
+    }
+}
+
+void tst_ImageDecoding::decode_data()
+{
+    QTest::addColumn<QUrl>("url");
+
+    QStringList filters;
+    filters << QLatin1String("*.png") << QLatin1String("*.jpg") << QLatin1String("*.jpeg") << QLatin1String("*.gif") << QLatin1String("*.webp");
+    foreach (const QString& fileName, m_corpusDir.entryList(filters, QDir::Files, QDir::Name))
+        QTest::newRow(fileName.toLatin1().constData()) << QUrl::fromLocalFile(m_corpusDir.filePath(fileName));
+}
+
+void tst_ImageDecoding::decode()
+{
+    QFETCH(QUrl, url);
+
+    // Drawing the image into a canvas decodes it synchronously, on this thread.
+    QString html = QString::fromLatin1(
+        "<canvas id='canvas'></canvas>"
+        "<script>"
+        "var image = new Image();"
+        "image.onload = function() {"
+        "    var canvas = document.getElementById('canvas');"
+        "    canvas.width = image.width;"
+        "    canvas.height = image.height;"
+        "    canvas.getContext('2d').drawImage(image, 0, 0);"
+        "    document.title = 'decoded';"
+        "};"
+        "image.onerror = function() { document.title = 'failed'; };"
+        "image.src = '%1';"
+        "</script>").arg(url.toString());
+
+    QBENCHMARK {
+        // Otherwise the memory cache hands back the already decoded image.
+        QWebSettings::clearMemoryCaches();
+
+        m_page->mainFrame()->setHtml(html, url);
+        QTRY_VERIFY(!m_page->mainFrame()->title().isEmpty());
+        QCOMPARE(m_page->mainFrame()->title(), QString::fromLatin1("decoded"));
+    }
+}
+
+QTEST_MAIN(tst_ImageDecoding)
+#include "tst_imagedecoding.moc"
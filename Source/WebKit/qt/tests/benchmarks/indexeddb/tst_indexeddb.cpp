@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <qwebframe.h>
+#include <qwebpage.h>
+#include <qwebsettings.h>
+
+#include "util.h"
+
+// Lets the page report that an asynchronous IndexedDB operation has finished.
+class Completion : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void done() { emit finished(); }
+
+Q_SIGNALS:
+    void finished();
+};
+
+// Writes and reads back records the way offline web applications synchronize
+// their data: many puts in a single transaction, then walks over an index and
+// over the whole object store.
+class tst_IndexedDB : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+private Q_SLOTS:
+    void bulkInsert_data();
+    void bulkInsert();
+    void indexScan_data();
+    void indexScan();
+    void cursorIteration_data();
+    void cursorIteration();
+
+private:
+    void run(const QString& script);
+
+    QTemporaryDir m_storageDirectory;
+    QWebPage* m_page;
+    Completion* m_completion;
+};
+
+void tst_IndexedDB::initTestCase()
+{
+    QVERIFY(m_storageDirectory.isValid());
+    QWebSettings::globalSettings()->setOfflineStoragePath(m_storageDirectory.path());
+    QWebSettings::globalSettings()->setAttribute(QWebSettings::OfflineStorageDatabaseEnabled, true);
+}
+
+void tst_IndexedDB::init()
+{
+    m_page = new QWebPage;
+    m_completion = new Completion;
+
+    // IndexedDB is not available to pages with a unique origin, so the page
+    // pretends to come from a host.
+    m_page->mainFrame()->setHtml(QString::fromLatin1(
+        "<script>"
+        "var db;"
+        "var payload = new Array(64).join('offline data ');"
+        "function open() {"
+        "    var request = indexedDB.open('benchmark', 1);"
+        "    request.onupgradeneeded = function() {"
+        "        var store = request.result.createObjectStore('records', { keyPath: 'id' });"
+        "        store.createIndex('name', 'name');"
+        "    };"
+        "    request.onsuccess = function() { db = request.result; completion.done(); };"
+        "}"
+        "function insert(count) {"
+        "    var transaction = db.transaction('records', 'readwrite');"
+        "    var store = transaction.objectStore('records');"
+        "    store.clear();"
+        "    for (var i = 0; i < count; ++i)"
+        "        store.put({ id: i, name: 'record ' + (i * 7919 % count), payload: payload });"
+        "    transaction.oncomplete = function() { completion.done(); };"
+        "}"
+        "function iterate(source) {"
+        "    var request = source.openCursor();"
+        "    request.onsuccess = function() {"
+        "        if (request.result)"
+        "            request.result.continue();"
+        "        else"
+        "            completion.done();"
+        "    };"
+        "}"
+        "function scanIndex() { iterate(db.transaction('records').objectStore('records').index('name')); }"
+        "function iterateStore() { iterate(db.transaction('records').objectStore('records')); }"
+        "</script>"), QUrl("http://localhost/"));
+    m_page->mainFrame()->addToJavaScriptWindowObject("completion", m_completion);
+
+    run("open()");
+}
+
+void tst_IndexedDB::cleanup()
+{
+    delete m_page;
+    delete m_completion;
+}
+
+void tst_IndexedDB::run(const QString& script)
+{
+    m_page->mainFrame()->evaluateJavaScript(script);
+    QVERIFY(::waitForSignal(m_completion, SIGNAL(finished()), 60000));
+}
+
+static void addRecordCounts()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+void tst_IndexedDB::bulkInsert_data()
+{
+    addRecordCounts();
+}
+
+void tst_IndexedDB::bulkInsert()
+{
+    QFETCH(int, count);
+
+    QBENCHMARK {
+        run(QString::fromLatin1("insert(%1)").arg(count));
+    }
+}
+
+void tst_IndexedDB::indexScan_data()
+{
+    addRecordCounts();
+}
+
+void tst_IndexedDB::indexScan()
+{
+    QFETCH(int, count);
+    run(QString::fromLatin1("insert(%1)").arg(count));
+
+    QBENCHMARK {
+        run("scanIndex()");
+    }
+}
+
+void tst_IndexedDB::cursorIteration_data()
+{
+    addRecordCounts();
+}
+
+void tst_IndexedDB::cursorIteration()
+{
+    QFETCH(int, count);
+    run(QString::fromLatin1("insert(%1)").arg(count));
+
+    QBENCHMARK {
+        run("iterateStore()");
+    }
+}
+
+QTEST_MAIN(tst_IndexedDB)
+#include "tst_indexeddb.moc"
@@ -44,6 +44,8 @@ private Q_SLOTS:
     void paint_data();
     void paint();
     void textAreas();
+    void staticSVG();
+    void staticSVGRepaint();
 
 private:
 #ifndef QT_NO_BEARERMANAGEMENT
@@ -123,5 +125,61 @@ void tst_Painting::textAreas()
     }
 }
 
+void tst_Painting::staticSVG()
+{
+    QString markup("<html><body><svg xmlns='http://www.w3.org/2000/svg' width='1000' height='700'>"
+        "<defs><linearGradient id='gradient'><stop offset='0' stop-color='gold'/><stop offset='1' stop-color='teal'/></linearGradient></defs><g>");
+    for (int i = 0; i < 500; ++i) {
+        markup += QString("<path fill='url(#gradient)' stroke='black' d='M%1 %2 q 40 -60 80 0 t 80 0 l -40 60 z'/>")
+            .arg((i * 37) % 900).arg((i * 53) % 640);
+    }
+    markup += "</g></svg></body></html>";
+
+    m_view->setHtml(markup);
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    /* force a layout */
+    QWebFrame* mainFrame = m_page->mainFrame();
+    mainFrame->toPlainText();
+
+    // The content does not change between paints, so after the first couple
+    // of them the group is drawn from a bitmap.
+    QPixmap pixmap(m_page->viewportSize());
+    QBENCHMARK {
+        QPainter painter(&pixmap);
+        mainFrame->render(&painter, QRect(QPoint(0, 0), m_page->viewportSize()));
+        painter.end();
+    }
+}
+
+void tst_Painting::staticSVGRepaint()
+{
+    m_view->setHtml("<html><body style='margin: 0'><svg xmlns='http://www.w3.org/2000/svg' width='400' height='100'><g>"
+        "<rect id='first' x='0' y='0' width='100' height='100' fill='rgb(200, 100, 50)'/>"
+        "<rect x='100' y='0' width='100' height='100' fill='rgb(200, 100, 50)'/>"
+        "<rect x='200' y='0' width='100' height='100' fill='rgb(200, 100, 50)'/>"
+        "<rect x='300' y='0' width='100' height='100' fill='rgb(200, 100, 50)'/>"
+        "</g></svg></body></html>");
+    ::waitForSignal(m_view, SIGNAL(loadFinished(bool)), 0);
+
+    QWebFrame* mainFrame = m_page->mainFrame();
+    QImage image(m_page->viewportSize(), QImage::Format_ARGB32_Premultiplied);
+
+    // The second paint creates the bitmap of the group, the third one draws it.
+    for (int i = 0; i < 3; ++i) {
+        QPainter painter(&image);
+        mainFrame->render(&painter, QRect(QPoint(0, 0), m_page->viewportSize()));
+        painter.end();
+        QCOMPARE(image.pixel(50, 50), qRgb(200, 100, 50));
+    }
+
+    mainFrame->evaluateJavaScript("document.getElementById('first').setAttribute('fill', 'rgb(50, 100, 200)'); void(0);");
+    QPainter painter(&image);
+    mainFrame->render(&painter, QRect(QPoint(0, 0), m_page->viewportSize()));
+    painter.end();
+    QCOMPARE(image.pixel(50, 50), qRgb(50, 100, 200));
+    QCOMPARE(image.pixel(150, 50), qRgb(200, 100, 50));
+}
+
 QTEST_MAIN(tst_Painting)
 #include "tst_painting.moc"
@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2013 Digia Plc. and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <QAbstractNetworkCache>
+#include <QNetworkAccessManager>
+#include <qwebpage.h>
+#include <qwebsettings.h>
+
+// Exercises the disk cache QWebSettings::enablePersistentStorage() sets up for
+// the network access managers QWebPage creates.
+class tst_NetworkDiskCache : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+private Q_SLOTS:
+    void insertAndRead();
+    void writerThread();
+    void updateMetaData();
+    void remove();
+    void metaDataComesFromIndex();
+    void usingAnEntrySavesTheIndex();
+    void evictLeastRecentlyUsed();
+    void evictWhenShrinking();
+    void clear();
+
+private:
+    static QUrl entryURL(int);
+    static QNetworkCacheMetaData metaDataFor(const QUrl&);
+    QString entriesPath() const;
+    QString indexPath() const;
+    int entryFileCount() const;
+    QByteArray entryFileContents() const;
+    void insertEntry(const QUrl&, const QByteArray& body);
+    QByteArray readEntry(const QUrl&);
+
+    QTemporaryDir m_storageDirectory;
+    QWebPage* m_page;
+    QAbstractNetworkCache* m_cache;
+};
+
+void tst_NetworkDiskCache::initTestCase()
+{
+    QVERIFY(m_storageDirectory.isValid());
+    QWebSettings::enablePersistentStorage(m_storageDirectory.path());
+
+    m_page = new QWebPage;
+    m_cache = m_page->networkAccessManager()->cache();
+    QVERIFY(m_cache);
+}
+
+void tst_NetworkDiskCache::cleanupTestCase()
+{
+    delete m_page;
+}
+
+void tst_NetworkDiskCache::init()
+{
+    m_cache->setProperty("maximumCacheSize", 50 * 1024 * 1024);
+    m_cache->clear();
+    QCOMPARE(m_cache->cacheSize(), qint64(0));
+    QTRY_COMPARE(entryFileCount(), 0);
+}
+
+QUrl tst_NetworkDiskCache::entryURL(int index)
+{
+    // The URLs have the same length, so their entries have the same size.
+    return QUrl(QString::fromLatin1("http://www.example.com/entry-%1").arg(index, 2, 10, QLatin1Char('0')));
+}
+
+QNetworkCacheMetaData tst_NetworkDiskCache::metaDataFor(const QUrl& url)
+{
+    QNetworkCacheMetaData metaData;
+    metaData.setUrl(url);
+    metaData.setSaveToDisk(true);
+    QNetworkCacheMetaData::RawHeaderList headers;
+    headers.append(qMakePair(QByteArray("Content-Type"), QByteArray("text/plain")));
+    headers.append(qMakePair(QByteArray("Cache-Control"), QByteArray("max-age=3600")));
+    metaData.setRawHeaders(headers);
+    return metaData;
+}
+
+QString tst_NetworkDiskCache::entriesPath() const
+{
+    return m_storageDirectory.path() + QLatin1String("/NetworkCache/entries");
+}
+
+QString tst_NetworkDiskCache::indexPath() const
+{
+    return m_storageDirectory.path() + QLatin1String("/NetworkCache/index");
+}
+
+int tst_NetworkDiskCache::entryFileCount() const
+{
+    return QDir(entriesPath()).entryList(QDir::Files).count();
+}
+
+QByteArray tst_NetworkDiskCache::entryFileContents() const
+{
+    QDir entries(entriesPath());
+    QStringList fileNames = entries.entryList(QDir::Files);
+    if (fileNames.count() != 1)
+        return QByteArray();
+    QFile file(entries.absoluteFilePath(fileNames.first()));
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+void tst_NetworkDiskCache::insertEntry(const QUrl& url, const QByteArray& body)
+{
+    QIODevice* device = m_cache->prepare(metaDataFor(url));
+    QVERIFY(device);
+    QCOMPARE(device->write(body), qint64(body.size()));
+    m_cache->insert(device);
+}
+
+QByteArray tst_NetworkDiskCache::readEntry(const QUrl& url)
+{
+    QIODevice* device = m_cache->data(url);
+    if (!device)
+        return QByteArray();
+    QByteArray body = device->readAll();
+    delete device;
+    return body;
+}
+
+void tst_NetworkDiskCache::insertAndRead()
+{
+    QByteArray body("Hello, cache.");
+    insertEntry(entryURL(0), body);
+
+    QNetworkCacheMetaData metaData = m_cache->metaData(entryURL(0));
+    QVERIFY(metaData.isValid());
+    QCOMPARE(metaData.url(), entryURL(0));
+    QVERIFY(metaData.rawHeaders().contains(qMakePair(QByteArray("Content-Type"), QByteArray("text/plain"))));
+    // The freshness lifetime of the response becomes the expiration date.
+    QVERIFY(metaData.expirationDate() > QDateTime::currentDateTime());
+
+    // Until the writer thread has written it, the entry is served from memory.
+    QCOMPARE(readEntry(entryURL(0)), body);
+    QVERIFY(m_cache->cacheSize() > body.size());
+
+    QVERIFY(!m_cache->metaData(entryURL(1)).isValid());
+    QVERIFY(!m_cache->data(entryURL(1)));
+}
+
+void tst_NetworkDiskCache::writerThread()
+{
+    QByteArray smallBody("A small body.");
+    QByteArray largeBody(256 * 1024, 'x');
+    insertEntry(entryURL(0), smallBody);
+    insertEntry(entryURL(1), largeBody);
+
+    QTRY_COMPARE(entryFileCount(), 2);
+    QTRY_VERIFY(QFile::exists(indexPath()));
+
+    // Once written, bodies are read back from the entry files.
+    QTest::qWait(1500);
+    QCOMPARE(readEntry(entryURL(0)), smallBody);
+    QCOMPARE(readEntry(entryURL(1)), largeBody);
+}
+
+void tst_NetworkDiskCache::updateMetaData()
+{
+    QByteArray body("Revalidated body.");
+    insertEntry(entryURL(0), body);
+    QTRY_COMPARE(entryFileCount(), 1);
+    QTest::qWait(1500);
+
+    QNetworkCacheMetaData metaData = metaDataFor(entryURL(0));
+    QNetworkCacheMetaData::RawHeaderList headers = metaData.rawHeaders();
+    headers.append(qMakePair(QByteArray("X-Revalidated"), QByteArray("yes")));
+    metaData.setRawHeaders(headers);
+    m_cache->updateMetaData(metaData);
+
+    // The new headers are visible at once, while the header in the file is rewritten in the background.
+    QVERIFY(m_cache->metaData(entryURL(0)).rawHeaders().contains(qMakePair(QByteArray("X-Revalidated"), QByteArray("yes"))));
+    QCOMPARE(readEntry(entryURL(0)), body);
+
+    QTRY_VERIFY(entryFileContents().contains("X-Revalidated"));
+    QCOMPARE(readEntry(entryURL(0)), body);
+}
+
+void tst_NetworkDiskCache::remove()
+{
+    insertEntry(entryURL(0), "First");
+    insertEntry(entryURL(1), "Second");
+    QTRY_COMPARE(entryFileCount(), 2);
+
+    QVERIFY(m_cache->remove(entryURL(0)));
+    QVERIFY(!m_cache->remove(entryURL(0)));
+    QVERIFY(!m_cache->metaData(entryURL(0)).isValid());
+    QVERIFY(!m_cache->data(entryURL(0)));
+    QTRY_COMPARE(entryFileCount(), 1);
+
+    QCOMPARE(readEntry(entryURL(1)), QByteArray("Second"));
+}
+
+void tst_NetworkDiskCache::metaDataComesFromIndex()
+{
+    insertEntry(entryURL(0), "Indexed");
+    QTRY_COMPARE(entryFileCount(), 1);
+    QTest::qWait(1500);
+
+    // Looking up the headers doesn't open the entry file.
+    QDir entries(entriesPath());
+    QVERIFY(entries.remove(entries.entryList(QDir::Files).first()));
+    QVERIFY(m_cache->metaData(entryURL(0)).isValid());
+
+    // Reading the body does, and drops the entry when the file is gone.
+    QVERIFY(!m_cache->data(entryURL(0)));
+    QVERIFY(!m_cache->metaData(entryURL(0)).isValid());
+    QCOMPARE(m_cache->cacheSize(), qint64(0));
+}
+
+void tst_NetworkDiskCache::usingAnEntrySavesTheIndex()
+{
+    insertEntry(entryURL(0), "First");
+    insertEntry(entryURL(1), "Second");
+    QTRY_COMPARE(entryFileCount(), 2);
+    QTRY_VERIFY(QFile::exists(indexPath()));
+    QTest::qWait(1500);
+
+    // The order in which entries were used is kept across restarts.
+    QVERIFY(QFile::remove(indexPath()));
+    QCOMPARE(readEntry(entryURL(0)), QByteArray("First"));
+    QTRY_VERIFY(QFile::exists(indexPath()));
+}
+
+void tst_NetworkDiskCache::evictLeastRecentlyUsed()
+{
+    const int entryCount = 10;
+    for (int i = 0; i < entryCount; ++i)
+        insertEntry(entryURL(i), QByteArray(100, 'a' + i));
+    m_cache->setProperty("maximumCacheSize", m_cache->cacheSize());
+    for (int i = 0; i < entryCount; ++i)
+        QVERIFY(m_cache->metaData(entryURL(i)).isValid());
+
+    // Using the oldest entry makes the second oldest the least recently used one.
+    QCOMPARE(readEntry(entryURL(0)), QByteArray(100, 'a'));
+    insertEntry(entryURL(entryCount), QByteArray(100, 'z'));
+
+    QVERIFY(m_cache->cacheSize() <= m_cache->property("maximumCacheSize").toLongLong());
+    QVERIFY(m_cache->metaData(entryURL(0)).isValid());
+    QVERIFY(!m_cache->metaData(entryURL(1)).isValid());
+    QVERIFY(!m_cache->data(entryURL(1)));
+    for (int i = 2; i <= entryCount; ++i)
+        QVERIFY(m_cache->metaData(entryURL(i)).isValid());
+
+    QTRY_COMPARE(entryFileCount(), entryCount);
+}
+
+void tst_NetworkDiskCache::evictWhenShrinking()
+{
+    for (int i = 0; i < 4; ++i)
+        insertEntry(entryURL(i), QByteArray(100, 'a' + i));
+    QCOMPARE(readEntry(entryURL(1)), QByteArray(100, 'b'));
+
+    // The entry that was used last is kept even if it is over the budget on its own.
+    m_cache->setProperty("maximumCacheSize", 0);
+    QVERIFY(m_cache->cacheSize() > 0);
+    QVERIFY(m_cache->metaData(entryURL(1)).isValid());
+    QVERIFY(!m_cache->metaData(entryURL(0)).isValid());
+    QVERIFY(!m_cache->metaData(entryURL(2)).isValid());
+    QVERIFY(!m_cache->metaData(entryURL(3)).isValid());
+    QTRY_COMPARE(entryFileCount(), 1);
+}
+
+void tst_NetworkDiskCache::clear()
+{
+    for (int i = 0; i < 4; ++i)
+        insertEntry(entryURL(i), QByteArray(100, 'a' + i));
+    QTRY_COMPARE(entryFileCount(), 4);
+
+    // Entries that are still being written are dropped too.
+    insertEntry(entryURL(4), QByteArray(100, 'e'));
+    m_cache->clear();
+
+    QCOMPARE(m_cache->cacheSize(), qint64(0));
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(!m_cache->metaData(entryURL(i)).isValid());
+        QVERIFY(!m_cache->data(entryURL(i)));
+    }
+    QTRY_COMPARE(entryFileCount(), 0);
+
+    // The cache keeps working after it was cleared.
+    insertEntry(entryURL(0), "After clear");
+    QCOMPARE(readEntry(entryURL(0)), QByteArray("After clear"));
+    QTRY_COMPARE(entryFileCount(), 1);
+}
+
+QTEST_MAIN(tst_NetworkDiskCache)
+
+#include "tst_networkdiskcache.moc"
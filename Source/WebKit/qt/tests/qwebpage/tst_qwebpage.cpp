@@ -195,6 +195,9 @@ private Q_SLOTS:
     void openWindowDefaultSize();
     void cssMediaTypeGlobalSetting();
     void cssMediaTypePageSetting();
+    void paintLargeImageRightAfterLoad_data();
+    void paintLargeImageRightAfterLoad();
+    void jpegColorConversionMatchesLibjpeg();
 
 #ifdef Q_OS_MAC
     void macCopyUnicodeToClipboard();
@@ -3520,5 +3523,78 @@ void tst_QWebPage::cssMediaTypePageSetting()
     QVERIFY(m_view->page()->settings()->cssMediaType() == "screen"); 
 }
 
+void tst_QWebPage::paintLargeImageRightAfterLoad_data()
+{
+    QTest::addColumn<QByteArray>("format");
+    QTest::addColumn<int>("tolerance");
+
+    QTest::newRow("png") << QByteArray("png") << 0;
+    QTest::newRow("jpeg") << QByteArray("jpeg") << 8;
+    // Only the Qt image plugins read PPM, so this one must be decoded on the main thread.
+    QTest::newRow("ppm") << QByteArray("ppm") << 0;
+}
+
+void tst_QWebPage::paintLargeImageRightAfterLoad()
+{
+    QFETCH(QByteArray, format);
+    QFETCH(int, tolerance);
+
+    // Big enough for WebCore to decode it on a background thread where the format allows that.
+    const QRgb color = qRgb(0, 128, 255);
+    QImage image(1024, 1024, QImage::Format_RGB32);
+    image.fill(color);
+    QDir().mkpath(tmpDirPath());
+    QString fileName = tmpDirPath() + QLatin1String("/large.") + QString::fromLatin1(format);
+    QVERIFY(QImageWriter(fileName, format).write(image));
+
+    QWebPage page;
+    page.setViewportSize(QSize(200, 200));
+    QSignalSpy loadSpy(&page, SIGNAL(loadFinished(bool)));
+    page.mainFrame()->setHtml(QString::fromLatin1("<body style='margin: 0'><img src='%1' width='200' height='200'></body>")
+        .arg(QUrl::fromLocalFile(fileName).toString()), QUrl::fromLocalFile(tmpDirPath() + QLatin1Char('/')));
+    QTRY_COMPARE(loadSpy.count(), 1);
+
+    // Paint straight away: a decode still running on another thread must not leave the image blank.
+    QImage rendered(page.viewportSize(), QImage::Format_RGB32);
+    rendered.fill(Qt::white);
+    QPainter painter(&rendered);
+    page.mainFrame()->render(&painter);
+    painter.end();
+
+    QRgb pixel = rendered.pixel(100, 100);
+    QVERIFY(qAbs(qRed(pixel) - qRed(color)) <= tolerance);
+    QVERIFY(qAbs(qGreen(pixel) - qGreen(color)) <= tolerance);
+    QVERIFY(qAbs(qBlue(pixel) - qBlue(color)) <= tolerance);
+}
+
+void tst_QWebPage::jpegColorConversionMatchesLibjpeg()
+{
+    // gradient.ppm is libjpeg's own RGB output for gradient.jpg (4:4:4, islow
+    // DCT). The image is noisy and its width is not a multiple of 8, so both the
+    // vectorized and the per pixel color conversion are covered.
+    QImage expected(QLatin1String(":/resources/gradient.ppm"));
+    QVERIFY(!expected.isNull());
+
+    QWebPage page;
+    page.setViewportSize(expected.size());
+    QSignalSpy loadSpy(&page, SIGNAL(loadFinished(bool)));
+    page.mainFrame()->setHtml(QLatin1String("<body style='margin: 0'><img src='qrc:///resources/gradient.jpg'></body>"), QUrl(QLatin1String("qrc:///")));
+    QTRY_COMPARE(loadSpy.count(), 1);
+
+    QImage rendered(page.viewportSize(), QImage::Format_RGB32);
+    rendered.fill(Qt::white);
+    QPainter painter(&rendered);
+    page.mainFrame()->render(&painter);
+    painter.end();
+
+    for (int y = 0; y < expected.height(); ++y) {
+        for (int x = 0; x < expected.width(); ++x) {
+            if (rendered.pixel(x, y) != expected.pixel(x, y))
+                QFAIL(qPrintable(QString::fromLatin1("Pixel (%1, %2) is #%3, libjpeg decodes #%4")
+                    .arg(x).arg(y).arg(rendered.pixel(x, y) & 0xFFFFFF, 6, 16, QLatin1Char('0')).arg(expected.pixel(x, y) & 0xFFFFFF, 6, 16, QLatin1Char('0'))));
+        }
+    }
+}
+
 QTEST_MAIN(tst_QWebPage)
 #include "tst_qwebpage.moc"
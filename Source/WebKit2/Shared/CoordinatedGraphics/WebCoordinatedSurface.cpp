@@ -195,6 +195,16 @@ void WebCoordinatedSurface::paintToSurface(const IntRect& rect, CoordinatedSurfa
     client->paintToSurfaceContext(context.get());
 }
 
+bool WebCoordinatedSurface::canPaintOnAnyThread() const
+{
+    // A graphics surface is painted through the GL context of the main thread.
+#if USE(GRAPHICS_SURFACE)
+    if (isBackedByGraphicsSurface())
+        return false;
+#endif
+    return true;
+}
+
 #if USE(TEXTURE_MAPPER)
 void WebCoordinatedSurface::copyToTexture(PassRefPtr<WebCore::BitmapTexture> passTexture, const IntRect& target, const IntPoint& sourceOffset)
 {
@@ -72,6 +72,7 @@ public:
     virtual ~WebCoordinatedSurface();
 
     virtual void paintToSurface(const WebCore::IntRect&, WebCore::CoordinatedSurface::Client*) OVERRIDE;
+    virtual bool canPaintOnAnyThread() const OVERRIDE;
 
 #if USE(TEXTURE_MAPPER)
     virtual void copyToTexture(PassRefPtr<WebCore::BitmapTexture>, const WebCore::IntRect& target, const WebCore::IntPoint& sourceOffset) OVERRIDE;
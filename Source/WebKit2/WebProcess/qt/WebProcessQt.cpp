@@ -36,10 +36,10 @@
 #include <QCoreApplication>
 #include <QNetworkAccessManager>
 #include <QNetworkCookieJar>
-#include <QNetworkDiskCache>
 #include <WebCore/CookieJarQt.h>
 #include <WebCore/FileSystem.h>
 #include <WebCore/MemoryCache.h>
+#include <WebCore/NetworkDiskCacheQt.h>
 #include <WebCore/PageCache.h>
 #include <WebCore/RuntimeEnabledFeatures.h>
 #include <wtf/RAMSize.h>
@@ -65,7 +65,7 @@ void WebProcess::platformSetCacheModel(CacheModel cacheModel)
     // The Mac port of WebKit2 uses a fudge factor of 1000 here to account for misalignment, however,
     // that tends to overestimate the memory quite a bit (1 byte misalignment ~ 48 MiB misestimation).
     // We use 1024 * 1023 for now to keep the estimation error down to +/- ~1 MiB.
-    QNetworkDiskCache* diskCache = qobject_cast<QNetworkDiskCache*>(m_networkAccessManager->cache());
+    NetworkDiskCacheQt* diskCache = qobject_cast<NetworkDiskCacheQt*>(m_networkAccessManager->cache());
     uint64_t freeVolumeSpace = !diskCache ? 0 : WebCore::getVolumeFreeSizeForPath(diskCache->cacheDirectory().toLocal8Bit().constData()) / 1024 / 1023;
 
     // The following variables are initialised to 0 because WebProcess::calculateCacheSizes might not
@@ -89,12 +89,15 @@ void WebProcess::platformSetCacheModel(CacheModel cacheModel)
     memoryCache()->setDeadDecodedDataDeletionInterval(deadDecodedDataDeletionInterval);
 
     pageCache()->setCapacity(pageCacheCapacity);
-
-    // FIXME: Implement hybrid in-memory- and disk-caching as e.g. the Mac port does.
 }
 
-void WebProcess::platformClearResourceCaches(ResourceCachesToClear)
+void WebProcess::platformClearResourceCaches(ResourceCachesToClear cachesToClear)
 {
+    if (cachesToClear == InMemoryResourceCachesOnly)
+        return;
+
+    if (NetworkDiskCacheQt* diskCache = qobject_cast<NetworkDiskCacheQt*>(m_networkAccessManager->cache()))
+        diskCache->clear();
 }
 
 #if defined(Q_OS_MACX)
@@ -123,8 +126,7 @@ void WebProcess::platformInitializeWebProcess(const WebProcessCreationParameters
     }
 
     if (!parameters.diskCacheDirectory.isEmpty()) {
-        QNetworkDiskCache* diskCache = new QNetworkDiskCache();
-        diskCache->setCacheDirectory(parameters.diskCacheDirectory);
+        NetworkDiskCacheQt* diskCache = new NetworkDiskCacheQt(parameters.diskCacheDirectory);
         // The m_networkAccessManager takes ownership of the diskCache object upon the following call.
         m_networkAccessManager->setCache(diskCache);
     }
@@ -21,7 +21,8 @@ SUBDIRS += \
     $$WEBKIT_TESTS_DIR/qwebhistory \
     $$WEBKIT_TESTS_DIR/qwebinspector \
     $$WEBKIT_TESTS_DIR/qwebsecurityorigin \
-    $$WEBKIT_TESTS_DIR/hybridPixmap
+    $$WEBKIT_TESTS_DIR/hybridPixmap \
+    $$WEBKIT_TESTS_DIR/networkdiskcache
 
 linux-* {
     # This test bypasses the library and links the tested code's object itself.
@@ -32,7 +33,11 @@ linux-* {
 # Benchmarks
 SUBDIRS += \
     $$WEBKIT_TESTS_DIR/benchmarks/painting \
-    $$WEBKIT_TESTS_DIR/benchmarks/loading
+    $$WEBKIT_TESTS_DIR/benchmarks/loading \
+    $$WEBKIT_TESTS_DIR/benchmarks/imagedecoding \
+    $$WEBKIT_TESTS_DIR/benchmarks/imagedata \
+    $$WEBKIT_TESTS_DIR/benchmarks/filters \
+    $$WEBKIT_TESTS_DIR/benchmarks/indexeddb
 
 # WebGL performance tests are disabled temporarily.
 # https://bugs.webkit.org/show_bug.cgi?id=80503
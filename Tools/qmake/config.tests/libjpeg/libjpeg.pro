@@ -0,0 +1,5 @@
+SOURCES = libjpeg.cpp
+OBJECTS_DIR = obj
+LIBS += -ljpeg
+
+load(qt_build_config)
@@ -0,0 +1,5 @@
+SOURCES = libpng.cpp
+OBJECTS_DIR = obj
+LIBS += -lpng
+
+load(qt_build_config)
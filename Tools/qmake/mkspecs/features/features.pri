@@ -18,7 +18,7 @@ FEATURE_DEFAULTS = \
     ENABLE_BATTERY_STATUS=0 \
     ENABLE_BLOB=1 \
     ENABLE_CANVAS_PATH=1 \
-    ENABLE_CANVAS_PROXY=0 \
+    ENABLE_CANVAS_PROXY=1 \
     ENABLE_CHANNEL_MESSAGING=1 \
     ENABLE_CSP_NEXT=0 \
     ENABLE_CSS_BOX_DECORATION_BREAK=1 \